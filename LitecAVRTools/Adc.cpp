@@ -0,0 +1,443 @@
+/*
+    Adc.cpp - Interrupt-driven sampling of analog inputs with the
+    Analog-to-Digital-Converter, auto-triggered by a Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "Adc.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "IsrProfiler.h"
+
+
+// The interrupt-service-routine is measured by the IsrProfiler-module, if ISR_PROFILER_ADC_SLOT is defined as the
+// number of a profiler-slot.
+#if ISR_PROFILER_ENABLED && defined(ISR_PROFILER_ADC_SLOT)
+#define ADC_PROFILE_ENTER()         PROFILE_ISR_ENTER( ISR_PROFILER_ADC_SLOT )
+#define ADC_PROFILE_EXIT()          PROFILE_ISR_EXIT( ISR_PROFILER_ADC_SLOT )
+#else
+#define ADC_PROFILE_ENTER()
+#define ADC_PROFILE_EXIT()
+#endif
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    const uint8_t kBufferMask = ADC_BUFFER_SIZE - 1;
+
+    // The ADPSn-bits in ADCSRA: log2 of the prescaler
+    const uint8_t kPrescalerBits = ADC_PRESCALER == 2 ? 1 : ADC_PRESCALER == 4 ? 2 : ADC_PRESCALER == 8 ? 3
+                                   : ADC_PRESCALER == 16 ? 4 : ADC_PRESCALER == 32 ? 5 : ADC_PRESCALER == 64 ? 6 : 7;
+
+    // The ADCSRA-value without a running sequence: ADC enabled, a pending interrupt-flag cleared (write 1 to clear)
+    const uint8_t kAdcsraStopped = _BV(ADEN) | _BV(ADIF) | kPrescalerBits;
+
+    uint8_t                     adc_reference;
+    uint8_t                     adc_count;
+
+    // The register-values for each position in the sequence, calculated in advance, so the
+    // interrupt-service-routine only writes them. adc_adcsrb contains the MUX5-bit (ATmega2560) and the trigger.
+    uint8_t                     adc_admux[ ADC_SEQUENCE_MAX ];
+    uint8_t                     adc_adcsrb[ ADC_SEQUENCE_MAX ];
+
+    // The ring-buffers have one writer (the interrupt-service-routine, it only changes adc_head) and one reader
+    // (adcRead(), it only changes adc_tail). The indexes are single bytes, so no locking is needed.
+    volatile uint16_t           adc_buffer[ ADC_SEQUENCE_MAX ][ ADC_BUFFER_SIZE ];
+    volatile uint8_t            adc_head[ ADC_SEQUENCE_MAX ];
+    volatile uint8_t            adc_tail[ ADC_SEQUENCE_MAX ];
+    volatile uint8_t            adc_overruns;
+
+    // The position in the sequence of the running conversion. Only used by the interrupt-service-routine (and by
+    // adcStart()).
+    uint8_t                     adc_index;
+
+    // The interrupt-flag of the trigger-event. adc_flag_mask is 0, if the flag is cleared by the
+    // interrupt-service-routine of the event, or in free-running mode.
+    volatile uint8_t*           adc_flag_register;
+    uint8_t                     adc_flag_mask;
+
+
+    // Returns the 6-bit MUX-value (MUX5 in bit 5) for a channel, or 0xFF for an invalid channel
+    uint8_t muxValue( uint8_t channel )
+    {
+#if defined(MUX5)
+        if ( channel < 16 )
+        {
+            // ADC8 .. ADC15 are 0x20 .. 0x27
+            return ( channel & 0x07 ) | ( ( channel & 0x08 ) << 2 );
+        }
+        return ( channel < 64 ) ? channel : 0xFF;
+#else
+        return ( channel <= ADC_CHANNEL_TEMPERATURE || channel == ADC_CHANNEL_BANDGAP
+                 || channel == ADC_CHANNEL_GND ) ? channel : 0xFF;
+#endif
+    }
+
+
+    inline void selectMux( uint8_t mux )
+    {
+        ADMUX = adc_reference | ( mux & 0x1F );
+#if defined(MUX5)
+        ADCSRB = ( ADCSRB & ~_BV(MUX5) ) | ( ( mux & 0x20 ) ? _BV(MUX5) : 0 );
+#endif
+    }
+
+
+    inline uint8_t isRunning()
+    {
+        return ADCSRA & _BV(ADATE);
+    }
+
+
+    inline void countOverrun() __attribute__((always_inline));
+    inline void countOverrun()
+    {
+        uint8_t overruns = adc_overruns;
+        if ( overruns != 0xFF )
+        {
+            adc_overruns = overruns + 1;
+        }
+    }
+
+
+    // Clears the interrupt-flag of the trigger-event (write 1 to clear). ACI is in ACSR together with the settings
+    // of the analog comparator, so it is cleared with read-modify-write, the other flags are written directly, so
+    // other flags in the same register are not cleared.
+    inline void clearTriggerFlag() __attribute__((always_inline));
+    inline void clearTriggerFlag()
+    {
+        if ( adc_flag_mask != 0 )
+        {
+            if ( adc_flag_register == &ACSR )
+            {
+                *adc_flag_register |= adc_flag_mask;
+            }
+            else
+            {
+                *adc_flag_register = adc_flag_mask;
+            }
+        }
+    }
+};
+
+
+
+ISR( ADC_vect )
+{
+    ADC_PROFILE_ENTER();
+
+    uint8_t index = adc_index;
+    uint16_t value = ADC;
+
+    uint8_t head = adc_head[ index ];
+    uint8_t next = ( head + 1 ) & kBufferMask;
+
+    if ( next == adc_tail[ index ] )
+    {
+        // Ring-buffer full: the newest result is dropped
+        countOverrun();
+    }
+    else
+    {
+        adc_buffer[ index ][ head ] = value;
+        adc_head[ index ] = next;
+    }
+
+    uint8_t nextIndex = index + 1;
+    if ( nextIndex == adc_count )
+    {
+        nextIndex = 0;
+    }
+    adc_index = nextIndex;
+
+    // No conversion is running now, so the channel can be changed. (In free-running mode the next conversion has
+    // already started, but there is only one channel.)
+    ADMUX = adc_admux[ nextIndex ];
+#if defined(MUX5)
+    ADCSRB = adc_adcsrb[ nextIndex ];
+#endif
+
+    if ( index == 0 )
+    {
+        // The trigger-event of this sequence. The ADC starts the next sequence at the next rising edge of the flag.
+        clearTriggerFlag();
+    }
+
+    if ( nextIndex != 0 )
+    {
+        // The next channel of the sequence
+        ADCSRA |= _BV(ADSC);
+    }
+    else if ( index != 0 && ( *adc_flag_register & adc_flag_mask ) )
+    {
+        // A trigger-event during the sequence was ignored by the ADC
+        countOverrun();
+        clearTriggerFlag();
+    }
+
+    ADC_PROFILE_EXIT();
+}
+
+
+
+
+void adcInit( AdcReference reference )
+{
+#if defined(PRR0)
+    PRR0 &= ~_BV(PRADC);
+#elif defined(PRR)
+    PRR &= ~_BV(PRADC);
+#endif
+
+    ADCSRA = kAdcsraStopped;
+
+    adc_reference = reference;
+    ADMUX = reference;
+
+    for ( uint8_t i = 0; i < adc_count; i++ )
+    {
+        adc_admux[ i ] = reference | ( adc_admux[ i ] & 0x1F );
+    }
+}
+
+
+
+
+int8_t adcSetSequence( const uint8_t* channels, uint8_t count )
+{
+    if ( isRunning() || count == 0 || count > ADC_SEQUENCE_MAX )
+    {
+        return -1;
+    }
+
+    for ( uint8_t i = 0; i < count; i++ )
+    {
+        if ( muxValue( channels[ i ] ) == 0xFF )
+        {
+            return -1;
+        }
+    }
+
+    for ( uint8_t i = 0; i < count; i++ )
+    {
+        uint8_t channel = channels[ i ];
+        uint8_t mux = muxValue( channel );
+
+        adc_admux[ i ] = adc_reference | ( mux & 0x1F );
+#if defined(MUX5)
+        adc_adcsrb[ i ] = ( mux & 0x20 ) ? _BV(MUX5) : 0;
+#endif
+
+        // The digital input-buffer of an analog pin draws current at voltages between the logic-levels
+#if defined(DIDR2)
+        if ( channel < 8 )
+        {
+            DIDR0 |= _BV( channel );
+        }
+        else if ( channel < 16 )
+        {
+            DIDR2 |= _BV( channel - 8 );
+        }
+#else
+        if ( channel < 6 )
+        {
+            DIDR0 |= _BV( channel );
+        }
+#endif
+    }
+
+    adc_count = count;
+    return 0;
+}
+
+
+
+
+int8_t adcStart( AdcTrigger trigger )
+{
+    if ( adc_count == 0 || ( trigger == ADC_TRIGGER_FREE_RUNNING && adc_count > 1 ) )
+    {
+        return -1;
+    }
+
+    adcStop();
+
+    // The flag of the trigger-event is only cleared here, if its interrupt is disabled
+    adc_flag_register = &ADCSRA;
+    adc_flag_mask = 0;
+
+    switch ( trigger )
+    {
+        case ADC_TRIGGER_ANALOG_COMPARATOR:
+            adc_flag_register = &ACSR;
+            adc_flag_mask = ( ACSR & _BV(ACIE) ) ? 0 : _BV(ACI);
+            break;
+
+        case ADC_TRIGGER_EXT_INT0:
+            adc_flag_register = &EIFR;
+            adc_flag_mask = ( EIMSK & _BV(INT0) ) ? 0 : _BV(INTF0);
+            break;
+
+        case ADC_TRIGGER_TIMER0_COMPA:
+            adc_flag_register = &TIFR0;
+            adc_flag_mask = ( TIMSK0 & _BV(OCIE0A) ) ? 0 : _BV(OCF0A);
+            break;
+
+        case ADC_TRIGGER_TIMER0_OVF:
+            adc_flag_register = &TIFR0;
+            adc_flag_mask = ( TIMSK0 & _BV(TOIE0) ) ? 0 : _BV(TOV0);
+            break;
+
+        case ADC_TRIGGER_TIMER1_COMPB:
+            adc_flag_register = &TIFR1;
+            adc_flag_mask = ( TIMSK1 & _BV(OCIE1B) ) ? 0 : _BV(OCF1B);
+            break;
+
+        case ADC_TRIGGER_TIMER1_OVF:
+            adc_flag_register = &TIFR1;
+            adc_flag_mask = ( TIMSK1 & _BV(TOIE1) ) ? 0 : _BV(TOV1);
+            break;
+
+        case ADC_TRIGGER_TIMER1_CAPT:
+            adc_flag_register = &TIFR1;
+            adc_flag_mask = ( TIMSK1 & _BV(ICIE1) ) ? 0 : _BV(ICF1);
+            break;
+
+        default:
+            break;
+    }
+
+    for ( uint8_t i = 0; i < adc_count; i++ )
+    {
+#if defined(MUX5)
+        adc_adcsrb[ i ] = ( adc_adcsrb[ i ] & _BV(MUX5) ) | trigger;
+#else
+        adc_adcsrb[ i ] = trigger;
+#endif
+        adc_head[ i ] = 0;
+        adc_tail[ i ] = 0;
+    }
+
+    adc_index = 0;
+    ADMUX = adc_admux[ 0 ];
+    ADCSRB = adc_adcsrb[ 0 ];
+
+    // An old event would start the first sequence at once
+    clearTriggerFlag();
+
+    ADCSRA = kAdcsraStopped | _BV(ADIE) | _BV(ADATE)
+             | ( ( trigger == ADC_TRIGGER_FREE_RUNNING ) ? _BV(ADSC) : 0 );
+    return 0;
+}
+
+
+
+
+void adcStop()
+{
+    // A running conversion is finished, but without an interrupt
+    ADCSRA = kAdcsraStopped;
+}
+
+
+
+
+uint8_t adcRead( uint8_t index, uint16_t* value )
+{
+    if ( index >= ADC_SEQUENCE_MAX )
+    {
+        return 0;
+    }
+
+    uint8_t tail = adc_tail[ index ];
+
+    if ( tail == adc_head[ index ] )
+    {
+        return 0;
+    }
+
+    *value = adc_buffer[ index ][ tail ];
+    adc_tail[ index ] = ( tail + 1 ) & kBufferMask;
+    return 1;
+}
+
+
+
+
+uint8_t adcAvailable( uint8_t index )
+{
+    if ( index >= ADC_SEQUENCE_MAX )
+    {
+        return 0;
+    }
+
+    return ( adc_head[ index ] - adc_tail[ index ] ) & kBufferMask;
+}
+
+
+
+
+uint8_t adcGetOverruns()
+{
+    uint8_t overruns;
+
+    // Read and clear without an interrupt-service-routine in between
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        overruns = adc_overruns;
+        adc_overruns = 0;
+    }
+
+    return overruns;
+}
+
+
+
+
+int16_t adcConvert( uint8_t channel )
+{
+    uint8_t mux = muxValue( channel );
+
+    if ( isRunning() || mux == 0xFF )
+    {
+        return -1;
+    }
+
+    // Wait for a conversion, that was running, when the sequence was stopped
+    while ( ADCSRA & _BV(ADSC) )
+    {
+    }
+
+    selectMux( mux );
+    ADCSRA |= _BV(ADSC);
+
+    while ( ADCSRA & _BV(ADSC) )
+    {
+    }
+
+    return ADC;
+}
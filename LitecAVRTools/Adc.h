@@ -0,0 +1,246 @@
+/*
+    Adc.h - Interrupt-driven sampling of analog inputs with the
+    Analog-to-Digital-Converter, auto-triggered by a Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to sample analog inputs with the Analog-to-Digital-Converter (ADC) in the background.
+ *
+ * To use these functions, include Adc.h in your source code and link against Adc.cpp.
+ *
+ * A sequence of up to `ADC_SEQUENCE_MAX` channels is converted after each trigger-event: the ADC starts the first
+ * conversion by itself (auto-trigger, for example at each compare-match B of Timer/Counter1), the
+ * interrupt-service-routine of the ADC stores each result in the ring-buffer of its position in the sequence,
+ * selects the next channel and starts its conversion. The main program takes the results out of the ring-buffers
+ * with `adcRead()`. In free-running mode one channel is converted continuously, with the highest sample-rate.
+ *
+ * \note Linking against Adc.cpp installs the interrupt-service-routine of the ADC.
+ */
+
+
+
+#ifndef Adc_h
+#define Adc_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * The highest number of channels in a sequence (default 8). Each position in the sequence needs
+ * 2 * ADC_BUFFER_SIZE + 4 bytes of RAM.
+ */
+#ifndef ADC_SEQUENCE_MAX
+#define ADC_SEQUENCE_MAX                8
+#endif
+
+#if ADC_SEQUENCE_MAX < 1 || ADC_SEQUENCE_MAX > 16
+    #error "ADC_SEQUENCE_MAX must be between 1 and 16"
+#endif
+
+
+/*!
+ * Number of entries in the ring-buffer of each position in the sequence. Must be a power of two between 2 and 128
+ * (default 8). One entry is always kept free.
+ */
+#ifndef ADC_BUFFER_SIZE
+#define ADC_BUFFER_SIZE                 8
+#endif
+
+#if ADC_BUFFER_SIZE < 2 || ADC_BUFFER_SIZE > 128 || ( ADC_BUFFER_SIZE & ( ADC_BUFFER_SIZE - 1 ) ) != 0
+    #error "ADC_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+
+
+/*!
+ * The highest clock-frequency of the ADC in Hz (default 200000). The smallest prescaler, which gives at most this
+ * frequency, is used (125 kHz at 16 MHz). The ADC has its full resolution of 10 bits up to 200 kHz; higher
+ * frequencies (up to 1 MHz) give higher sample-rates with less resolution.
+ */
+#ifndef ADC_MAX_CLOCK_HZ
+#define ADC_MAX_CLOCK_HZ                200000UL
+#endif
+
+#if F_CPU / 128 > ADC_MAX_CLOCK_HZ
+    #error "ADC_MAX_CLOCK_HZ is too low for this F_CPU"
+#endif
+
+
+/*!
+ * The prescaler of the ADC-clock, calculated from `ADC_MAX_CLOCK_HZ`.
+ */
+#define ADC_PRESCALER   ( F_CPU / 2 <= ADC_MAX_CLOCK_HZ ? 2 : F_CPU / 4 <= ADC_MAX_CLOCK_HZ ? 4                    \
+                          : F_CPU / 8 <= ADC_MAX_CLOCK_HZ ? 8 : F_CPU / 16 <= ADC_MAX_CLOCK_HZ ? 16                 \
+                          : F_CPU / 32 <= ADC_MAX_CLOCK_HZ ? 32 : F_CPU / 64 <= ADC_MAX_CLOCK_HZ ? 64 : 128 )
+
+
+/*!
+ * The highest sample-rate in samples per second: a conversion needs 13 ADC-clock-cycles (13.5, if it is started by
+ * a trigger-event). 9615 samples per second with the default ADC-clock at 16 MHz.
+ */
+#define ADC_MAX_SAMPLE_RATE             ( F_CPU / ADC_PRESCALER / 13 )
+
+
+/*!
+ * Channels for `adcSetSequence()` and `adcConvert()`, besides the pins ADC0 .. ADC7 (and ADC8 .. ADC15 on the
+ * ATmega2560), which are given by their number.
+ */
+#if defined(MUX5)
+#define ADC_CHANNEL_BANDGAP             0x1E    //!< The internal 1.1 V reference
+#define ADC_CHANNEL_GND                 0x1F    //!< 0 V
+#else
+#define ADC_CHANNEL_TEMPERATURE         8       //!< The temperature-sensor (use ADC_REF_INTERNAL_1V1)
+#define ADC_CHANNEL_BANDGAP             14      //!< The internal 1.1 V reference
+#define ADC_CHANNEL_GND                 15      //!< 0 V
+#endif
+
+
+/*!
+ * The reference-voltage of the ADC (the value of the REFSn-bits in ADMUX). The result is
+ * 1024 * input-voltage / reference-voltage.
+ */
+enum AdcReference
+{
+    ADC_REF_AREF =                  0x00,   //!< The voltage on the AREF-pin
+    ADC_REF_AVCC =                  0x40,   //!< AVCC, with a capacitor on the AREF-pin
+#if defined(MUX5)
+    ADC_REF_INTERNAL_1V1 =          0x80,   //!< Internal 1.1 V, with a capacitor on the AREF-pin
+    ADC_REF_INTERNAL_2V56 =         0xC0    //!< Internal 2.56 V, with a capacitor on the AREF-pin
+#else
+    ADC_REF_INTERNAL_1V1 =          0xC0    //!< Internal 1.1 V, with a capacitor on the AREF-pin
+#endif
+};
+
+
+/*!
+ * The event, that starts a sequence (the value of the ADTSn-bits in ADCSRB). The sequence is started at the moment,
+ * when the interrupt-flag of the event is set.
+ *
+ * If the interrupt of the event is enabled, its interrupt-service-routine clears the flag. Otherwise the
+ * interrupt-service-routine of the ADC clears it, because the next sequence is only started, when the flag is set
+ * again.
+ */
+enum AdcTrigger
+{
+    ADC_TRIGGER_FREE_RUNNING =      0,      //!< Free-running mode (only with a single channel)
+    ADC_TRIGGER_ANALOG_COMPARATOR = 1,      //!< The analog comparator (flag ACI)
+    ADC_TRIGGER_EXT_INT0 =          2,      //!< External Interrupt 0 (flag INTF0)
+    ADC_TRIGGER_TIMER0_COMPA =      3,      //!< Compare-match A of Timer/Counter0 (flag OCF0A)
+    ADC_TRIGGER_TIMER0_OVF =        4,      //!< Overflow of Timer/Counter0 (flag TOV0)
+    ADC_TRIGGER_TIMER1_COMPB =      5,      //!< Compare-match B of Timer/Counter1 (flag OCF1B)
+    ADC_TRIGGER_TIMER1_OVF =        6,      //!< Overflow of Timer/Counter1 (flag TOV1)
+    ADC_TRIGGER_TIMER1_CAPT =       7       //!< Input-capture of Timer/Counter1 (flag ICF1)
+};
+
+
+/*!
+ * \brief Enables the ADC with the given reference-voltage and the prescaler `ADC_PRESCALER`, and stops a running
+ * sequence.
+ *
+ * After a change of the reference-voltage, the first results may be wrong (the capacitor on AREF needs time).
+ */
+
+void adcInit( AdcReference reference );
+
+
+/*!
+ * \brief Sets the channels of the sequence. The digital input-buffers of the used pins are disabled (DIDRn).
+ *
+ * The same channel may be used more than once in a sequence. Each position in the sequence has its own ring-buffer.
+ *
+ * \arg \c channels The channels: 0 .. 7 (0 .. 15 on the ATmega2560) for the pins ADCn, or one of the
+ *      `ADC_CHANNEL_...`-macros. On the ATmega2560 values from 16 to 63 are written directly into the MUX-bits
+ *      (MUX5 is bit 5), for example for differential channels.
+ * \arg \c count The number of channels (1 .. ADC_SEQUENCE_MAX).
+ *
+ * \returns 0 on success, or -1 if a sequence is running, or a parameter is out of range.
+ */
+
+int8_t adcSetSequence( const uint8_t* channels, uint8_t count );
+
+
+/*!
+ * \brief Starts the sequence. The ring-buffers are cleared.
+ *
+ * Configure the Timer/Counter of the trigger-event before. Interrupts must be globally enabled.
+ *
+ * \arg \c trigger The event, that starts each sequence. With `ADC_TRIGGER_FREE_RUNNING` the first channel of the
+ *      sequence is converted continuously, starting at once.
+ *
+ * \returns 0 on success, or -1 if there is no sequence, or if the sequence has more than one channel in
+ *      free-running mode.
+ */
+
+int8_t adcStart( AdcTrigger trigger );
+
+
+/*!
+ * \brief Stops the sequence. A running conversion is finished, but its result is not stored.
+ */
+
+void adcStop();
+
+
+/*!
+ * \brief Takes the oldest result of a position in the sequence out of its ring-buffer.
+ *
+ * \arg \c index The position in the sequence (0 .. count-1).
+ * \arg \c value The result (0 .. 1023) is written here.
+ *
+ * \returns 1, if a result was available, otherwise 0.
+ */
+
+uint8_t adcRead( uint8_t index, uint16_t* value );
+
+
+/*!
+ * \brief Returns the number of results in the ring-buffer of a position in the sequence.
+ */
+
+uint8_t adcAvailable( uint8_t index );
+
+
+/*!
+ * \brief Returns and clears the number of overruns (at most 255).
+ *
+ * An overrun is a result, that was dropped, because its ring-buffer was full, or a trigger-event, that came before
+ * the previous sequence was finished (and was ignored by the ADC).
+ */
+
+uint8_t adcGetOverruns();
+
+
+/*!
+ * \brief Converts one channel and waits for the result (about 104 microseconds at 16 MHz).
+ *
+ * \arg \c channel The channel, see `adcSetSequence()`.
+ *
+ * \returns The result (0 .. 1023), or -1 if a sequence is running or the channel is out of range.
+ */
+
+int16_t adcConvert( uint8_t channel );
+
+
+#endif
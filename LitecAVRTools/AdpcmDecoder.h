@@ -0,0 +1,150 @@
+/*
+    AdpcmDecoder.h - Decodes 4-bit IMA-ADPCM audio-data into 8-bit samples,
+    fast enough to run for each sample in an interrupt-service-routine.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to decode audio-data, that was compressed with the IMA-ADPCM-algorithm to 4 bits per
+ * sample, for example by `tools/adpcmEncode.py`.
+ *
+ * To use these functions, include AdpcmDecoder.h in your source code and link against AdpcmDecoder.cpp.
+ *
+ * Compared to 8-bit samples (like in `examples/soundfile.h`) the audio-data needs half the flash-memory. Each byte
+ * contains two samples, the first one in the lower nibble.
+ *
+ * The decoder works on a 16-bit predictor, like the standard IMA-ADPCM-algorithm, but stores it as unsigned value
+ * with an offset of 32768. So the upper byte of the predictor is directly the unsigned 8-bit sample (128 is
+ * silence), and all calculations use 16-bit arithmetic only. The decoder starts with the predictor 32768 and the
+ * step-index 0; `tools/adpcmEncode.py` uses exactly the same algorithm and start-values.
+ *
+ * `adpcmDecodeNibble()` is an inline-function, so it can be used in an interrupt-service-routine without a
+ * function-call. It needs about 60 clock-cycles (estimated from the instruction-sequence, not measured).
+ */
+
+
+
+#ifndef AdpcmDecoder_h
+#define AdpcmDecoder_h
+
+#include <stdint.h>
+
+#include <avr/pgmspace.h>
+
+
+/*!
+ * The state of the decoder. One state is needed for each audio-stream.
+ */
+struct AdpcmDecoder
+{
+    uint16_t predictor;     //!< The last decoded value, 0..65535, 32768 is silence
+    uint8_t stepIndex;      //!< Index into the step-size-table, 0..88
+};
+
+
+/*!
+ * The 89 step-sizes of the IMA-ADPCM-algorithm, in flash-memory (defined in AdpcmDecoder.cpp).
+ */
+extern const uint16_t adpcmStepTable[ 89 ] PROGMEM;
+
+/*!
+ * The change of the step-index for the lower three bits of a code (defined in AdpcmDecoder.cpp).
+ */
+extern const int8_t adpcmIndexTable[ 8 ] PROGMEM;
+
+
+/*!
+ * \brief Sets the decoder to its start-state (predictor 32768, step-index 0).
+ *
+ * Call it before decoding a stream, and again before playing the stream once more.
+ */
+
+inline void adpcmDecoderInit( AdpcmDecoder* decoder )
+{
+    decoder->predictor = 32768;
+    decoder->stepIndex = 0;
+}
+
+
+/*!
+ * \brief Decodes one 4-bit code and returns the unsigned 8-bit sample.
+ *
+ * \arg \c decoder The state of the decoder, updated by this function.
+ * \arg \c code The 4-bit code in the lower nibble (the upper nibble is ignored).
+ *
+ * \returns the decoded sample, 0..255 (128 is silence).
+ */
+
+inline uint8_t adpcmDecodeNibble( AdpcmDecoder* decoder, uint8_t code ) __attribute__((always_inline));
+inline uint8_t adpcmDecodeNibble( AdpcmDecoder* decoder, uint8_t code )
+{
+    uint8_t index = decoder->stepIndex;
+    uint16_t step = pgm_read_word( &adpcmStepTable[ index ] );
+    uint16_t predictor = decoder->predictor;
+
+    // diff = ( code & 7 + 0.5 ) * step / 4, the maximum (61437) fits into 16 bits
+    uint16_t diff = step >> 3;
+    if ( code & 0x04 )
+    {
+        diff += step;
+    }
+    if ( code & 0x02 )
+    {
+        diff += step >> 1;
+    }
+    if ( code & 0x01 )
+    {
+        diff += step >> 2;
+    }
+
+    // The predictor is unsigned with offset 32768, so clamping is a check of the carry
+    if ( code & 0x08 )
+    {
+        predictor = ( predictor < diff ) ? 0 : predictor - diff;
+    }
+    else
+    {
+        predictor += diff;
+        if ( predictor < diff )
+        {
+            predictor = 0xFFFF;
+        }
+    }
+    decoder->predictor = predictor;
+
+    int8_t newIndex = index + static_cast<int8_t>( pgm_read_byte( &adpcmIndexTable[ code & 0x07 ] ) );
+    if ( newIndex < 0 )
+    {
+        newIndex = 0;
+    }
+    else if ( newIndex > 88 )
+    {
+        newIndex = 88;
+    }
+    decoder->stepIndex = newIndex;
+
+    return predictor >> 8;
+}
+
+
+#endif
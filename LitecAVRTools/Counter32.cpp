@@ -0,0 +1,298 @@
+/*
+    Counter32.cpp - A 32-bit-counter for external events or timer-ticks, built
+    from a 16-bit-Timer/Counter and a software-extension.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "Counter32.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == COUNTER32_TIMER
+    #error "The Counter32-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+
+
+
+// The interrupt-vectors of the timer selected with COUNTER32_TIMER, for example TIMER1_OVF_vect
+#define C32_COMPA_vect              litecAvrName3( TIMER, COUNTER32_TIMER, _COMPA_vect )
+#define C32_OVF_vect                litecAvrName3( TIMER, COUNTER32_TIMER, _OVF_vect )
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    // The registers are bound at compile-time. The bits have the same positions in all 16-bit-Timer/Counters,
+    // so the names of Timer/Counter1 are used (like in Timer16Bit.cpp).
+    typedef TimerCounter16< COUNTER32_TIMER >       C32Timer;
+    typedef Timer16Registers< COUNTER32_TIMER >     C32Registers;
+
+    // The target (see counter32SetTarget()). It is reached in overflow-period targetHigh, when the hardware-counter
+    // reaches targetLow. The compare-match-interrupt is only enabled during this overflow-period.
+    enum
+    {
+        kTargetOff,
+        kTargetWaitingForOverflow,
+        kTargetCompareMatchArmed,
+        kTargetReached
+    };
+
+    // Software-extension of the hardware-counter, the upper 16 bits of the counter
+    volatile uint16_t           c32_high;
+
+    volatile uint8_t            c32_target_state;
+    uint16_t                    c32_target_high;
+    uint16_t                    c32_target_low;
+    Counter32Callback           c32_callback;
+
+
+    // Reads the upper and lower 16 bits consistently. Must be called with interrupts disabled.
+    inline void readCounter( uint16_t& high, uint16_t& low ) __attribute__((always_inline));
+    inline void readCounter( uint16_t& high, uint16_t& low )
+    {
+        high = c32_high;
+        low = C32Registers::tcntn();
+
+        // The counter is still counting. If it just had an overflow, and the interrupt-service-routine has not
+        // been executed yet, the overflow-flag is set and the hardware-counter is small.
+        if ( ( C32Registers::tifr() & _BV(TOV1) ) && ( low < 0x8000 ) )
+        {
+            high++;
+        }
+    }
+
+
+    // Enables the compare-match-interrupt for the target. Called with interrupts disabled, in the overflow-period
+    // of the target. `low` is a value of the hardware-counter, that was read in this overflow-period. If the
+    // counter is now smaller, it has wrapped around and left the period of the target. Returns 1, if the
+    // hardware-counter has already passed the target.
+    uint8_t armTarget( uint16_t low )
+    {
+        C32Registers::ocrna() = c32_target_low;
+        C32Registers::tifr() = _BV(OCF1A);      // clear an old compare-match (write 1 to clear)
+
+        uint16_t tcnt = C32Registers::tcntn();
+        if ( tcnt >= c32_target_low || tcnt < low )
+        {
+            c32_target_state = kTargetReached;
+            return 1;
+        }
+
+        c32_target_state = kTargetCompareMatchArmed;
+        C32Registers::timsk() |= _BV(OCIE1A);
+        return 0;
+    }
+};
+
+
+
+ISR( C32_OVF_vect )
+{
+    uint16_t high = c32_high + 1;
+    c32_high = high;
+
+    if ( c32_target_state == kTargetWaitingForOverflow && high == c32_target_high )
+    {
+        // The overflow-period has just started, so every value of the hardware-counter is in it
+        if ( armTarget( 0 ) && c32_callback != NULL )
+        {
+            c32_callback();
+        }
+    }
+}
+
+
+
+
+ISR( C32_COMPA_vect )
+{
+    C32Registers::timsk() &= ~_BV(OCIE1A);
+    c32_target_state = kTargetReached;
+
+    if ( c32_callback != NULL )
+    {
+        c32_callback();
+    }
+}
+
+
+
+
+int8_t counter32Init( Timer16_ClockSource clockSource )
+{
+    if ( clockSource == T16_CLK_OFF )
+    {
+        return -1;
+    }
+
+    C32Timer::disableInterrupts( T16_INT_OVERFLOW | T16_INT_COMP_MATCH_A );
+    C32Timer::selectClockSource( T16_CLK_OFF );
+
+    C32Registers::tccrna() = 0;         // PWM-pins off
+    C32Timer::setMode( T16_NORMAL );
+    C32Timer::setActualCountValue( 0 );
+
+    c32_high = 0;
+    c32_target_state = kTargetOff;
+
+    C32Timer::clearPendingInterruptEvents( T16_INT_OVERFLOW | T16_INT_COMP_MATCH_A );
+    C32Timer::enableInterrupts( T16_INT_OVERFLOW );
+    C32Timer::selectClockSource( clockSource );
+    return 0;
+}
+
+
+
+
+void counter32Stop()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        C32Timer::selectClockSource( T16_CLK_OFF );
+
+        // Count a pending overflow, before its interrupt is disabled
+        uint16_t high;
+        uint16_t low;
+        readCounter( high, low );
+        c32_high = high;
+
+        C32Timer::disableInterrupts( T16_INT_OVERFLOW | T16_INT_COMP_MATCH_A );
+        C32Timer::clearPendingInterruptEvents( T16_INT_OVERFLOW | T16_INT_COMP_MATCH_A );
+        if ( c32_target_state == kTargetCompareMatchArmed )
+        {
+            c32_target_state = kTargetWaitingForOverflow;
+        }
+    }
+}
+
+
+
+
+uint32_t counter32Read()
+{
+    uint16_t high;
+    uint16_t low;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        readCounter( high, low );
+    }
+
+    return ( static_cast<uint32_t>( high ) << 16 ) | low;
+}
+
+
+
+
+uint32_t counter32Extend( uint16_t low )
+{
+    uint16_t high = c32_high;
+
+    // The same check as in readCounter(): if the overflow-flag is set, and the value is small, the overflow
+    // happened before the value was read.
+    if ( ( C32Registers::tifr() & _BV(TOV1) ) && ( low < 0x8000 ) )
+    {
+        high++;
+    }
+
+    return ( static_cast<uint32_t>( high ) << 16 ) | low;
+}
+
+
+
+
+void counter32Write( uint32_t value )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        C32Timer::disableInterrupts( T16_INT_COMP_MATCH_A );
+        c32_target_state = kTargetOff;
+
+        C32Timer::setActualCountValue( static_cast<uint16_t>( value ) );
+        c32_high = static_cast<uint16_t>( value >> 16 );
+        C32Timer::clearPendingInterruptEvents( T16_INT_OVERFLOW );
+    }
+}
+
+
+
+
+uint8_t counter32SetTarget( uint32_t target, Counter32Callback callback )
+{
+    uint8_t reached = 0;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        C32Timer::disableInterrupts( T16_INT_COMP_MATCH_A );
+
+        uint16_t high;
+        uint16_t low;
+        readCounter( high, low );
+        uint32_t now = ( static_cast<uint32_t>( high ) << 16 ) | low;
+
+        c32_callback = callback;
+        c32_target_high = static_cast<uint16_t>( target >> 16 );
+        c32_target_low = static_cast<uint16_t>( target );
+        c32_target_state = kTargetWaitingForOverflow;
+
+        if ( static_cast<int32_t>( now - target ) >= 0 )
+        {
+            c32_target_state = kTargetReached;
+            reached = 1;
+        }
+        else if ( high == c32_target_high )
+        {
+            // The target is in this overflow-period. If an overflow is pending, its interrupt doesn't arm again,
+            // because the state is no longer kTargetWaitingForOverflow.
+            reached = armTarget( low );
+        }
+    }
+
+    return reached;
+}
+
+
+
+
+uint8_t counter32IsTargetReached()
+{
+    return c32_target_state == kTargetReached;
+}
+
+
+
+
+void counter32CancelTarget()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        C32Timer::disableInterrupts( T16_INT_COMP_MATCH_A );
+        c32_target_state = kTargetOff;
+    }
+}
@@ -0,0 +1,170 @@
+/*
+    Counter32.h - A 32-bit-counter for external events or timer-ticks, built
+    from a 16-bit-Timer/Counter and a software-extension.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to count more than 65535 events on the clock-input Tn of a 16-bit-Timer/Counter, for
+ * example the pulses of an energy-meter or of an encoder-wheel, or to use a 16-bit-Timer/Counter as 32-bit-timer.
+ *
+ * To use these functions, include Counter32.h in your source code and link against Counter32.cpp and Timer16Bit.cpp.
+ *
+ * The Timer/Counter `COUNTER32_TIMER` counts the events in hardware, in normal mode. Its overflow-interrupt
+ * increments the upper 16 bits in software, once every 65536 events, so there is no software-work per event. The
+ * counter is read without a race-condition between the hardware-counter and a not yet executed overflow-interrupt,
+ * in the same way as `micros()` of the SystemClock-module does it.
+ *
+ * A 32-bit-target can be set: the compare-match-interrupt A is only enabled in the overflow-period of the target,
+ * and it calls a callback-function, when the counter reaches the target.
+ *
+ * \note Linking against Counter32.cpp installs the overflow- and the compare-match-interrupt A of the
+ * Timer/Counter `COUNTER32_TIMER`. Don't use this Timer/Counter for other purposes.
+ */
+
+
+
+#ifndef Counter32_h
+#define Counter32_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "Timer16Bit.h"
+
+
+/*!
+ * The 16-bit-Timer/Counter used for counting: 1 (default), or 3, 4, 5 on the ATmega2560. External events are
+ * counted on its clock-input: T1 is PD5 on the ATmega328p and PD6 on the ATmega2560, T3 is PE6, T4 is PH7 and T5 is
+ * PL2. The pin must be configured as input (this is the state after reset).
+ */
+#ifndef COUNTER32_TIMER
+#define COUNTER32_TIMER             1
+#endif
+
+#if COUNTER32_TIMER != 1 && COUNTER32_TIMER != 3 && COUNTER32_TIMER != 4 && COUNTER32_TIMER != 5
+    #error "COUNTER32_TIMER must be 1, 3, 4 or 5"
+#endif
+
+
+/*!
+ * A function, that is called, when the counter reaches the target. It is called by the interrupt-service-routine,
+ * so it must be short.
+ */
+typedef void (*Counter32Callback)();
+
+
+/*!
+ * \brief Initializes the Timer/Counter, sets the counter to 0 and starts counting.
+ *
+ * Interrupts must be globally enabled. The overflow-interrupt must be executed within 32768 counts after the
+ * overflow, otherwise `counter32Read()` can't decide, if the overflow is already counted. With the highest
+ * counting-rate (about F_CPU / 2.5 for external events) this are 5 milliseconds at 16 MHz, so don't disable
+ * interrupts for a longer time.
+ *
+ * \arg \c clockSource `T16_FALLING` or `T16_RISING` to count the edges on the pin Tn. With `T16_PRESC_1` ..
+ *      `T16_PRESC_1024` the counter is a 32-bit-timer.
+ *
+ * \returns 0 on success, or -1 if `clockSource` is `T16_CLK_OFF`.
+ */
+
+int8_t counter32Init( Timer16_ClockSource clockSource );
+
+
+/*!
+ * \brief Stops the Timer/Counter and disables its interrupts. The counter keeps its value.
+ */
+
+void counter32Stop();
+
+
+/*!
+ * \brief Returns the actual value of the counter.
+ */
+
+uint32_t counter32Read();
+
+
+/*!
+ * \brief Returns the lower 16 bits of the counter (the hardware-counter). Use this function to capture a timestamp
+ * as early as possible in an interrupt-service-routine, and `counter32Extend()` to get the 32-bit-value.
+ */
+
+inline uint16_t counter32ReadLow()
+{
+    return Timer16Registers< COUNTER32_TIMER >::tcntn();
+}
+
+
+/*!
+ * \brief Extends a value read with `counter32ReadLow()` to 32 bits.
+ *
+ * Call this function with interrupts disabled (for example in an interrupt-service-routine), within 32768 counts
+ * after `counter32ReadLow()`. A not yet executed overflow-interrupt is taken into account, like in
+ * `counter32Read()`.
+ */
+
+uint32_t counter32Extend( uint16_t low );
+
+
+/*!
+ * \brief Sets the counter to the given value. A target set with `counter32SetTarget()` is cancelled.
+ *
+ * Writing the hardware-counter blocks its compare-match for one count, so a target is set afterwards.
+ */
+
+void counter32Write( uint32_t value );
+
+
+/*!
+ * \brief Sets a target: the callback-function is called, when the counter reaches this value.
+ *
+ * The target is reached once, after that the callback isn't called again until a new target is set. A target,
+ * that is less than 2^31 counts behind the counter, is already reached.
+ *
+ * \arg \c target The value of the counter, at which `callback` is called.
+ * \arg \c callback The function, that is called by the compare-match-interrupt, or NULL. Use
+ *      `counter32IsTargetReached()` to poll the target without a callback.
+ *
+ * \returns 1 if the target is already reached (the callback is not called then), 0 otherwise.
+ */
+
+uint8_t counter32SetTarget( uint32_t target, Counter32Callback callback );
+
+
+/*!
+ * \brief Returns non-zero, if the target set with `counter32SetTarget()` has been reached.
+ */
+
+uint8_t counter32IsTargetReached();
+
+
+/*!
+ * \brief Cancels the target set with `counter32SetTarget()`.
+ */
+
+void counter32CancelTarget();
+
+
+#endif
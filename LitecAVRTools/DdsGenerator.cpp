@@ -0,0 +1,302 @@
+/*
+    DdsGenerator.cpp - Generates waveforms (sine, triangle, arbitrary tables)
+    with direct digital synthesis and a hardware-PWM-signal.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "DdsGenerator.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+
+#include "GpioPinMacros.h"
+#include "IsrProfiler.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == DDS_TIMER
+    #error "The DdsGenerator-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+
+
+
+// The interrupt-vector of the timer selected with DDS_TIMER, for example TIMER1_OVF_vect
+#define DDS_OVF_vect                litecAvrName3( TIMER, DDS_TIMER, _OVF_vect )
+
+// The interrupt-service-routine is measured by the IsrProfiler-module, if ISR_PROFILER_DDS_SLOT is defined as the
+// number of a profiler-slot.
+#if ISR_PROFILER_ENABLED && defined(ISR_PROFILER_DDS_SLOT)
+#define DDS_PROFILE_ENTER()         PROFILE_ISR_ENTER( ISR_PROFILER_DDS_SLOT )
+#define DDS_PROFILE_EXIT()          PROFILE_ISR_EXIT( ISR_PROFILER_DDS_SLOT )
+#else
+#define DDS_PROFILE_ENTER()
+#define DDS_PROFILE_EXIT()
+#endif
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    typedef TimerCounter16< DDS_TIMER >     DdsTimer;
+
+    const uint32_t kPeriodTicks = F_CPU / DDS_SAMPLE_RATE;
+    const uint16_t kTop = static_cast<uint16_t>( kPeriodTicks - 1 );
+    const uint16_t kMiddle = static_cast<uint16_t>( kPeriodTicks / 2 );
+
+    // The sum of the voices (at most +-127 * DDS_VOICES) is multiplied with this and divided by 256, so the output
+    // stays between 0 and TOP.
+    const uint32_t kGain = kPeriodTicks / DDS_VOICES;
+
+    // The phase-increment for 1 Hz is 2^32 / DDS_SAMPLE_RATE, as integer part and 16-bit fraction
+    const uint32_t kIncrementPerHz = static_cast<uint32_t>( 4294967296ULL / DDS_SAMPLE_RATE );
+    const uint16_t kIncrementPerHzFraction = static_cast<uint16_t>( ( ( 4294967296ULL % DDS_SAMPLE_RATE ) << 16 )
+                                                                    / DDS_SAMPLE_RATE );
+
+    struct Voice
+    {
+        uint32_t phase;
+        uint32_t increment;
+        const int8_t* table;
+        uint8_t amplitude;
+    };
+
+    // Changed by the interrupt-service-routine (phase) and by the main program (the other members)
+    Voice dds_voices[ DDS_VOICES ];
+};
+
+
+
+ISR( DDS_OVF_vect )
+{
+    DDS_PROFILE_ENTER();
+
+    // The compare-match-register is double-buffered, the value takes effect at the beginning of the next period
+    int16_t sum = 0;
+    Voice* v = dds_voices;
+
+    for ( uint8_t i = 0; i < DDS_VOICES; i++, v++ )
+    {
+        uint32_t phase = v->phase + v->increment;
+        v->phase = phase;
+
+        int8_t sample = static_cast<int8_t>( pgm_read_byte( v->table + static_cast<uint8_t>( phase >> 24 ) ) );
+        sum += static_cast<int16_t>( sample * v->amplitude ) >> 8;
+    }
+
+    DdsTimer::setCompareMatchValue( T16_COMP_A,
+                                    static_cast<uint16_t>( kMiddle + ( static_cast<int32_t>( sum ) * kGain >> 8 ) ) );
+
+    DDS_PROFILE_EXIT();
+}
+
+
+
+
+void ddsInit()
+{
+    DdsTimer::selectClockSource( T16_CLK_OFF );
+
+    for ( uint8_t i = 0; i < DDS_VOICES; i++ )
+    {
+        dds_voices[ i ].phase = 0;
+        dds_voices[ i ].increment = 0;
+        dds_voices[ i ].table = ddsSineTable;
+        dds_voices[ i ].amplitude = 0;
+    }
+
+    DdsTimer::setMode( T16_FAST_PWM_ICRN );
+    DdsTimer::setTopValue( kTop );
+    DdsTimer::setCompareMatchValue( T16_COMP_A, kMiddle );
+    DdsTimer::setPwmPinMode( T16_COMP_A, T16_PIN_PWM_NORMAL );
+    DdsTimer::setActualCountValue( 0 );
+    DdsTimer::clearPendingInterruptEvents( T16_INT_OVERFLOW );
+    DdsTimer::enableInterrupts( T16_INT_OVERFLOW );
+    DdsTimer::selectClockSource( T16_PRESC_1 );
+}
+
+
+
+
+void ddsStop()
+{
+    DdsTimer::disableInterrupts( T16_INT_OVERFLOW );
+    DdsTimer::selectClockSource( T16_CLK_OFF );
+}
+
+
+
+
+void ddsSetWaveform( uint8_t voice, const int8_t* table )
+{
+    if ( voice < DDS_VOICES )
+    {
+        ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+        {
+            dds_voices[ voice ].table = table;
+        }
+    }
+}
+
+
+
+
+void ddsSetFrequency( uint8_t voice, uint16_t hz )
+{
+    if ( hz > DDS_SAMPLE_RATE / 2 )
+    {
+        hz = DDS_SAMPLE_RATE / 2;
+    }
+    ddsSetPhaseIncrement( voice, hz * kIncrementPerHz
+                                 + ( ( static_cast<uint32_t>( hz ) * kIncrementPerHzFraction ) >> 16 ) );
+}
+
+
+
+
+void ddsSetPhaseIncrement( uint8_t voice, uint32_t increment )
+{
+    if ( voice < DDS_VOICES )
+    {
+        ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+        {
+            dds_voices[ voice ].increment = increment;
+        }
+    }
+}
+
+
+
+
+void ddsSetAmplitude( uint8_t voice, uint8_t amplitude )
+{
+    if ( voice < DDS_VOICES )
+    {
+        dds_voices[ voice ].amplitude = amplitude;
+    }
+}
+
+
+
+
+void ddsSetPhase( uint8_t voice, uint32_t phase )
+{
+    if ( voice < DDS_VOICES )
+    {
+        ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+        {
+            dds_voices[ voice ].phase = phase;
+        }
+    }
+}
+
+
+
+
+// 127 * sin( 2 * pi * i / 256 )
+const int8_t ddsSineTable[ 256 ] PROGMEM =
+{
+       0,    3,    6,    9,   12,   16,   19,   22,   25,   28,   31,   34,   37,   40,   43,   46,
+      49,   51,   54,   57,   60,   63,   65,   68,   71,   73,   76,   78,   81,   83,   85,   88,
+      90,   92,   94,   96,   98,  100,  102,  104,  106,  107,  109,  111,  112,  113,  115,  116,
+     117,  118,  120,  121,  122,  122,  123,  124,  125,  125,  126,  126,  126,  127,  127,  127,
+     127,  127,  127,  127,  126,  126,  126,  125,  125,  124,  123,  122,  122,  121,  120,  118,
+     117,  116,  115,  113,  112,  111,  109,  107,  106,  104,  102,  100,   98,   96,   94,   92,
+      90,   88,   85,   83,   81,   78,   76,   73,   71,   68,   65,   63,   60,   57,   54,   51,
+      49,   46,   43,   40,   37,   34,   31,   28,   25,   22,   19,   16,   12,    9,    6,    3,
+       0,   -3,   -6,   -9,  -12,  -16,  -19,  -22,  -25,  -28,  -31,  -34,  -37,  -40,  -43,  -46,
+     -49,  -51,  -54,  -57,  -60,  -63,  -65,  -68,  -71,  -73,  -76,  -78,  -81,  -83,  -85,  -88,
+     -90,  -92,  -94,  -96,  -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+    -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+    -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+    -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100,  -98,  -96,  -94,  -92,
+     -90,  -88,  -85,  -83,  -81,  -78,  -76,  -73,  -71,  -68,  -65,  -63,  -60,  -57,  -54,  -51,
+     -49,  -46,  -43,  -40,  -37,  -34,  -31,  -28,  -25,  -22,  -19,  -16,  -12,   -9,   -6,   -3
+};
+
+
+// Rises from 0 to 127, falls to -127 and rises to 0 again
+const int8_t ddsTriangleTable[ 256 ] PROGMEM =
+{
+       0,    2,    4,    6,    8,   10,   12,   14,   16,   18,   20,   22,   24,   26,   28,   30,
+      32,   34,   36,   38,   40,   42,   44,   46,   48,   50,   52,   54,   56,   58,   60,   62,
+      64,   66,   68,   70,   72,   74,   76,   78,   80,   82,   84,   86,   88,   90,   92,   94,
+      96,   98,  100,  102,  104,  106,  108,  110,  112,  114,  116,  118,  120,  122,  124,  126,
+     127,  126,  124,  122,  120,  118,  116,  114,  112,  110,  108,  106,  104,  102,  100,   98,
+      96,   94,   92,   90,   88,   86,   84,   82,   80,   78,   76,   74,   72,   70,   68,   66,
+      64,   62,   60,   58,   56,   54,   52,   50,   48,   46,   44,   42,   40,   38,   36,   34,
+      32,   30,   28,   26,   24,   22,   20,   18,   16,   14,   12,   10,    8,    6,    4,    2,
+       0,   -2,   -4,   -6,   -8,  -10,  -12,  -14,  -16,  -18,  -20,  -22,  -24,  -26,  -28,  -30,
+     -32,  -34,  -36,  -38,  -40,  -42,  -44,  -46,  -48,  -50,  -52,  -54,  -56,  -58,  -60,  -62,
+     -64,  -66,  -68,  -70,  -72,  -74,  -76,  -78,  -80,  -82,  -84,  -86,  -88,  -90,  -92,  -94,
+     -96,  -98, -100, -102, -104, -106, -108, -110, -112, -114, -116, -118, -120, -122, -124, -126,
+    -127, -126, -124, -122, -120, -118, -116, -114, -112, -110, -108, -106, -104, -102, -100,  -98,
+     -96,  -94,  -92,  -90,  -88,  -86,  -84,  -82,  -80,  -78,  -76,  -74,  -72,  -70,  -68,  -66,
+     -64,  -62,  -60,  -58,  -56,  -54,  -52,  -50,  -48,  -46,  -44,  -42,  -40,  -38,  -36,  -34,
+     -32,  -30,  -28,  -26,  -24,  -22,  -20,  -18,  -16,  -14,  -12,  -10,   -8,   -6,   -4,   -2
+};
+
+
+// Rises from -127 to 127
+const int8_t ddsSawtoothTable[ 256 ] PROGMEM =
+{
+    -127, -127, -126, -125, -124, -123, -122, -121, -120, -119, -118, -117, -116, -115, -114, -113,
+    -112, -111, -110, -109, -108, -107, -106, -105, -104, -103, -102, -101, -100,  -99,  -98,  -97,
+     -96,  -95,  -94,  -93,  -92,  -91,  -90,  -89,  -88,  -87,  -86,  -85,  -84,  -83,  -82,  -81,
+     -80,  -79,  -78,  -77,  -76,  -75,  -74,  -73,  -72,  -71,  -70,  -69,  -68,  -67,  -66,  -65,
+     -64,  -63,  -62,  -61,  -60,  -59,  -58,  -57,  -56,  -55,  -54,  -53,  -52,  -51,  -50,  -49,
+     -48,  -47,  -46,  -45,  -44,  -43,  -42,  -41,  -40,  -39,  -38,  -37,  -36,  -35,  -34,  -33,
+     -32,  -31,  -30,  -29,  -28,  -27,  -26,  -25,  -24,  -23,  -22,  -21,  -20,  -19,  -18,  -17,
+     -16,  -15,  -14,  -13,  -12,  -11,  -10,   -9,   -8,   -7,   -6,   -5,   -4,   -3,   -2,   -1,
+       0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,   15,
+      16,   17,   18,   19,   20,   21,   22,   23,   24,   25,   26,   27,   28,   29,   30,   31,
+      32,   33,   34,   35,   36,   37,   38,   39,   40,   41,   42,   43,   44,   45,   46,   47,
+      48,   49,   50,   51,   52,   53,   54,   55,   56,   57,   58,   59,   60,   61,   62,   63,
+      64,   65,   66,   67,   68,   69,   70,   71,   72,   73,   74,   75,   76,   77,   78,   79,
+      80,   81,   82,   83,   84,   85,   86,   87,   88,   89,   90,   91,   92,   93,   94,   95,
+      96,   97,   98,   99,  100,  101,  102,  103,  104,  105,  106,  107,  108,  109,  110,  111,
+     112,  113,  114,  115,  116,  117,  118,  119,  120,  121,  122,  123,  124,  125,  126,  127
+};
+
+
+// 127 in the first half of the period, -127 in the second half
+const int8_t ddsSquareTable[ 256 ] PROGMEM =
+{
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127
+};
@@ -0,0 +1,177 @@
+/*
+    DdsGenerator.h - Generates waveforms (sine, triangle, arbitrary tables)
+    with direct digital synthesis and a hardware-PWM-signal.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to generate waveforms with direct digital synthesis (DDS) on the PWM-pin OCnA of a
+ * 16-bit-Timer/Counter.
+ *
+ * To use these functions, include DdsGenerator.h in your source code and link against DdsGenerator.cpp and
+ * Timer16Bit.cpp.
+ *
+ * The Timer/Counter `DDS_TIMER` runs in fast-PWM-mode with ICRn as TOP-value and the frequency
+ * `DDS_SAMPLE_RATE`. Its overflow-interrupt calculates one sample per PWM-period. Each of the `DDS_VOICES` voices
+ * has a 32-bit phase-accumulator, that is advanced by the phase-increment of the voice. The upper 8 bits of the
+ * phase are the index into a table of 256 signed 8-bit values in flash-memory. The values of all voices are
+ * multiplied with their amplitudes, added, and written to OCRnA. Put a low-pass-filter (for example a resistor and
+ * a capacitor) behind the pin.
+ *
+ * The frequency of a voice is `increment * DDS_SAMPLE_RATE / 2^32`, with a resolution of less than 0.00001 Hz. A
+ * new frequency or waveform only changes the increment or the table, the phase continues, so there is no jump in
+ * the signal.
+ *
+ * \note Linking against DdsGenerator.cpp installs the overflow-interrupt of the Timer/Counter `DDS_TIMER`. Don't
+ * use this Timer/Counter for other purposes.
+ */
+
+
+
+#ifndef DdsGenerator_h
+#define DdsGenerator_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+
+/*!
+ * The 16-bit-Timer/Counter, that generates the PWM-signal: 1 (default), or 3, 4, 5 on the ATmega2560.
+ */
+#ifndef DDS_TIMER
+#define DDS_TIMER                   1
+#endif
+
+#if DDS_TIMER != 1 && DDS_TIMER != 3 && DDS_TIMER != 4 && DDS_TIMER != 5
+    #error "DDS_TIMER must be 1, 3, 4 or 5"
+#endif
+
+
+/*!
+ * The number of voices (1 .. 4). Each voice needs about 50 clock-cycles per sample in the interrupt-service-routine.
+ */
+#ifndef DDS_VOICES
+#define DDS_VOICES                  1
+#endif
+
+#if DDS_VOICES < 1 || DDS_VOICES > 4
+    #error "DDS_VOICES must be between 1 and 4"
+#endif
+
+
+/*!
+ * The sample-rate in Hz, this is also the PWM-frequency. The resolution of the PWM is F_CPU / DDS_SAMPLE_RATE
+ * steps (512 with the default 31250 Hz at 16 MHz). It must be at least 256 steps.
+ */
+#ifndef DDS_SAMPLE_RATE
+#define DDS_SAMPLE_RATE             31250
+#endif
+
+#if F_CPU / DDS_SAMPLE_RATE < 256 || F_CPU / DDS_SAMPLE_RATE > 65536
+    #error "DDS_SAMPLE_RATE doesn't fit to F_CPU (F_CPU / DDS_SAMPLE_RATE must be 256 .. 65536)"
+#endif
+
+
+/*!
+ * The phase-increment for the frequency `hz`, calculated at compile-time (`hz` is a constant, it may have a
+ * fractional part, for example 440.5).
+ */
+#define DDS_PHASE_INCREMENT( hz )   ( static_cast<uint32_t>( (hz) * 4294967296.0 / DDS_SAMPLE_RATE + 0.5 ) )
+
+
+/*!
+ * Wave-tables for `ddsSetWaveform()`: 256 signed values (-127 .. 127) for one period. Own tables must be declared
+ * the same way with PROGMEM.
+ */
+extern const int8_t ddsSineTable[ 256 ] PROGMEM;
+extern const int8_t ddsTriangleTable[ 256 ] PROGMEM;        //!< \copydoc ddsSineTable
+extern const int8_t ddsSawtoothTable[ 256 ] PROGMEM;        //!< \copydoc ddsSineTable
+extern const int8_t ddsSquareTable[ 256 ] PROGMEM;          //!< \copydoc ddsSineTable
+
+
+/*!
+ * \brief Starts the PWM and the interrupt-service-routine. All voices have the sine-table, the frequency 0 and the
+ * amplitude 0, so the output is in the middle of the range.
+ *
+ * Make the pin OCnA an output (for example with `setGpioPinModeOutput()`). Interrupts must be globally enabled.
+ */
+
+void ddsInit();
+
+
+/*!
+ * \brief Stops the Timer/Counter and the interrupt-service-routine.
+ */
+
+void ddsStop();
+
+
+/*!
+ * \brief Sets the wave-table of a voice.
+ *
+ * \arg \c voice 0 .. DDS_VOICES-1
+ * \arg \c table 256 signed 8-bit values in flash-memory (declared with PROGMEM), for example `ddsSineTable`.
+ */
+
+void ddsSetWaveform( uint8_t voice, const int8_t* table );
+
+
+/*!
+ * \brief Sets the frequency of a voice in Hz (0 .. DDS_SAMPLE_RATE / 2).
+ *
+ * The phase-increment is calculated with two multiplications, without a division.
+ */
+
+void ddsSetFrequency( uint8_t voice, uint16_t hz );
+
+
+/*!
+ * \brief Sets the phase-increment of a voice. The frequency is `increment * DDS_SAMPLE_RATE / 2^32`. For constant
+ * frequencies use the macro `DDS_PHASE_INCREMENT( hz )`.
+ *
+ * The 32-bit-value is written with interrupts disabled, so the interrupt-service-routine never uses a half-written
+ * increment.
+ */
+
+void ddsSetPhaseIncrement( uint8_t voice, uint32_t increment );
+
+
+/*!
+ * \brief Sets the amplitude of a voice: 0 (silent) .. 255 (full range). With more than one voice, each voice gets
+ * 1 / DDS_VOICES of the range.
+ */
+
+void ddsSetAmplitude( uint8_t voice, uint8_t amplitude );
+
+
+/*!
+ * \brief Sets the phase of a voice (the phase-accumulator, 2^32 is one period), for example to start two voices in
+ * step.
+ */
+
+void ddsSetPhase( uint8_t voice, uint32_t phase );
+
+
+#endif
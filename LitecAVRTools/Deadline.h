@@ -0,0 +1,284 @@
+/*
+    Deadline.h - Overflow-safe deadlines, timeouts and elapsed-time measurement
+    on 16-bit and 32-bit tick counters.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to use deadlines, timeouts and periodic events, that work correctly, when the
+ * tick-counter overflows.
+ *
+ * This module consists only of this header-file. It needs C++11 (`-std=gnu++11`), because the unit-conversions
+ * are `constexpr`. With constant arguments, they are calculated by the compiler and produce no code.
+ *
+ * A `Deadline` is bound to a clock at compile-time. The clocks `MillisClock` and `MicrosClock` use `millis()` and
+ * `micros()` from the SystemClock-module (32 bits). `Millis16Clock` and `Micros16Clock` use only the lower 16 bits,
+ * which makes all comparisons and subtractions shorter and faster; they can be used for intervals up to 65535
+ * ticks. Other clocks, for example a hardware-timer, can be defined by the user (see `MillisClock` as a template).
+ *
+ * Example:
+ * ```C
+ * MillisDeadline timeout( MillisDeadline::fromMilliseconds( 500 ) );
+ * while ( ! byteReceived() )
+ * {
+ *     if ( timeout.expired() ) { ... }
+ * }
+ * ```
+ */
+
+
+
+#ifndef Deadline_h
+#define Deadline_h
+
+#include <stdint.h>
+
+#include "SystemClock.h"
+
+
+
+/*!
+ * \brief Converts microseconds into clock-cycles of the CPU, rounded to the nearest value.
+ *
+ * Unlike the macro `microsecondsToClockCycles`, this is exact for every F_CPU (for example 14.7456 MHz). With a
+ * constant argument, it is calculated at compile-time. The result must fit into 32 bits.
+ */
+constexpr unsigned long cyclesFromMicroseconds( unsigned long us )
+{
+    return ( static_cast<unsigned long long>( us ) * F_CPU + 500000ULL ) / 1000000ULL;
+}
+
+
+/*!
+ * \brief Converts clock-cycles of the CPU into microseconds, rounded to the nearest value.
+ *
+ * Unlike the macro `clockCyclesToMicroseconds`, this is exact for every F_CPU. With a constant argument, it is
+ * calculated at compile-time.
+ */
+constexpr unsigned long microsecondsFromCycles( unsigned long cycles )
+{
+    return ( static_cast<unsigned long long>( cycles ) * 1000000ULL + F_CPU / 2 ) / F_CPU;
+}
+
+
+/*!
+ * \brief Converts microseconds into ticks of a timer with the given prescaler, rounded to the nearest value.
+ *
+ * With constant arguments, it is calculated at compile-time. For example the compare-match-value for a
+ * 2.5 ms period of Timer1 with prescaler 64 is `timerTicksFromMicroseconds( 2500, 64 )`.
+ */
+constexpr unsigned long timerTicksFromMicroseconds( unsigned long us, unsigned int prescaler )
+{
+    return ( static_cast<unsigned long long>( us ) * F_CPU + 500000ULL * prescaler )
+                / ( 1000000ULL * prescaler );
+}
+
+
+
+/*!
+ * Clock for `Deadline`: `millis()`, 32 bits.
+ *
+ * A clock is a class with a type `Tick` (an unsigned integer), a static function `now()` returning the actual
+ * tick-count, and a constexpr function `ticksPerSecond()`.
+ */
+struct MillisClock
+{
+    typedef unsigned long Tick;
+    static Tick now() { return millis(); }
+    static constexpr unsigned long ticksPerSecond() { return 1000; }
+};
+
+/*!
+ * Clock for `Deadline`: the lower 16 bits of `millis()`. For intervals up to 65.5 seconds.
+ */
+struct Millis16Clock
+{
+    typedef uint16_t Tick;
+    static Tick now() { return static_cast<uint16_t>( millis() ); }
+    static constexpr unsigned long ticksPerSecond() { return 1000; }
+};
+
+/*!
+ * Clock for `Deadline`: `micros()`, 32 bits. The resolution is 4 microseconds at 16 MHz.
+ */
+struct MicrosClock
+{
+    typedef unsigned long Tick;
+    static Tick now() { return micros(); }
+    static constexpr unsigned long ticksPerSecond() { return 1000000; }
+};
+
+/*!
+ * Clock for `Deadline`: the lower 16 bits of `micros()`. For intervals up to 65.5 milliseconds.
+ */
+struct Micros16Clock
+{
+    typedef uint16_t Tick;
+    static Tick now() { return static_cast<uint16_t>( micros() ); }
+    static constexpr unsigned long ticksPerSecond() { return 1000000; }
+};
+
+
+
+/*!
+ * \brief A deadline (or timeout) on the tick-counter of `Clock`.
+ *
+ * A deadline stores its start-time and its interval. All comparisons use the difference `now - start`, calculated
+ * with the width of the tick-counter, so they work correctly when the counter overflows, as long as the elapsed
+ * time is less than 2^bits ticks (for example 49.7 days for `MillisClock`, 65.5 seconds for `Millis16Clock`). So
+ * check a deadline at least once within this time. The interval itself can be up to 2^bits - 1 ticks.
+ *
+ * Every method reads the clock only once.
+ */
+template< typename Clock >
+class Deadline
+{
+public:
+
+    typedef typename Clock::Tick Tick;
+
+    /*!
+     * Converts milliseconds into ticks of the clock at compile-time (with a constant argument). The result must
+     * fit into `Tick`.
+     */
+    static constexpr Tick fromMilliseconds( unsigned long ms )
+    {
+        return static_cast<Tick>( ( static_cast<unsigned long long>( ms ) * Clock::ticksPerSecond() + 500ULL )
+                                    / 1000ULL );
+    }
+
+    /*!
+     * Converts microseconds into ticks of the clock at compile-time (with a constant argument). The result must
+     * fit into `Tick`.
+     */
+    static constexpr Tick fromMicroseconds( unsigned long us )
+    {
+        return static_cast<Tick>( ( static_cast<unsigned long long>( us ) * Clock::ticksPerSecond() + 500000ULL )
+                                    / 1000000ULL );
+    }
+
+    /*!
+     * Constructor. The deadline starts now and expires after `interval` ticks. Without an argument the deadline is
+     * already expired, which is useful for measuring elapsed time only.
+     */
+    explicit Deadline( Tick interval = 0 )
+        : m_start( Clock::now() )
+        , m_interval( interval )
+    {}
+
+    /*!
+     * Restarts the deadline now, with a new interval.
+     */
+    void start( Tick interval )
+    {
+        m_start = Clock::now();
+        m_interval = interval;
+    }
+
+    /*!
+     * Restarts the deadline now, with the same interval.
+     */
+    void restart()
+    {
+        m_start = Clock::now();
+    }
+
+    /*!
+     * Returns the number of ticks since the start.
+     */
+    Tick elapsed() const
+    {
+        return static_cast<Tick>( Clock::now() - m_start );
+    }
+
+    /*!
+     * Returns non-zero, if the interval has passed.
+     */
+    uint8_t expired() const
+    {
+        return elapsed() >= m_interval;
+    }
+
+    /*!
+     * Returns the number of ticks until the deadline expires, or 0 if it has expired.
+     */
+    Tick remaining() const
+    {
+        Tick e = elapsed();
+        return ( e >= m_interval ) ? 0 : static_cast<Tick>( m_interval - e );
+    }
+
+    /*!
+     * For periodic events: returns non-zero, if the interval has passed, and then moves the start-time forward by
+     * one interval. So the period doesn't drift, even if this method is called late. If it is called more than one
+     * interval late, it returns non-zero for each missed period.
+     */
+    uint8_t periodic()
+    {
+        if ( elapsed() >= m_interval )
+        {
+            m_start += m_interval;
+            return 1;
+        }
+        return 0;
+    }
+
+    /*!
+     * Returns the interval of the deadline.
+     */
+    Tick interval() const
+    {
+        return m_interval;
+    }
+
+private:
+
+    Tick m_start;
+    Tick m_interval;
+};
+
+
+
+/*!
+ * Deadline on `millis()` (32 bits).
+ */
+typedef Deadline< MillisClock >     MillisDeadline;
+
+/*!
+ * Deadline on the lower 16 bits of `millis()`, for intervals up to 65.5 seconds. Needs half the RAM and is faster
+ * than `MillisDeadline`.
+ */
+typedef Deadline< Millis16Clock >   ShortMillisDeadline;
+
+/*!
+ * Deadline on `micros()` (32 bits).
+ */
+typedef Deadline< MicrosClock >     MicrosDeadline;
+
+/*!
+ * Deadline on the lower 16 bits of `micros()`, for intervals up to 65.5 milliseconds.
+ */
+typedef Deadline< Micros16Clock >   ShortMicrosDeadline;
+
+
+#endif
@@ -0,0 +1,154 @@
+/*
+    EventTrace.cpp - A ring buffer for tracing events in interrupt-service-routines
+    and in the main program, which is transmitted in the background over a USART.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "EventTrace.h"
+
+#include <util/atomic.h>
+
+
+
+#if EVENT_TRACE_ALIGNED != 0
+EventTraceRecord    _eventTraceBuffer[ EVENT_TRACE_SIZE ] __attribute__((aligned(256)));
+#else
+EventTraceRecord    _eventTraceBuffer[ EVENT_TRACE_SIZE ];
+#endif
+volatile uint8_t    _eventTraceHead;
+volatile uint8_t    _eventTraceTail;
+volatile uint8_t    _eventTraceDropped;
+
+
+
+namespace
+{
+    const uint8_t kSyncByte = 0x7E;
+    const uint8_t kFrameLength = 6;
+
+    // The frame, that is actually transmitted by eventTraceDrain()
+    uint8_t frame[ kFrameLength ];
+    uint8_t framePosition = kFrameLength;
+
+    // Number of dropped events, that have not been reported yet, and the byte-offset in the buffer, after which
+    // they have been dropped.
+    uint8_t droppedPending;
+    uint8_t droppedPosition;
+
+    // Timestamp of the last transmitted event. Used as timestamp of the frame reporting dropped events.
+    uint16_t lastTimestamp;
+
+
+    void buildFrame( uint16_t timestamp, uint8_t id, uint8_t payload )
+    {
+        frame[0] = kSyncByte;
+        frame[1] = static_cast<uint8_t>( timestamp );
+        frame[2] = static_cast<uint8_t>( timestamp >> 8 );
+        frame[3] = id;
+        frame[4] = payload;
+        frame[5] = ~static_cast<uint8_t>( frame[1] + frame[2] + frame[3] + frame[4] );
+        framePosition = 0;
+    }
+
+
+    // Builds the next frame to transmit. Returns 0, if there is nothing to transmit.
+    uint8_t loadNextFrame()
+    {
+        uint8_t dropped;
+        uint8_t head;
+
+        ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+        {
+            dropped = _eventTraceDropped;
+            _eventTraceDropped = 0;
+            head = _eventTraceHead;
+        }
+
+        if ( dropped )
+        {
+            // Events are only dropped, when the buffer is full. So they are newer than all events in the buffer.
+            uint16_t sum = droppedPending + dropped;
+            droppedPending = ( sum > 0xFF ) ? 0xFF : sum;
+            droppedPosition = head;
+        }
+
+        uint8_t tail = _eventTraceTail;
+
+        if ( droppedPending && tail == droppedPosition )
+        {
+            buildFrame( lastTimestamp, EVENT_TRACE_ID_DROPPED, droppedPending );
+            droppedPending = 0;
+            return 1;
+        }
+
+        if ( tail == head )
+        {
+            return 0;
+        }
+
+        const EventTraceRecord* record = reinterpret_cast<const EventTraceRecord*>(
+                                            reinterpret_cast<const uint8_t*>( _eventTraceBuffer ) + tail );
+        lastTimestamp = record->timestamp;
+        buildFrame( record->timestamp, record->id, record->payload );
+
+        // The record must be copied, before the writers may use it again
+        __asm__ __volatile__ ( "" ::: "memory" );
+        _eventTraceTail = static_cast<uint8_t>( tail + sizeof( EventTraceRecord ) ) & _EVENT_TRACE_OFFSET_MASK;
+
+        return 1;
+    }
+};
+
+
+
+
+void eventTraceInit()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        _eventTraceHead = 0;
+        _eventTraceTail = 0;
+        _eventTraceDropped = 0;
+        droppedPending = 0;
+        framePosition = kFrameLength;
+    }
+}
+
+
+
+
+void eventTraceDrain( Usart& usart )
+{
+    while ( 1 )
+    {
+        if ( framePosition == kFrameLength && ! loadNextFrame() )
+        {
+            return;
+        }
+
+        if ( usart.transmitByteNonBlocking( frame[ framePosition ] ) != 0 )
+        {
+            return;
+        }
+
+        framePosition++;
+    }
+}
@@ -0,0 +1,210 @@
+/*
+    EventTrace.h - A ring buffer for tracing events in interrupt-service-routines
+    and in the main program, which is transmitted in the background over a USART.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to trace events (for example the entry into an interrupt-service-routine) with a
+ * timestamp into a ring buffer, and to transmit the trace over a USART.
+ *
+ * To use these functions, include EventTrace.h in your source code and link against EventTrace.cpp and Usart.cpp.
+ *
+ * An event is written with `EVENT_TRACE( id, payload )` in the main program, or with
+ * `EVENT_TRACE_FROM_ISR( id, payload )` in an interrupt-service-routine. `eventTraceDrain()` must be called
+ * regularly in the main loop. It transmits the recorded events as binary frames, without waiting for the USART.
+ * The python-script tools/decodeEventTrace.py turns the received frames into a timeline.
+ */
+
+
+
+#ifndef EventTrace_h
+#define EventTrace_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "Usart.h"
+
+
+/*!
+ * Number of records in the ring buffer. Must be a power of two between 2 and 64. Each record needs 4 bytes
+ * of RAM. One record is always kept free, so `EVENT_TRACE_SIZE - 1` events can be buffered.
+ */
+#ifndef EVENT_TRACE_SIZE
+#define EVENT_TRACE_SIZE            64
+#endif
+
+#if EVENT_TRACE_SIZE < 2 || EVENT_TRACE_SIZE > 64 || ( EVENT_TRACE_SIZE & ( EVENT_TRACE_SIZE - 1 ) ) != 0
+    #error "EVENT_TRACE_SIZE must be a power of two between 2 and 64"
+#endif
+
+
+/*!
+ * If 1, the buffer is aligned to 256 bytes. Then the byte-offset of a record is directly the low byte of its address,
+ * which saves the addition in the EVENT_TRACE-macros. Only possible with `EVENT_TRACE_SIZE` 64, and up to 255 bytes
+ * of RAM may be lost in front of the buffer for the alignment. Default is 0.
+ */
+#ifndef EVENT_TRACE_ALIGNED
+#define EVENT_TRACE_ALIGNED         0
+#endif
+
+#if EVENT_TRACE_ALIGNED != 0 && EVENT_TRACE_SIZE != 64
+    #error "EVENT_TRACE_ALIGNED needs EVENT_TRACE_SIZE 64"
+#endif
+
+
+/*!
+ * The 16-bit-register that is read as timestamp of an event. The default is the counter-register of
+ * Timer/Counter1, which must be started by the user (for example in normal mode with prescaler 1, then the
+ * timestamp counts clock-cycles). Any other 16-bit-counter can be used.
+ */
+#ifndef EVENT_TRACE_TIMESTAMP
+#define EVENT_TRACE_TIMESTAMP       TCNT1
+#endif
+
+
+/*!
+ * The event-ID reserved for the frame, that reports lost events. Its payload is the number of events, that could
+ * not be written, because the ring buffer was full (at most 255).
+ */
+#define EVENT_TRACE_ID_DROPPED      0xFF
+
+
+/*!
+ * One record in the ring buffer.
+ */
+struct EventTraceRecord
+{
+    uint16_t timestamp;     //!< value of EVENT_TRACE_TIMESTAMP, when the event was written
+    uint8_t id;             //!< ID of the event, chosen by the user (0..254)
+    uint8_t payload;        //!< Additional data of the event, chosen by the user
+};
+
+
+// private variables, only used by the EVENT_TRACE-macros and EventTrace.cpp
+// The head and tail are byte-offsets into the buffer (index * 4), which saves the multiplication in the macros.
+extern EventTraceRecord     _eventTraceBuffer[ EVENT_TRACE_SIZE ];
+extern volatile uint8_t     _eventTraceHead;
+extern volatile uint8_t     _eventTraceTail;
+extern volatile uint8_t     _eventTraceDropped;
+
+#define _EVENT_TRACE_OFFSET_MASK    ( EVENT_TRACE_SIZE * sizeof( EventTraceRecord ) - 1 )
+
+
+// private function, only used by the EVENT_TRACE-macros. Must be called with interrupts disabled.
+inline void _eventTraceWrite( uint8_t id, uint8_t payload ) __attribute__((always_inline));
+inline void _eventTraceWrite( uint8_t id, uint8_t payload )
+{
+    uint8_t head = _eventTraceHead;
+    uint8_t next = static_cast<uint8_t>( head + sizeof( EventTraceRecord ) ) & _EVENT_TRACE_OFFSET_MASK;
+
+    if ( next == _eventTraceTail )
+    {
+        // Buffer full: the newest event is dropped, and only counted
+        if ( _eventTraceDropped != 0xFF )
+        {
+            _eventTraceDropped++;
+        }
+        return;
+    }
+
+#if EVENT_TRACE_ALIGNED != 0
+    // The address of the record: the high byte of the buffer-address and the head as low byte, without an addition
+    EventTraceRecord* record;
+    __asm__
+    (
+        "mov %A0, %1"               "\n\t"
+        "ldi %B0, hi8(%2)"
+        : "=e" ( record )
+        : "r" ( head ), "i" ( _eventTraceBuffer )
+    );
+#else
+    EventTraceRecord* record = reinterpret_cast<EventTraceRecord*>(
+                                    reinterpret_cast<uint8_t*>( _eventTraceBuffer ) + head );
+#endif
+    record->timestamp = EVENT_TRACE_TIMESTAMP;
+    record->id = id;
+    record->payload = payload;
+
+    _eventTraceHead = next;
+}
+
+
+/*!
+ * Writes an event into the trace-buffer. Can be used everywhere: Interrupts are disabled while the event is
+ * written, and the global interrupt-flag is restored afterwards.
+ *
+ * \arg \c id The ID of the event (0..254). 255 is reserved (see `EVENT_TRACE_ID_DROPPED`).
+ * \arg \c payload 8 bits of additional data.
+ */
+#define EVENT_TRACE( id, payload )                  \
+    do                                              \
+    {                                               \
+        uint8_t _eventTraceSreg = SREG;             \
+        cli();                                      \
+        _eventTraceWrite( (id), (payload) );        \
+        SREG = _eventTraceSreg;                     \
+    } while ( 0 )
+
+
+/*!
+ * Writes an event into the trace-buffer. This is the faster variant for interrupt-service-routines, in which
+ * interrupts are already disabled. Don't use it in an ISR declared with `ISR_NOBLOCK`.
+ *
+ * \arg \c id The ID of the event (0..254). 255 is reserved (see `EVENT_TRACE_ID_DROPPED`).
+ * \arg \c payload 8 bits of additional data.
+ */
+#define EVENT_TRACE_FROM_ISR( id, payload )         _eventTraceWrite( (id), (payload) )
+
+
+/*!
+ * \brief Empties the trace-buffer and resets the count of dropped events.
+ *
+ * Call this function once, before events are written.
+ */
+
+void eventTraceInit();
+
+
+/*!
+ * \brief Transmits recorded events over a USART, without waiting.
+ *
+ * As many bytes are transmitted, as the USART accepts without waiting (normally only one byte per call). Call this
+ * function regularly in the main loop. It must not be called from an interrupt-service-routine, and always with
+ * the same `Usart`-object.
+ *
+ * Each event is transmitted as a frame of 6 bytes: the sync-byte 0x7E, the timestamp (low byte first), the ID,
+ * the payload and a checksum (the inverted 8-bit-sum of the four data-bytes). If events had to be dropped, because
+ * the buffer was full, a frame with the ID `EVENT_TRACE_ID_DROPPED` is transmitted after the last event that could
+ * be recorded.
+ *
+ * \arg \c usart The initialized `Usart`-object used for transmission.
+ */
+
+void eventTraceDrain( Usart& usart );
+
+
+#endif
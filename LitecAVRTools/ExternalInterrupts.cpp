@@ -25,27 +25,6 @@
 #include "ExternalInterrupts.h"
 
 
-// Number of external Interrupts
-#if defined(INT7_vect)
-    #define EXT_INT_COUNT  8
-#elif defined(INT6_vect)
-    #define EXT_INT_COUNT  7
-#elif defined(INT5_vect)
-    #define EXT_INT_COUNT  6
-#elif defined(INT4_vect)
-    #define EXT_INT_COUNT  5
-#elif defined(INT3_vect)
-    #define EXT_INT_COUNT  4
-#elif defined(INT2_vect)
-    #define EXT_INT_COUNT  3
-#elif defined(INT1_vect)
-    #define EXT_INT_COUNT  2
-#elif defined(INT0_vect)
-    #define EXT_INT_COUNT  1
-#else
-    #error "There are no external Interrupts. Don't use this module"
-#endif
-
 //////////////////////////////////////////////////////////////////////////
 // C-Functions-API
 //////////////////////////////////////////////////////////////////////////
@@ -23,8 +23,95 @@
 #ifndef EXTERNALINTERRUPTS_H_
 #define EXTERNALINTERRUPTS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <avr/io.h>
+
+// Number of external Interrupts
+#if defined(INT7_vect)
+    #define EXT_INT_COUNT  8
+#elif defined(INT6_vect)
+    #define EXT_INT_COUNT  7
+#elif defined(INT5_vect)
+    #define EXT_INT_COUNT  6
+#elif defined(INT4_vect)
+    #define EXT_INT_COUNT  5
+#elif defined(INT3_vect)
+    #define EXT_INT_COUNT  4
+#elif defined(INT2_vect)
+    #define EXT_INT_COUNT  3
+#elif defined(INT1_vect)
+    #define EXT_INT_COUNT  2
+#elif defined(INT0_vect)
+    #define EXT_INT_COUNT  1
+#else
+    #error "There are no external Interrupts. Don't use this module"
+#endif
+
+// The PINx-register and the bit of the pin of external Interrupt n (n must
+// be a constant)
+#if EXT_INT_COUNT == 8
+    // ATmega2560: INT0..INT3 are PD0..PD3, INT4..INT7 are PE4..PE7
+    #define EXTINT_PIN_REGISTER( n )    ( (n) < 4 ? PIND : PINE )
+    #define EXTINT_PIN_BIT( n )         ( n )
+#elif EXT_INT_COUNT == 2
+    // ATmega328p: INT0 and INT1 are PD2 and PD3
+    #define EXTINT_PIN_REGISTER( n )    PIND
+    #define EXTINT_PIN_BIT( n )         ( (n) + 2 )
+#endif
+
+/**
+ * Bit n set means, that ExternalInterruptsDispatch.cpp contains the
+ * Interrupt-Service-Routine for INTn, which calls the function registered
+ * with `attachExtInt()`. Clear the bits of the external Interrupts, for which
+ * you write the Interrupt-Service-Routine yourself (with the `ISR`-macro or
+ * with `EXTINT_BIND_HANDLER`). The same value must be used for all
+ * source-files (for example with -DEXTINT_DISPATCH_MASK=0x01).
+ *
+ * Only needed, if ExternalInterruptsDispatch.cpp is linked.
+ */
+#ifndef EXTINT_DISPATCH_MASK
+#define EXTINT_DISPATCH_MASK            0xFF
+#endif
+
+/**
+ * Bit n set means, that ExternalInterruptsTimestamp.cpp contains the
+ * Interrupt-Service-Routine for INTn, which captures a timestamp and puts
+ * an `ExtIntEvent` into a queue (see `getExtIntEvent()`). These external
+ * Interrupts are left out by ExternalInterruptsDispatch.cpp. The same value
+ * must be used for all source-files (for example with
+ * -DEXTINT_TIMESTAMP_MASK=0x01).
+ */
+#ifndef EXTINT_TIMESTAMP_MASK
+#define EXTINT_TIMESTAMP_MASK           0x00
+#endif
+
+/**
+ * Number of entries in the queue of timestamped events. Must be a power of
+ * two between 2 and 128. Each entry needs 6 bytes of RAM. One entry is
+ * always kept free.
+ */
+#ifndef EXTINT_TIMESTAMP_QUEUE_SIZE
+#define EXTINT_TIMESTAMP_QUEUE_SIZE     16
+#endif
+
+#if EXTINT_TIMESTAMP_QUEUE_SIZE < 2 || EXTINT_TIMESTAMP_QUEUE_SIZE > 128 \
+        || ( EXTINT_TIMESTAMP_QUEUE_SIZE & ( EXTINT_TIMESTAMP_QUEUE_SIZE - 1 ) ) != 0
+    #error "EXTINT_TIMESTAMP_QUEUE_SIZE must be a power of two between 2 and 128"
+#endif
+
+/**
+ * The time in timer-ticks from the edge on the pin to the moment, when the
+ * Interrupt-Service-Routine reads the counter. It is subtracted from each
+ * timestamp. The default is for prescaler 1 (timer-ticks are clock-cycles);
+ * measure the value for your compiler with
+ * examples/exampleExtInt_Timestamp.cpp.
+ */
+#ifndef EXTINT_TIMESTAMP_LATENCY
+#define EXTINT_TIMESTAMP_LATENCY        42
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -44,6 +131,53 @@ extern "C" {
 #define EXTINT_RISING_EDGE              0x03  
 
 
+/**
+ * Binds a handler-function to an external Interrupt at compile-time. This
+ * macro creates the Interrupt-Service-Routine for INTn, which calls
+ * `handler()`. If the handler is defined before (as `static` or `inline`
+ * function), the compiler puts its code directly into the
+ * Interrupt-Service-Routine: there is no indirect call, and only the
+ * registers used by the handler are saved. This is the fastest way to react
+ * on an external Interrupt.
+ *
+ * Example: `EXTINT_BIND_HANDLER( 1, onInt1 )`
+ *
+ * Clear bit n in `EXTINT_DISPATCH_MASK`, if ExternalInterruptsDispatch.cpp is
+ * linked, otherwise there are two Interrupt-Service-Routines for INTn
+ * (the linker reports "multiple definition of __vector_n").
+ *
+ * @param number The Number of the external Interrupt (a literal number)
+ * @param handler A function without parameters
+ */
+#define EXTINT_BIND_HANDLER( number, handler )  _extIntBindHandler( number, handler )
+
+#define _extIntBindHandler( number, handler )                                   \
+    ISR( INT##number##_vect )                                                   \
+    {                                                                           \
+        handler();                                                              \
+    }
+
+
+/**
+ * A function, that is called by the Interrupt-Service-Routine of an external
+ * Interrupt (see `attachExtInt()`). The argument is the `context`-pointer,
+ * that was given to `attachExtInt()`, for example a pointer to the object of
+ * a driver.
+ */
+typedef void (*ExtIntCallback)( void* context );
+
+
+/**
+ * An edge on an INTx-Pin with its timestamp (see `getExtIntEvent()`).
+ */
+typedef struct
+{
+    uint32_t timestamp;     // Time of the edge in ticks of the Counter32-module
+    uint8_t extIntNumber;   // The Number of the external Interrupt
+    uint8_t level;          // Level of the pin after the edge: 1 for a rising edge, 0 for a falling edge
+} ExtIntEvent;
+
+
 //////////////////////////////////////////////////////////////////////////
 // C-Function-API
 //////////////////////////////////////////////////////////////////////////
@@ -108,6 +242,63 @@ void disableExtInt( uint8_t extIntNumber );
  */
 void clearPendingExtIntEvent( uint8_t extIntNumber );
 
+/**
+ * Registers a function, that is called each time the external Interrupt
+ * happens. So no Interrupt-Service-Routine has to be written, and drivers
+ * can use external Interrupts without knowing, which INTx-Pin is used.
+ *
+ * This function is in ExternalInterruptsDispatch.cpp. Linking this file
+ * installs the Interrupt-Service-Routines for all external Interrupts
+ * selected with `EXTINT_DISPATCH_MASK`. They call the registered function
+ * through a table of function-pointers, which takes about 50 clock-cycles
+ * from the Interrupt-Event to the first instruction of the function. If
+ * that is too slow, use `EXTINT_BIND_HANDLER` instead.
+ *
+ * The function is called with interrupts disabled, so it must be short.
+ *
+ * @param extIntNumber The Number of the external Interrupt
+ * @param callback The function
+ * @param context Passed to the function, may be NULL
+ * @return 0 on success, -1 if the external Interrupt doesn't exist, is
+ *      not selected in `EXTINT_DISPATCH_MASK`, or is selected in
+ *      `EXTINT_TIMESTAMP_MASK`.
+ */
+int8_t attachExtInt( uint8_t extIntNumber, ExtIntCallback callback, void* context );
+
+/**
+ * Removes the function registered with `attachExtInt()`. Interrupt-Events
+ * are ignored afterwards. The external Interrupt stays enabled, use
+ * `disableExtInt()` to disable it.
+ *
+ * @param extIntNumber The Number of the external Interrupt
+ */
+void detachExtInt( uint8_t extIntNumber );
+
+/**
+ * Takes the oldest timestamped event out of the queue.
+ *
+ * This function is in ExternalInterruptsTimestamp.cpp. Linking this file
+ * installs the Interrupt-Service-Routines for all external Interrupts
+ * selected with `EXTINT_TIMESTAMP_MASK`. Their first instruction after
+ * saving the registers reads the counter of the Counter32-module, so the
+ * timestamp doesn't depend on the time, the Interrupt-Service-Routine
+ * needs. `EXTINT_TIMESTAMP_LATENCY` is subtracted from it. Then the level of
+ * the pin is read, and the event is put into the queue.
+ *
+ * The Counter32-module must be initialized with `counter32Init()`, for
+ * example with `T16_PRESC_1` for timestamps in clock-cycles.
+ *
+ * @param event The event is written to this struct
+ * @return 1 if an event was available, 0 if the queue was empty.
+ */
+uint8_t getExtIntEvent( ExtIntEvent* event );
+
+/**
+ * Returns the number of events, that were dropped, because the queue was
+ * full, and sets this number to 0 (at most 255).
+ */
+uint8_t getLostExtIntEvents();
+
 #ifdef __cplusplus
 }
 #endif
@@ -182,6 +373,25 @@ public:
         ::clearPendingExtIntEvent(mExtIntNumber);
     }
 
+    /**
+     * Registers a function, that is called each time the external
+     * Interrupt happens. See C-function `attachExtInt` (link
+     * ExternalInterruptsDispatch.cpp).
+     *
+     * @param callback The function
+     * @param context Passed to the function, may be NULL
+     * @return 0 on success, -1 if the external Interrupt is not selected
+     *      in `EXTINT_DISPATCH_MASK`.
+     */
+    int8_t attach( ExtIntCallback callback, void* context = NULL )
+    { return ::attachExtInt( mExtIntNumber, callback, context ); }
+
+    /**
+     * Removes the function registered with `attach()`.
+     */
+    void detach()
+    { ::detachExtInt( mExtIntNumber ); }
+
 private:
     uint8_t mExtIntNumber;
 };
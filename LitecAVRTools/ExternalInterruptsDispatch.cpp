@@ -0,0 +1,148 @@
+/*
+    ExternalInterruptsDispatch.cpp - Interrupt-Service-Routines for the
+    external Interrupts, that call registered functions.
+
+    This is part of the LitecAVRTools-Library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "ExternalInterrupts.h"
+
+
+namespace
+{
+    // These variables are private to this module
+
+    struct ExtIntHandler
+    {
+        ExtIntCallback callback;
+        void* context;
+    };
+
+    // Called for external Interrupts without a registered function. So the
+    // Interrupt-Service-Routines don't have to check for NULL.
+    void ignoreExtInt( void* )
+    { }
+
+    #define _EXTINT_IGNORE      { ignoreExtInt, NULL }
+
+    // The table of registered functions. Written by the main program with
+    // interrupts disabled.
+    ExtIntHandler extint_handlers[ EXT_INT_COUNT ] =
+    {
+        _EXTINT_IGNORE
+    #if EXT_INT_COUNT > 1
+        , _EXTINT_IGNORE
+    #endif
+    #if EXT_INT_COUNT > 2
+        , _EXTINT_IGNORE
+    #endif
+    #if EXT_INT_COUNT > 3
+        , _EXTINT_IGNORE
+    #endif
+    #if EXT_INT_COUNT > 4
+        , _EXTINT_IGNORE
+    #endif
+    #if EXT_INT_COUNT > 5
+        , _EXTINT_IGNORE
+    #endif
+    #if EXT_INT_COUNT > 6
+        , _EXTINT_IGNORE
+    #endif
+    #if EXT_INT_COUNT > 7
+        , _EXTINT_IGNORE
+    #endif
+    };
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+// Interrupt-Service-Routines
+//////////////////////////////////////////////////////////////////////////
+
+// The compiler saves only the registers, that a called C-function may
+// change (r0, r1, SREG, r18..r27, r30, r31; and RAMPZ on the ATmega2560).
+// A hand-written assembler-trampoline would have to save the same registers,
+// so the Interrupt-Service-Routines are written in C++.
+// External Interrupts with timestamps have their Interrupt-Service-Routines
+// in ExternalInterruptsTimestamp.cpp
+#define _EXTINT_DISPATCHED      ( EXTINT_DISPATCH_MASK & ~EXTINT_TIMESTAMP_MASK )
+
+#define _EXTINT_DISPATCH_ISR( n )                                               \
+    ISR( INT##n##_vect )                                                        \
+    {                                                                           \
+        extint_handlers[ n ].callback( extint_handlers[ n ].context );          \
+    }
+
+#if ( _EXTINT_DISPATCHED & 0x01 ) && EXT_INT_COUNT > 0
+_EXTINT_DISPATCH_ISR( 0 )
+#endif
+#if ( _EXTINT_DISPATCHED & 0x02 ) && EXT_INT_COUNT > 1
+_EXTINT_DISPATCH_ISR( 1 )
+#endif
+#if ( _EXTINT_DISPATCHED & 0x04 ) && EXT_INT_COUNT > 2
+_EXTINT_DISPATCH_ISR( 2 )
+#endif
+#if ( _EXTINT_DISPATCHED & 0x08 ) && EXT_INT_COUNT > 3
+_EXTINT_DISPATCH_ISR( 3 )
+#endif
+#if ( _EXTINT_DISPATCHED & 0x10 ) && EXT_INT_COUNT > 4
+_EXTINT_DISPATCH_ISR( 4 )
+#endif
+#if ( _EXTINT_DISPATCHED & 0x20 ) && EXT_INT_COUNT > 5
+_EXTINT_DISPATCH_ISR( 5 )
+#endif
+#if ( _EXTINT_DISPATCHED & 0x40 ) && EXT_INT_COUNT > 6
+_EXTINT_DISPATCH_ISR( 6 )
+#endif
+#if ( _EXTINT_DISPATCHED & 0x80 ) && EXT_INT_COUNT > 7
+_EXTINT_DISPATCH_ISR( 7 )
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+// C-Functions-API
+//////////////////////////////////////////////////////////////////////////
+
+int8_t attachExtInt( uint8_t extIntNumber, ExtIntCallback callback, void* context )
+{
+    if (extIntNumber >= EXT_INT_COUNT) return -1;
+    if ( ! ( _EXTINT_DISPATCHED & (0x01<<extIntNumber) ) ) return -1;
+
+    if ( callback == NULL )
+    {
+        callback = ignoreExtInt;
+    }
+
+    //The Interrupt-Service-Routine must not see the new function with the
+    //old context
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        extint_handlers[ extIntNumber ].callback = callback;
+        extint_handlers[ extIntNumber ].context = context;
+    }
+    return 0;
+}
+
+void detachExtInt( uint8_t extIntNumber )
+{
+    attachExtInt( extIntNumber, NULL, NULL );
+}
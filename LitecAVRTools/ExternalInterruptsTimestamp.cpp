@@ -0,0 +1,155 @@
+/*
+    ExternalInterruptsTimestamp.cpp - Interrupt-Service-Routines for the
+    external Interrupts, that put timestamped events into a queue.
+
+    This is part of the LitecAVRTools-Library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "ExternalInterrupts.h"
+#include "Counter32.h"
+
+#ifndef EXTINT_PIN_REGISTER
+    #error "The pins of the external Interrupts of this microcontroller are unknown. Add them in ExternalInterrupts.h."
+#endif
+
+
+namespace
+{
+    // These variables are private to this module
+
+    const uint8_t kQueueMask = EXTINT_TIMESTAMP_QUEUE_SIZE - 1;
+
+    // The queue has one writer (the Interrupt-Service-Routines, they only
+    // change extint_head) and one reader (getExtIntEvent(), it only changes
+    // extint_tail). Both indexes are single bytes, so no locking is needed.
+    ExtIntEvent                 extint_queue[ EXTINT_TIMESTAMP_QUEUE_SIZE ];
+    volatile uint8_t            extint_head;
+    volatile uint8_t            extint_tail;
+    volatile uint8_t            extint_lost;
+
+
+    // Puts an event into the queue. Called by the Interrupt-Service-Routines.
+    inline void putEvent( uint16_t low, uint8_t extIntNumber, uint8_t level ) __attribute__((always_inline));
+    inline void putEvent( uint16_t low, uint8_t extIntNumber, uint8_t level )
+    {
+        uint8_t head = extint_head;
+        uint8_t next = ( head + 1 ) & kQueueMask;
+
+        if ( next == extint_tail )
+        {
+            // Queue full: the newest event is dropped
+            uint8_t lost = extint_lost;
+            if ( lost != 0xFF )
+            {
+                extint_lost = lost + 1;
+            }
+            return;
+        }
+
+        extint_queue[ head ].timestamp = counter32Extend( low ) - EXTINT_TIMESTAMP_LATENCY;
+        extint_queue[ head ].extIntNumber = extIntNumber;
+        extint_queue[ head ].level = level;
+        extint_head = next;
+    }
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+// Interrupt-Service-Routines
+//////////////////////////////////////////////////////////////////////////
+
+// The counter is read first. The registers saved before are always the
+// same, so the time from the edge to this read is constant (except for the
+// 0..3 cycles, until the CPU finishes the actual instruction), and is
+// corrected with EXTINT_TIMESTAMP_LATENCY.
+#define _EXTINT_TIMESTAMP_ISR( n )                                              \
+    ISR( INT##n##_vect )                                                        \
+    {                                                                           \
+        uint16_t low = counter32ReadLow();                                      \
+        uint8_t level = ( EXTINT_PIN_REGISTER( n ) >> EXTINT_PIN_BIT( n ) ) & 0x01; \
+        putEvent( low, n, level );                                              \
+    }
+
+#if ( EXTINT_TIMESTAMP_MASK & 0x01 ) && EXT_INT_COUNT > 0
+_EXTINT_TIMESTAMP_ISR( 0 )
+#endif
+#if ( EXTINT_TIMESTAMP_MASK & 0x02 ) && EXT_INT_COUNT > 1
+_EXTINT_TIMESTAMP_ISR( 1 )
+#endif
+#if ( EXTINT_TIMESTAMP_MASK & 0x04 ) && EXT_INT_COUNT > 2
+_EXTINT_TIMESTAMP_ISR( 2 )
+#endif
+#if ( EXTINT_TIMESTAMP_MASK & 0x08 ) && EXT_INT_COUNT > 3
+_EXTINT_TIMESTAMP_ISR( 3 )
+#endif
+#if ( EXTINT_TIMESTAMP_MASK & 0x10 ) && EXT_INT_COUNT > 4
+_EXTINT_TIMESTAMP_ISR( 4 )
+#endif
+#if ( EXTINT_TIMESTAMP_MASK & 0x20 ) && EXT_INT_COUNT > 5
+_EXTINT_TIMESTAMP_ISR( 5 )
+#endif
+#if ( EXTINT_TIMESTAMP_MASK & 0x40 ) && EXT_INT_COUNT > 6
+_EXTINT_TIMESTAMP_ISR( 6 )
+#endif
+#if ( EXTINT_TIMESTAMP_MASK & 0x80 ) && EXT_INT_COUNT > 7
+_EXTINT_TIMESTAMP_ISR( 7 )
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+// C-Functions-API
+//////////////////////////////////////////////////////////////////////////
+
+uint8_t getExtIntEvent( ExtIntEvent* event )
+{
+    uint8_t tail = extint_tail;
+
+    if ( tail == extint_head )
+    {
+        return 0;
+    }
+
+    //extint_queue is not volatile: the memory-barrier keeps the compiler
+    //from reading the entry before extint_head was checked.
+    __asm__ __volatile__( "" ::: "memory" );
+    *event = extint_queue[ tail ];
+
+    //Release the entry only after it has been copied. The memory-barrier
+    //keeps the compiler from moving the copy behind the write of extint_tail.
+    __asm__ __volatile__( "" ::: "memory" );
+    extint_tail = ( tail + 1 ) & kQueueMask;
+    return 1;
+}
+
+uint8_t getLostExtIntEvents()
+{
+    uint8_t lost;
+
+    //Read and clear without an Interrupt-Service-Routine in between
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        lost = extint_lost;
+        extint_lost = 0;
+    }
+
+    return lost;
+}
@@ -43,6 +43,21 @@
 
 
 
+/*! \brief Token-pasting for the modules, that select a timer or an external Interrupt with a macro.
+ *
+ * For example `litecAvrName3( TIMER, SOFT_PWM_TIMER, _COMPA_vect )` is `TIMER1_COMPA_vect`. The arguments are
+ * expanded before they are pasted, so they can be macros.
+ *
+ * \hideinitializer
+ */
+
+#define litecAvrName2( a, b )               litecAvrPaste2( a, b )
+#define litecAvrName3( a, b, c )            litecAvrPaste3( a, b, c )
+#define litecAvrPaste2( a, b )              a##b
+#define litecAvrPaste3( a, b, c )           a##b##c
+
+
+
 /*! \brief Constants for digital values representing LOW and HIGH
  *
  */
@@ -0,0 +1,185 @@
+/*
+    HalfBridgePwm.cpp - Complementary PWM-signals with a dead-time for a
+    half-bridge, generated by a 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "HalfBridgePwm.h"
+
+#include <avr/io.h>
+#include <util/atomic.h>
+
+
+namespace
+{
+    // log2 of the prescaler of the clock-sources T16_PRESC_1 .. T16_PRESC_1024
+    uint8_t prescalerShift( Timer16_ClockSource clockSource )
+    {
+        switch ( clockSource )
+        {
+            case T16_PRESC_8:       return 3;
+            case T16_PRESC_64:      return 6;
+            case T16_PRESC_256:     return 8;
+            case T16_PRESC_1024:    return 10;
+            default:                return 0;
+        }
+    }
+};
+
+
+
+
+int8_t HalfBridgePwm::init( uint32_t frequencyHz, uint16_t deadTimeNs, Timer16_mode mode )
+{
+    turnOff();
+
+    if ( ( mode != T16_PWM_PHI_F_CORRECT_ICRN && mode != T16_PWM_PHI_CORRECT_ICRN ) || frequencyHz == 0 )
+    {
+        return -1;
+    }
+
+    Timer16_Frequency f;
+    if ( timer16CalculateFrequency( _t16SubCyclesFromHz( frequencyHz ), mode, &f, 0 ) != 0 )
+    {
+        return -1;
+    }
+
+    // Dead-time in CPU-clock-cycles and then in timer-ticks, both rounded up
+    uint8_t shift = prescalerShift( f.clockSource );
+    uint32_t deadCycles = ( static_cast<uint32_t>( deadTimeNs ) * ( F_CPU / 1000UL ) + 999999UL ) / 1000000UL;
+    uint32_t deadTicks = ( deadCycles + ( 1UL << shift ) - 1 ) >> shift;
+    if ( deadTicks == 0 )
+    {
+        deadTicks = 1;
+    }
+
+    uint16_t guardTicks = ( HALF_BRIDGE_PWM_UPDATE_CYCLES >> shift ) + 1;
+
+    // The counter must leave the guard-zone around the update within a fraction of the period, and there must be
+    // room for a duty-cycle besides the dead-time
+    if ( f.top < 4 * guardTicks || deadTicks >= f.top / 2 )
+    {
+        return -1;
+    }
+
+    m_mode = mode;
+    m_clockSource = f.clockSource;
+    m_top = f.top;
+    m_deadTicks = deadTicks;
+    m_guardTicks = guardTicks;
+    return 0;
+}
+
+
+
+
+void HalfBridgePwm::start( uint16_t duty )
+{
+    if ( m_top == 0 )
+    {
+        return; // init() failed or wasn't called
+    }
+
+    // In normal mode the compare-match-registers are not double-buffered, so the first values are written directly
+    turnOff();
+    uint16_t dutyTicks = scaleDuty( duty );
+    m_timer.setCompareMatchValuesAB( dutyTicks + m_deadTicks, dutyTicks );
+
+    m_timer.setMode( m_mode );
+    m_timer.setTopValue( m_top );
+    m_timer.setPwmPinMode( T16_COMP_B, T16_PIN_PWM_INVERTED );
+    m_timer.setPwmPinMode( T16_COMP_A, T16_PIN_PWM_INVERTED );
+    m_timer.setActualCountValue( 0 );
+    m_timer.selectClockSource( m_clockSource );
+}
+
+
+
+
+void HalfBridgePwm::stop()
+{
+    turnOff();
+}
+
+
+
+
+void HalfBridgePwm::setDuty( uint16_t duty )
+{
+    setDutyTicks( scaleDuty( duty ) );
+}
+
+
+
+
+void HalfBridgePwm::setDutyTicks( uint16_t dutyTicks )
+{
+    uint16_t maxDuty = m_top - m_deadTicks;
+    if ( dutyTicks > maxDuty )
+    {
+        dutyTicks = maxDuty;
+    }
+    uint16_t ocra = dutyTicks + m_deadTicks;
+
+    // The registers are updated at BOTTOM (phase-and-frequency-correct mode) or at TOP (phase-correct mode). Outside
+    // the guard-zone the update is at least m_guardTicks away in both counting directions, so both writes finish
+    // before it. Inside, wait until the counter has left the zone (at most 2 * m_guardTicks).
+    uint16_t low = m_guardTicks;
+    uint16_t high = m_top - m_guardTicks;
+    uint8_t updateAtBottom = ( m_mode == T16_PWM_PHI_F_CORRECT_ICRN );
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        if ( updateAtBottom )
+        {
+            while ( m_timer.getActualCountValue() <= low )
+            { /*wait*/ }
+        }
+        else
+        {
+            while ( m_timer.getActualCountValue() >= high )
+            { /*wait*/ }
+        }
+        m_timer.setCompareMatchValuesAB( ocra, dutyTicks );
+    }
+}
+
+
+
+
+uint16_t HalfBridgePwm::scaleDuty( uint16_t duty )
+{
+    uint32_t maxDuty = m_top - m_deadTicks;
+    return static_cast<uint16_t>( ( static_cast<uint32_t>( duty ) * ( maxDuty + 1 ) ) >> 16 );
+}
+
+
+
+
+void HalfBridgePwm::turnOff()
+{
+    // Put out a high level on OCnB (upper transistor off) and a low level on OCnA (lower transistor off)
+    m_timer.selectClockSource( T16_CLK_OFF );
+    m_timer.setMode( T16_NORMAL );
+    m_timer.setPwmPinMode( T16_COMP_B, T16_PIN_SET_ON_MATCH );
+    m_timer.setPwmPinMode( T16_COMP_A, T16_PIN_CLEAR_ON_MATCH );
+    m_timer.forceOutputCompareMatch( T16_COMP_B | T16_COMP_A );
+}
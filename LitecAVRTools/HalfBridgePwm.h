@@ -0,0 +1,187 @@
+/*
+    HalfBridgePwm.h - Complementary PWM-signals with a dead-time for a
+    half-bridge, generated by a 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to drive a half-bridge (two transistors) with the PWM-pins OCnA and OCnB of a
+ * 16-bit-Timer/Counter, with a dead-time between switching off one transistor and switching on the other one.
+ *
+ * To use this class, include HalfBridgePwm.h in your source code and link against HalfBridgePwm.cpp and
+ * Timer16Bit.cpp.
+ *
+ * The half-bridge is connected like in exampleTimer16Bit_PWM.cpp: the "upper" transistor is on with a low level on
+ * OCnB (pnp-transistor or p-channel-MOSFET), the "lower" transistor is on with a high level on OCnA (npn-transistor
+ * or n-channel-MOSFET). Both pins run in inverted PWM-mode, and OCRnA is always the dead-time larger than OCRnB.
+ * This class calculates both compare-match-values from one duty-value, so they can't be set wrong by mistake.
+ *
+ * Example:
+ * ```C
+ * TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+ * HalfBridgePwm bridge( tc1 );
+ *
+ * bridge.init( 20000, 500 );           // 20 kHz, 500 ns dead-time, both transistors off
+ * setGpioPinModeOutput( GpioPin( B, 1 ) );
+ * setGpioPinModeOutput( GpioPin( B, 2 ) );
+ * bridge.start( 0x8000 );              // 50 % duty-cycle
+ * ...
+ * bridge.setDuty( 0xC000 );            // 75 %
+ * ```
+ */
+
+
+
+#ifndef HalfBridgePwm_h
+#define HalfBridgePwm_h
+
+#include <stdint.h>
+
+#include "Timer16Bit.h"
+
+
+/*!
+ * The number of clock-cycles between reading the count-value and the end of the last write to a compare-match-
+ * register in `setDutyTicks()`, with some reserve. `setDutyTicks()` doesn't write, when the update of the
+ * double-buffered compare-match-registers is nearer than this.
+ */
+#define HALF_BRIDGE_PWM_UPDATE_CYCLES   40
+
+
+/*!
+ * \brief Complementary PWM-signals with dead-time on the pins OCnA and OCnB of a 16-bit-Timer/Counter.
+ *
+ * The duty-cycle is the part of the PWM-period, in which the upper transistor is on (OCnB low). The lower
+ * transistor is on in the rest of the period, minus two dead-times.
+ *
+ * The compare-match-registers are double-buffered: in phase-and-frequency-correct mode they are updated at BOTTOM,
+ * in phase-correct mode at TOP. `setDuty()` writes both registers with interrupts disabled, and only when this
+ * update is not imminent, so both new values take effect at the same update. A PWM-period never uses an old and a
+ * new value, the dead-time is kept in every period. So the duty-cycle can be changed at any rate, also from an
+ * interrupt-service-routine.
+ */
+class HalfBridgePwm
+{
+public:
+
+    /*!
+     * Constructor.
+     *
+     * \arg \c timer The Timer/Counter, for example `makeTimerCounter16BitObject( 1 )`. The object must exist as
+     *      long as the `HalfBridgePwm`-object.
+     */
+    HalfBridgePwm( TimerCounter16Bit& timer )
+        : m_timer( timer )
+        , m_mode( T16_PWM_PHI_F_CORRECT_ICRN )
+        , m_clockSource( T16_CLK_OFF )
+        , m_top( 0 )
+        , m_deadTicks( 0 )
+        , m_guardTicks( 0 )
+    { /*empty*/ }
+
+
+    /*!
+     * \brief Calculates the timer-settings and turns both transistors off.
+     *
+     * The Timer/Counter is stopped, and a compare-match is forced: OCnB is set high and OCnA low. After this method
+     * make the two pins outputs, and then call `start()`.
+     *
+     * \arg \c frequencyHz The PWM-frequency.
+     * \arg \c deadTimeNs The minimum dead-time in nanoseconds. It is rounded up to whole timer-ticks (62.5 ns at
+     *      16 MHz with prescaler 1), and is at least one tick.
+     * \arg \c mode `T16_PWM_PHI_F_CORRECT_ICRN` (default) or `T16_PWM_PHI_CORRECT_ICRN`.
+     *
+     * \returns 0 on success, or -1 if the mode is not supported, the frequency can't be reached, or the period is
+     *      too short for the dead-time (then the transistors are still turned off).
+     */
+    int8_t init( uint32_t frequencyHz, uint16_t deadTimeNs, Timer16_mode mode = T16_PWM_PHI_F_CORRECT_ICRN );
+
+
+    /*!
+     * \brief Starts the PWM-signals, beginning with both transistors off.
+     *
+     * \arg \c duty The first duty-cycle, see `setDuty()`.
+     */
+    void start( uint16_t duty );
+
+
+    /*!
+     * \brief Stops the Timer/Counter and turns both transistors off.
+     */
+    void stop();
+
+
+    /*!
+     * \brief Sets the duty-cycle as a fraction of the PWM-period.
+     *
+     * \arg \c duty 0 (lower transistor on, except the dead-times) to 65535 (upper transistor on). It is scaled to
+     *      `0 .. getMaxDutyTicks()`.
+     */
+    void setDuty( uint16_t duty );
+
+
+    /*!
+     * \brief Sets the duty-cycle in timer-ticks, this is the compare-match-value of OCRnB.
+     *
+     * \arg \c dutyTicks Values larger than `getMaxDutyTicks()` are clamped.
+     */
+    void setDutyTicks( uint16_t dutyTicks );
+
+
+    /*!
+     * Returns the TOP-value of the Timer/Counter. The PWM-period is `2 * TOP` timer-ticks.
+     */
+    uint16_t getTop() const
+    { return m_top; }
+
+
+    /*!
+     * Returns the dead-time in timer-ticks (the difference between OCRnA and OCRnB).
+     */
+    uint16_t getDeadTimeTicks() const
+    { return m_deadTicks; }
+
+
+    /*!
+     * Returns the largest duty-value in timer-ticks: `TOP - dead-time`. With this value the lower transistor is
+     * always off.
+     */
+    uint16_t getMaxDutyTicks() const
+    { return m_top - m_deadTicks; }
+
+
+private:
+
+    void turnOff();
+    uint16_t scaleDuty( uint16_t duty );
+
+    TimerCounter16Bit& m_timer;
+    Timer16_mode m_mode;
+    Timer16_ClockSource m_clockSource;
+    uint16_t m_top;
+    uint16_t m_deadTicks;
+    uint16_t m_guardTicks;  //distance in ticks to the update of the compare-match-registers, needed for writing
+};
+
+
+#endif
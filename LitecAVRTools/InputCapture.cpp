@@ -0,0 +1,425 @@
+/*
+    InputCapture.cpp - Measures frequency, period and duty-cycle of a signal
+    on the input-capture-pin of a 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "InputCapture.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == INPUT_CAPTURE_TIMER
+    #error "The InputCapture-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+
+
+
+// The interrupt-vectors of the timer selected with INPUT_CAPTURE_TIMER, for example TIMER1_CAPT_vect
+#define IC_CAPT_vect                litecAvrName3( TIMER, INPUT_CAPTURE_TIMER, _CAPT_vect )
+#define IC_OVF_vect                 litecAvrName3( TIMER, INPUT_CAPTURE_TIMER, _OVF_vect )
+
+#if INPUT_CAPTURE_PRESCALER == 1
+#define IC_CLOCK_SOURCE             T16_PRESC_1
+#elif INPUT_CAPTURE_PRESCALER == 8
+#define IC_CLOCK_SOURCE             T16_PRESC_8
+#elif INPUT_CAPTURE_PRESCALER == 64
+#define IC_CLOCK_SOURCE             T16_PRESC_64
+#elif INPUT_CAPTURE_PRESCALER == 256
+#define IC_CLOCK_SOURCE             T16_PRESC_256
+#else
+#define IC_CLOCK_SOURCE             T16_PRESC_1024
+#endif
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    // The registers are bound at compile-time. The bits have the same positions in all 16-bit-Timer/Counters,
+    // so the names of Timer/Counter1 are used (like in Timer16Bit.cpp).
+    typedef TimerCounter16< INPUT_CAPTURE_TIMER >       IcTimer;
+    typedef Timer16Registers< INPUT_CAPTURE_TIMER >     IcRegisters;
+
+    const uint8_t kBufferMask = INPUT_CAPTURE_BUFFER_SIZE - 1;
+
+
+    // Changed by the interrupt-service-routines
+
+    // Software-extension of the counter to 32 bits
+    volatile uint16_t           ic_overflow_count;
+
+    // Number of rising edges, and the timestamp of the last one
+    volatile uint32_t           ic_rising_count;
+    volatile uint32_t           ic_last_rising;
+
+    // Ring buffer of the captured edges. ic_break is set, when an edge had to be dropped, so the edges in the
+    // buffer are no longer consecutive.
+    InputCaptureEvent           ic_buffer[ INPUT_CAPTURE_BUFFER_SIZE ];
+    volatile uint8_t            ic_head;
+    volatile uint8_t            ic_tail;
+    volatile uint8_t            ic_lost;
+    volatile uint8_t            ic_break;
+
+    // Set by inputCaptureInit()
+    uint8_t                     ic_mode;
+
+
+    // Only used by the main program
+
+    // The rising edge, from which the next frequency-measurement starts
+    uint8_t                     ic_have_reference;
+    uint32_t                    ic_reference_count;
+    uint32_t                    ic_reference_time;
+
+    // The last rising and falling edge taken out of the ring buffer, and the sums of the high-times and periods
+    // for the duty-cycle
+    uint8_t                     ic_rising_valid;
+    uint8_t                     ic_falling_valid;
+    uint32_t                    ic_rising_time;
+    uint32_t                    ic_falling_time;
+    uint32_t                    ic_high_sum;
+    uint32_t                    ic_period_sum;
+    uint16_t                    ic_last_duty;
+
+
+    // Adds a complete period (rising edge, falling edge, next rising edge) to the sums for the duty-cycle
+    void accumulateDuty( uint32_t nextRising )
+    {
+        uint32_t period = nextRising - ic_rising_time;
+        uint32_t high = ic_falling_time - ic_rising_time;
+
+        // If a short pulse was missed, the falling edge belongs to a later period
+        if ( high >= period )
+        {
+            return;
+        }
+
+        // Stop adding before the sums overflow. The ratio of the sums is still the average duty-cycle.
+        if ( ic_period_sum + period < ic_period_sum )
+        {
+            return;
+        }
+
+        ic_period_sum += period;
+        ic_high_sum += high;
+    }
+};
+
+
+
+ISR( IC_CAPT_vect )
+{
+    uint16_t icr = IcRegisters::icrn();
+    uint16_t overflows = ic_overflow_count;
+
+    // The overflow-interrupt has a lower priority, so an overflow may not yet be counted. If the overflow-flag is
+    // set, and the captured value is small, the capture happened after the overflow. (A large captured value means,
+    // that the overflow happened after the capture, while this ISR was waiting to be executed.)
+    if ( ( IcRegisters::tifr() & _BV(TOV1) ) && ( icr < 0x8000 ) )
+    {
+        overflows++;
+    }
+
+    uint32_t timestamp = ( static_cast<uint32_t>( overflows ) << 16 ) | icr;
+    uint8_t rising = ( IcRegisters::tccrnb() >> ICES1 ) & 0x01;
+
+    if ( ic_mode == IC_PULSE_WIDTH )
+    {
+        // Capture the other edge next. The datasheet requires clearing the flag after changing the edge.
+        IcRegisters::tccrnb() ^= _BV(ICES1);
+        IcRegisters::tifr() = _BV(ICF1);
+    }
+
+    if ( rising )
+    {
+        ic_rising_count++;
+        ic_last_rising = timestamp;
+    }
+
+    if ( ic_mode == IC_FREQUENCY )
+    {
+        return;
+    }
+
+    uint8_t head = ic_head;
+    uint8_t next = ( head + 1 ) & kBufferMask;
+
+    if ( next == ic_tail )
+    {
+        // Buffer full: the newest edge is dropped
+        if ( ic_lost != 0xFF )
+        {
+            ic_lost++;
+        }
+        ic_break = 1;
+        return;
+    }
+
+    ic_buffer[ head ].timestamp = timestamp;
+    ic_buffer[ head ].rising = rising;
+    ic_head = next;
+}
+
+
+
+
+ISR( IC_OVF_vect )
+{
+    ic_overflow_count++;
+}
+
+
+
+
+void inputCaptureInit( InputCaptureMode mode )
+{
+    IcTimer::disableInterrupts( T16_INT_OVERFLOW | T16_INT_INPUT_CAPT );
+    IcTimer::selectClockSource( T16_CLK_OFF );
+
+    IcRegisters::tccrna() = 0;          // PWM-pins off
+    IcTimer::setMode( T16_NORMAL );
+    IcTimer::setInputCaptureNoiseCanceler( INPUT_CAPTURE_NOISE_CANCELER );
+    IcTimer::setInputCaptureEdge( T16_CAPTURE_RISING );
+    IcTimer::setActualCountValue( 0 );
+
+    ic_mode = mode;
+    ic_overflow_count = 0;
+    ic_rising_count = 0;
+    ic_last_rising = 0;
+    ic_head = 0;
+    ic_tail = 0;
+    ic_lost = 0;
+    ic_break = 0;
+
+    ic_have_reference = 0;
+    ic_rising_valid = 0;
+    ic_falling_valid = 0;
+    ic_high_sum = 0;
+    ic_period_sum = 0;
+    ic_last_duty = 0;
+
+    IcTimer::clearPendingInterruptEvents( T16_INT_OVERFLOW | T16_INT_INPUT_CAPT );
+    IcTimer::enableInterrupts( T16_INT_OVERFLOW | T16_INT_INPUT_CAPT );
+    IcTimer::selectClockSource( IC_CLOCK_SOURCE );
+}
+
+
+
+
+void inputCaptureStop()
+{
+    IcTimer::disableInterrupts( T16_INT_OVERFLOW | T16_INT_INPUT_CAPT );
+    IcTimer::selectClockSource( T16_CLK_OFF );
+}
+
+
+
+
+uint32_t inputCaptureNow()
+{
+    uint16_t m;
+    uint16_t t;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        m = ic_overflow_count;
+        t = IcRegisters::tcntn();
+
+        // Overflow not yet counted by the ISR (see the capture-ISR)
+        if ( ( IcRegisters::tifr() & _BV(TOV1) ) && ( t < 0x8000 ) )
+        {
+            m++;
+        }
+    }
+
+    return ( static_cast<uint32_t>( m ) << 16 ) | t;
+}
+
+
+
+
+uint32_t inputCaptureTicksSinceLastEdge()
+{
+    uint32_t count;
+    uint32_t lastRising;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        count = ic_rising_count;
+        lastRising = ic_last_rising;
+    }
+
+    if ( count == 0 )
+    {
+        return 0xFFFFFFFFUL;
+    }
+
+    return inputCaptureNow() - lastRising;
+}
+
+
+
+
+uint8_t inputCaptureReadEvent( InputCaptureEvent* event )
+{
+    uint8_t tail = ic_tail;
+
+    if ( tail == ic_head )
+    {
+        return 0;
+    }
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        *event = ic_buffer[ tail ];
+    }
+    ic_tail = ( tail + 1 ) & kBufferMask;
+
+    return 1;
+}
+
+
+
+
+uint8_t inputCaptureGetLostEvents()
+{
+    uint8_t lost;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        lost = ic_lost;
+        ic_lost = 0;
+    }
+
+    return lost;
+}
+
+
+
+
+void inputCaptureUpdate()
+{
+    uint8_t head;
+    uint8_t brokenAfterHead;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        // Edges are only dropped, when the buffer is full, so a gap can only follow the newest edge in the buffer
+        head = ic_head;
+        brokenAfterHead = ic_break;
+        ic_break = 0;
+    }
+
+    uint8_t tail = ic_tail;
+
+    while ( tail != head )
+    {
+        const InputCaptureEvent& event = ic_buffer[ tail ];
+
+        if ( event.rising )
+        {
+            if ( ic_rising_valid && ic_falling_valid )
+            {
+                accumulateDuty( event.timestamp );
+            }
+            ic_rising_time = event.timestamp;
+            ic_rising_valid = 1;
+            ic_falling_valid = 0;
+        }
+        else if ( ic_rising_valid )
+        {
+            ic_falling_time = event.timestamp;
+            ic_falling_valid = 1;
+        }
+
+        tail = ( tail + 1 ) & kBufferMask;
+        ic_tail = tail;
+    }
+
+    if ( brokenAfterHead )
+    {
+        ic_rising_valid = 0;
+        ic_falling_valid = 0;
+    }
+}
+
+
+
+
+int8_t inputCaptureGetMeasurement( InputCaptureMeasurement* measurement )
+{
+    uint32_t count;
+    uint32_t lastRising;
+
+    inputCaptureUpdate();
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        count = ic_rising_count;
+        lastRising = ic_last_rising;
+    }
+
+    if ( ! ic_have_reference )
+    {
+        // The first rising edge is the start of the first measurement
+        if ( count != 0 )
+        {
+            ic_reference_count = count;
+            ic_reference_time = lastRising;
+            ic_have_reference = 1;
+        }
+        return -1;
+    }
+
+    uint32_t periods = count - ic_reference_count;
+    uint32_t ticks = lastRising - ic_reference_time;
+
+    if ( periods == 0 || ticks == 0 )
+    {
+        return -1;
+    }
+
+    ic_reference_count = count;
+    ic_reference_time = lastRising;
+
+    measurement->frequencyMilliHz = static_cast<uint32_t>(
+            ( periods * ( INPUT_CAPTURE_TICKS_PER_SECOND * 1000ULL ) + ticks / 2 ) / ticks );
+    measurement->periodTicks = ( ticks + periods / 2 ) / periods;
+    measurement->periods = ( periods > 0xFFFF ) ? 0xFFFF : static_cast<uint16_t>( periods );
+
+    if ( ic_period_sum != 0 )
+    {
+        ic_last_duty = static_cast<uint16_t>(
+                ( static_cast<uint64_t>( ic_high_sum ) * 1000 + ic_period_sum / 2 ) / ic_period_sum );
+        ic_high_sum = 0;
+        ic_period_sum = 0;
+    }
+    measurement->dutyPerMille = ( ic_mode == IC_PULSE_WIDTH ) ? ic_last_duty : 0;
+
+    return 0;
+}
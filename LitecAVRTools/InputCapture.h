@@ -0,0 +1,242 @@
+/*
+    InputCapture.h - Measures frequency, period and duty-cycle of a signal
+    on the input-capture-pin of a 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to measure the frequency (and the duty-cycle) of a signal on the input-capture-pin
+ * ICPn of a 16-bit-Timer/Counter, for example of a tachometer or a flow-meter.
+ *
+ * To use these functions, include InputCapture.h in your source code and link against InputCapture.cpp and
+ * Timer16Bit.cpp.
+ *
+ * The Timer/Counter runs in normal mode. Its overflows are counted, so each edge on the ICPn-pin gets a 32-bit
+ * timestamp. The interrupt-service-routine writes the timestamps into a ring buffer and counts the rising edges.
+ * Frequency and duty-cycle are calculated in the main program by `inputCaptureGetMeasurement()`, with integer
+ * arithmetic only.
+ *
+ * \note Linking against InputCapture.cpp installs the input-capture- and the overflow-interrupt of the Timer/Counter
+ * selected with `INPUT_CAPTURE_TIMER`. Don't use this Timer/Counter for other purposes. Its counter-register can
+ * still be read, for example as timestamp for the EventTrace- or IsrProfiler-modules.
+ */
+
+
+
+#ifndef InputCapture_h
+#define InputCapture_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * The 16-bit-Timer/Counter used for the measurement: 1 (default), or 3, 4, 5 on the ATmega2560. The signal must be
+ * connected to the input-capture-pin of this Timer/Counter: ICP1 is PB0 on the ATmega328p and PD4 on the
+ * ATmega2560, ICP3 is PE7, ICP4 is PL0 and ICP5 is PL1. The pin must be configured as input (this is the state
+ * after reset).
+ */
+#ifndef INPUT_CAPTURE_TIMER
+#define INPUT_CAPTURE_TIMER             1
+#endif
+
+#if INPUT_CAPTURE_TIMER != 1 && INPUT_CAPTURE_TIMER != 3 && INPUT_CAPTURE_TIMER != 4 && INPUT_CAPTURE_TIMER != 5
+    #error "INPUT_CAPTURE_TIMER must be 1, 3, 4 or 5"
+#endif
+
+
+/*!
+ * The prescaler of the Timer/Counter: 1 (default), 8, 64, 256 or 1024. With prescaler 1 the timestamps have a
+ * resolution of one clock-cycle, and periods up to 2^32 clock-cycles (268 seconds at 16 MHz) can be measured.
+ */
+#ifndef INPUT_CAPTURE_PRESCALER
+#define INPUT_CAPTURE_PRESCALER         1
+#endif
+
+#if INPUT_CAPTURE_PRESCALER != 1 && INPUT_CAPTURE_PRESCALER != 8 && INPUT_CAPTURE_PRESCALER != 64 \
+        && INPUT_CAPTURE_PRESCALER != 256 && INPUT_CAPTURE_PRESCALER != 1024
+    #error "INPUT_CAPTURE_PRESCALER must be 1, 8, 64, 256 or 1024"
+#endif
+
+
+/*!
+ * Number of timestamps in the ring buffer. Must be a power of two between 2 and 128. Each timestamp needs 5 bytes of
+ * RAM. One entry is always kept free.
+ */
+#ifndef INPUT_CAPTURE_BUFFER_SIZE
+#define INPUT_CAPTURE_BUFFER_SIZE       16
+#endif
+
+#if INPUT_CAPTURE_BUFFER_SIZE < 2 || INPUT_CAPTURE_BUFFER_SIZE > 128 \
+        || ( INPUT_CAPTURE_BUFFER_SIZE & ( INPUT_CAPTURE_BUFFER_SIZE - 1 ) ) != 0
+    #error "INPUT_CAPTURE_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+
+
+/*!
+ * If non-zero, the noise-canceler of the input-capture-pin is turned on: the level on the pin must be stable for
+ * four clock-cycles, before an edge is detected.
+ */
+#ifndef INPUT_CAPTURE_NOISE_CANCELER
+#define INPUT_CAPTURE_NOISE_CANCELER    0
+#endif
+
+
+/*!
+ * Number of timer-ticks per second.
+ */
+#define INPUT_CAPTURE_TICKS_PER_SECOND  ( F_CPU / INPUT_CAPTURE_PRESCALER )
+
+
+/*!
+ * What is measured.
+ */
+enum InputCaptureMode
+{
+    IC_PERIOD =             0,      //!< Rising edges are captured: frequency, period and the single timestamps
+    IC_PULSE_WIDTH =        1,      //!< Rising and falling edges are captured: also the duty-cycle
+    IC_FREQUENCY =          2       //!< Rising edges are only counted, not written into the ring buffer: fastest
+};
+
+
+/*!
+ * One captured edge.
+ */
+struct InputCaptureEvent
+{
+    uint32_t timestamp;     //!< Time of the edge in timer-ticks
+    uint8_t rising;         //!< 1 for a rising edge, 0 for a falling edge
+};
+
+
+/*!
+ * The result of a measurement.
+ */
+struct InputCaptureMeasurement
+{
+    uint32_t frequencyMilliHz;  //!< Average frequency in 1/1000 Hz
+    uint32_t periodTicks;       //!< Average period in timer-ticks
+    uint16_t dutyPerMille;      //!< Average duty-cycle in 1/10 percent (only in mode IC_PULSE_WIDTH, else 0)
+    uint16_t periods;           //!< Number of periods, over which was averaged (at most 65535)
+};
+
+
+/*!
+ * \brief Initializes the Timer/Counter and starts the measurement.
+ *
+ * The Timer/Counter is set to normal mode with the prescaler `INPUT_CAPTURE_PRESCALER`, and its input-capture- and
+ * overflow-interrupts are enabled. Interrupts must be globally enabled.
+ *
+ * The input-capture-interrupt must be executed within 32768 timer-ticks after the edge (2 milliseconds with
+ * prescaler 1 at 16 MHz), otherwise the overflow-counting can't decide, if the edge was before or after an
+ * overflow. So don't disable interrupts for a longer time.
+ *
+ * \arg \c mode `IC_PERIOD` to measure frequency and period, `IC_PULSE_WIDTH` to measure also the duty-cycle,
+ *      `IC_FREQUENCY` for the highest frequencies (no timestamps in the ring buffer). In mode `IC_PULSE_WIDTH` the
+ *      edge that triggers the input-capture is changed after each capture, so there are twice as many interrupts,
+ *      and the high- and the low-phase of the signal must each be longer than the time until the
+ *      interrupt-service-routine has changed the edge (about 3 microseconds at 16 MHz).
+ */
+
+void inputCaptureInit( InputCaptureMode mode );
+
+
+/*!
+ * \brief Stops the Timer/Counter and disables its interrupts.
+ */
+
+void inputCaptureStop();
+
+
+/*!
+ * \brief Returns the actual time in timer-ticks, on the same time-scale as the timestamps of the captured edges.
+ */
+
+uint32_t inputCaptureNow();
+
+
+/*!
+ * \brief Returns the number of timer-ticks since the last rising edge, or 0xFFFFFFFF if there was none yet.
+ *
+ * Use this function to detect a stopped signal (for example a standing motor): no new measurement is available
+ * then, and the time since the last edge keeps growing. It must not grow beyond 2^32 ticks (268 seconds with
+ * prescaler 1 at 16 MHz), so call it regularly.
+ */
+
+uint32_t inputCaptureTicksSinceLastEdge();
+
+
+/*!
+ * \brief Takes the oldest captured edge out of the ring buffer.
+ *
+ * Use this function only, if you need the timestamps of the single edges. `inputCaptureGetMeasurement()` also
+ * takes the edges out of the buffer, so don't use both functions for the duty-cycle.
+ *
+ * \arg \c event The edge is written to this struct.
+ *
+ * \returns 1 if an edge was available, 0 if the buffer was empty.
+ */
+
+uint8_t inputCaptureReadEvent( InputCaptureEvent* event );
+
+
+/*!
+ * \brief Returns the number of edges, that could not be written into the full ring buffer, since the last call
+ * (at most 255).
+ *
+ * Lost edges don't affect the frequency, which is calculated from the number of rising edges. Only the duty-cycle
+ * is averaged over fewer periods.
+ */
+
+uint8_t inputCaptureGetLostEvents();
+
+
+/*!
+ * \brief Takes the captured edges out of the ring buffer and accumulates the high-times for the duty-cycle.
+ *
+ * Only needed in mode `IC_PULSE_WIDTH`, if `inputCaptureGetMeasurement()` is called so seldom, that the ring
+ * buffer would overflow (`INPUT_CAPTURE_BUFFER_SIZE - 1` edges). Call it then more often in the main loop.
+ */
+
+void inputCaptureUpdate();
+
+
+/*!
+ * \brief Calculates the average frequency, period and duty-cycle since the last call.
+ *
+ * The frequency is calculated from the number of rising edges and the time between the first and the last of
+ * them, so it is averaged over all periods since the last call: the longer the time between two calls, the
+ * higher the resolution (one timer-tick per measuring time). The calculation uses integer arithmetic only
+ * (64 bits for the frequency and the duty-cycle).
+ *
+ * \arg \c measurement The result is written to this struct.
+ *
+ * \returns 0 if a new measurement is available, or -1 if there was no complete period since the last call (then
+ *      `measurement` is not changed).
+ */
+
+int8_t inputCaptureGetMeasurement( InputCaptureMeasurement* measurement );
+
+
+#endif
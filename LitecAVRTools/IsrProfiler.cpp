@@ -0,0 +1,189 @@
+/*
+    IsrProfiler.cpp - Measures the execution time of interrupt-service-routines
+    and the idle-time of the main program.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "IsrProfiler.h"
+
+#if ISR_PROFILER_ENABLED
+
+#include <util/atomic.h>
+
+#include "SystemClock.h"
+#include "Usart.h"
+
+
+
+IsrProfilerSlot _isrProfilerSlots[ ISR_PROFILER_SLOTS ];
+
+
+
+namespace
+{
+    // Number of iterations of the busy loop in isrProfilerIdle()
+    const uint8_t kIdleLoopIterations = 64;
+
+    // Ticks needed by PROFILE_ISR_ENTER and PROFILE_ISR_EXIT themselves, measured by isrProfilerInit()
+    uint16_t measurementTicks;
+
+    // Clock-cycles of one call of isrProfilerIdle() without interrupts, measured by isrProfilerInit()
+    uint16_t idleCallCycles;
+
+    // Number of calls of isrProfilerIdle() in the actual measurement-period. Only used by the main program.
+    uint32_t idleCalls;
+
+    // micros() at the beginning of the actual measurement-period
+    unsigned long periodStart;
+
+
+    // Number of clock-cycles, that are one 1/1000 of the actual measurement-period
+    uint32_t cyclesPerMille()
+    {
+        uint32_t periodMs = ( micros() - periodStart ) / 1000;
+        uint32_t cycles = ( periodMs * ( F_CPU / 1000 ) ) / 1000;
+        return ( cycles == 0 ) ? 1 : cycles;
+    }
+};
+
+
+
+
+void isrProfilerInit()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        // The same code as used by the macros, without anything in between
+        {
+            PROFILE_ISR_ENTER( 0 );
+            measurementTicks = static_cast<uint16_t>( ISR_PROFILER_TIMESTAMP - _isrProfilerEntry );
+        }
+
+        uint16_t start = ISR_PROFILER_TIMESTAMP;
+        isrProfilerIdle();
+        uint16_t ticks = static_cast<uint16_t>( ISR_PROFILER_TIMESTAMP - start ) - measurementTicks;
+        idleCallCycles = ticks * ISR_PROFILER_CYCLES_PER_TICK;
+    }
+
+    isrProfilerReset();
+}
+
+
+
+
+void isrProfilerReset()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        for ( uint8_t i = 0; i < ISR_PROFILER_SLOTS; i++ )
+        {
+            _isrProfilerSlots[i].count = 0;
+            _isrProfilerSlots[i].totalTicks = 0;
+            _isrProfilerSlots[i].minTicks = 0xFFFF;
+            _isrProfilerSlots[i].maxTicks = 0;
+        }
+    }
+
+    idleCalls = 0;
+    periodStart = micros();
+}
+
+
+
+
+void __attribute__((noinline)) isrProfilerIdle()
+{
+    // A busy loop with fixed length, so its duration without interrupts is known
+    for ( uint8_t i = kIdleLoopIterations; i != 0; i-- )
+    {
+        __asm__ __volatile__ ( "nop" );
+    }
+
+    idleCalls++;
+}
+
+
+
+
+void isrProfilerGetSlot( uint8_t slot, IsrProfilerSlot* result )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        *result = _isrProfilerSlots[ slot ];
+    }
+
+    // Remove the time needed for the measurement
+    if ( result->count == 0 )
+    {
+        return;
+    }
+    result->totalTicks -= result->count * measurementTicks;
+    result->minTicks = ( result->minTicks > measurementTicks ) ? result->minTicks - measurementTicks : 0;
+    result->maxTicks = ( result->maxTicks > measurementTicks ) ? result->maxTicks - measurementTicks : 0;
+}
+
+
+
+
+uint16_t isrProfilerGetIdlePerMille()
+{
+    uint32_t perMille = ( idleCalls * idleCallCycles ) / cyclesPerMille();
+
+    return ( perMille > 1000 ) ? 1000 : static_cast<uint16_t>( perMille );
+}
+
+
+
+
+void isrProfilerReport( Usart& usart, const char* const* names )
+{
+    uint32_t perMilleCycles = cyclesPerMille();
+
+    usart.usartPrintf( "ISR-profile over %lu ms (times in clock-cycles):\r\n",
+                       ( micros() - periodStart ) / 1000 );
+    usart.usartPrintf( "slot name            count      avg    min    max   load\r\n" );
+
+    for ( uint8_t i = 0; i < ISR_PROFILER_SLOTS; i++ )
+    {
+        IsrProfilerSlot s;
+        isrProfilerGetSlot( i, &s );
+
+        if ( s.count == 0 )
+        {
+            continue;
+        }
+
+        uint32_t totalCycles = s.totalTicks * ISR_PROFILER_CYCLES_PER_TICK;
+        uint16_t load = totalCycles / perMilleCycles;
+
+        usart.usartPrintf( "%4u %-12s %8lu %8lu %6lu %6lu %3u.%u%%\r\n",
+                           i, names ? names[i] : "",
+                           s.count, totalCycles / s.count,
+                           static_cast<uint32_t>( s.minTicks ) * ISR_PROFILER_CYCLES_PER_TICK,
+                           static_cast<uint32_t>( s.maxTicks ) * ISR_PROFILER_CYCLES_PER_TICK,
+                           load / 10, load % 10 );
+    }
+
+    uint16_t idle = isrProfilerGetIdlePerMille();
+    usart.usartPrintf( "idle: %u.%u%%\r\n", idle / 10, idle % 10 );
+}
+
+#endif
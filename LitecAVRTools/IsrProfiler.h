@@ -0,0 +1,219 @@
+/*
+    IsrProfiler.h - Measures the execution time of interrupt-service-routines
+    and the idle-time of the main program.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to measure, how many clock-cycles interrupt-service-routines need, and how much time
+ * the main program is idle.
+ *
+ * To use the profiler, define `ISR_PROFILER_ENABLED` as 1 (for example with the compiler-option
+ * `-DISR_PROFILER_ENABLED=1`), include IsrProfiler.h in your source code and link against IsrProfiler.cpp,
+ * SystemClock.cpp and Usart.cpp.
+ *
+ * Put `PROFILE_ISR_ENTER( slot )` at the beginning and `PROFILE_ISR_EXIT( slot )` at the end of each ISR to
+ * measure. Each ISR uses its own slot (0 .. ISR_PROFILER_SLOTS-1). If `ISR_PROFILER_ENABLED` is 0, these macros are
+ * empty, and all functions of the module are empty inline functions, so the instrumentation disappears completely.
+ */
+
+
+
+#ifndef IsrProfiler_h
+#define IsrProfiler_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * With this macro the profiler is turned on (non-zero value) or off (0). If it is turned off, no code is generated
+ * for the instrumentation and for the functions of this module.
+ */
+#ifndef ISR_PROFILER_ENABLED
+#define ISR_PROFILER_ENABLED        0
+#endif
+
+
+/*!
+ * Number of ISRs, that can be measured.
+ */
+#ifndef ISR_PROFILER_SLOTS
+#define ISR_PROFILER_SLOTS          4
+#endif
+
+
+/*!
+ * The free-running 16-bit-register, that is read at the entry and exit of an ISR. The default is the
+ * counter-register of Timer/Counter1, which must be started by the user in normal mode. The execution-time of an
+ * ISR must be shorter than 65536 ticks of this counter.
+ */
+#ifndef ISR_PROFILER_TIMESTAMP
+#define ISR_PROFILER_TIMESTAMP      TCNT1
+#endif
+
+
+/*!
+ * Number of clock-cycles per tick of `ISR_PROFILER_TIMESTAMP`. This is the prescaler of the timer (1 is
+ * recommended).
+ */
+#ifndef ISR_PROFILER_CYCLES_PER_TICK
+#define ISR_PROFILER_CYCLES_PER_TICK    1
+#endif
+
+
+/*!
+ * The measured values of one ISR. All times are in timer-ticks, without the time needed for the measurement.
+ */
+struct IsrProfilerSlot
+{
+    uint32_t count;         //!< Number of executions of the ISR
+    uint32_t totalTicks;    //!< Sum of the execution-times
+    uint16_t minTicks;      //!< Shortest execution-time (0xFFFF, if count is 0)
+    uint16_t maxTicks;      //!< Longest execution-time
+};
+
+
+class Usart;
+
+
+#if ISR_PROFILER_ENABLED
+
+// private variables and function, only used by the PROFILE_ISR-macros and IsrProfiler.cpp
+extern IsrProfilerSlot _isrProfilerSlots[ ISR_PROFILER_SLOTS ];
+
+inline void _isrProfilerRecord( uint8_t slot, uint16_t ticks ) __attribute__((always_inline));
+inline void _isrProfilerRecord( uint8_t slot, uint16_t ticks )
+{
+    IsrProfilerSlot& s = _isrProfilerSlots[ slot ];
+
+    s.count++;
+    s.totalTicks += ticks;
+    if ( ticks < s.minTicks )
+    {
+        s.minTicks = ticks;
+    }
+    if ( ticks > s.maxTicks )
+    {
+        s.maxTicks = ticks;
+    }
+}
+
+
+/*!
+ * Put this macro at the beginning of an ISR to measure.
+ *
+ * \arg \c slot The number of the slot for this ISR (0 .. ISR_PROFILER_SLOTS-1)
+ */
+#define PROFILE_ISR_ENTER( slot )   uint16_t _isrProfilerEntry = ISR_PROFILER_TIMESTAMP
+
+/*!
+ * Put this macro at the end of an ISR to measure. Don't use it in an ISR declared with `ISR_NOBLOCK`.
+ *
+ * \arg \c slot The number of the slot for this ISR, the same as in `PROFILE_ISR_ENTER`.
+ */
+#define PROFILE_ISR_EXIT( slot )    _isrProfilerRecord( (slot), \
+                                        static_cast<uint16_t>( ISR_PROFILER_TIMESTAMP - _isrProfilerEntry ) )
+
+
+/*!
+ * \brief Initializes the profiler.
+ *
+ * Measures the time needed for the measurement itself, and the duration of one call of `isrProfilerIdle()`
+ * (with interrupts disabled). Then all measured values are reset. The timer used for `ISR_PROFILER_TIMESTAMP` must
+ * already run, and the system clock must be initialized.
+ */
+
+void isrProfilerInit();
+
+
+/*!
+ * \brief Resets all measured values and starts a new measurement-period.
+ *
+ * A measurement-period must not be longer than 2^32 clock-cycles (268 seconds at 16 MHz).
+ */
+
+void isrProfilerReset();
+
+
+/*!
+ * \brief Call this function in the main loop, whenever there is nothing to do.
+ *
+ * It executes a busy loop of fixed length and counts the calls. Interrupts happening during the loop make it
+ * longer. Comparing the number of calls with the duration measured by `isrProfilerInit()` gives the idle-time.
+ * Time spent in the main loop outside this function is not counted as idle-time.
+ */
+
+void isrProfilerIdle();
+
+
+/*!
+ * \brief Copies the measured values of one slot consistently.
+ *
+ * \arg \c slot The number of the slot.
+ * \arg \c result The values are written to this struct.
+ */
+
+void isrProfilerGetSlot( uint8_t slot, IsrProfilerSlot* result );
+
+
+/*!
+ * \brief Returns the idle-time of the main program since the last reset, in 1/10 percent (0..1000).
+ */
+
+uint16_t isrProfilerGetIdlePerMille();
+
+
+/*!
+ * \brief Prints a table with the measured values of all used slots and the idle-time over a USART.
+ *
+ * For each slot the number of executions, the average, minimum and maximum execution time in clock-cycles, and
+ * the CPU-load in percent are printed. This function uses blocking output, so don't call it too often.
+ *
+ * \arg \c usart The initialized `Usart`-object used for the output.
+ * \arg \c names An array of ISR_PROFILER_SLOTS names of the slots, or NULL.
+ */
+
+void isrProfilerReport( Usart& usart, const char* const* names = 0 );
+
+
+#else
+
+
+#define PROFILE_ISR_ENTER( slot )
+#define PROFILE_ISR_EXIT( slot )
+
+inline void isrProfilerInit() {}
+inline void isrProfilerReset() {}
+inline void isrProfilerIdle() {}
+inline void isrProfilerGetSlot( uint8_t, IsrProfilerSlot* result )
+{ result->count = 0; result->totalTicks = 0; result->minTicks = 0xFFFF; result->maxTicks = 0; }
+inline uint16_t isrProfilerGetIdlePerMille() { return 0; }
+inline void isrProfilerReport( Usart&, const char* const* = 0 ) {}
+
+
+#endif
+
+
+#endif
@@ -0,0 +1,373 @@
+/*
+    PulseCounter.cpp - Counts pulses on an external Interrupt and measures
+    their frequency with a gate-time or reciprocally.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "PulseCounter.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "ExternalInterrupts.h"
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == PULSE_COUNTER_GATE_TIMER
+    #error "The PulseCounter-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+
+#if PULSE_COUNTER_INT >= EXT_INT_COUNT
+    #error "PULSE_COUNTER_INT doesn't exist on this microcontroller"
+#endif
+
+#if ! PULSE_COUNTER_RECIPROCAL && ! defined( GPIOR2 )
+    #error "This microcontroller has no GPIOR1 and GPIOR2. Use -DPULSE_COUNTER_RECIPROCAL=1."
+#endif
+
+
+
+// The interrupt-vectors, for example INT0_vect and TIMER1_COMPA_vect
+#define PC_INT_vect                 litecAvrName3( INT, PULSE_COUNTER_INT, _vect )
+#define PC_GATE_vect                litecAvrName3( TIMER, PULSE_COUNTER_GATE_TIMER, _COMPA_vect )
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    typedef TimerCounter16< PULSE_COUNTER_GATE_TIMER >      PcTimer;
+    typedef Timer16Registers< PULSE_COUNTER_GATE_TIMER >    PcRegisters;
+
+    // Prescaler and TOP-value of the gate-timer, calculated at compile-time. The frequency is calculated with the
+    // achieved period, so a rounded TOP-value gives no error.
+    constexpr Timer16_Frequency kGate = timer16FrequencyFromMicros( PULSE_COUNTER_GATE_MS * 1000UL, T16_CTC_OCRNA );
+    static_assert( kGate.clockSource != T16_CLK_OFF, "PULSE_COUNTER_GATE_MS is too long for this F_CPU" );
+
+    // Snapshots of the gate-interrupt: the 16-bit-counter at the end of the last gate-time, the pulses in the last
+    // gate-time, and the total up to the end of the last gate-time.
+    uint16_t                    pc_last_raw;
+    volatile uint16_t           pc_gate_count;
+    volatile uint8_t            pc_gate_ready;
+    volatile uint32_t           pc_total;
+
+
+#if PULSE_COUNTER_RECIPROCAL
+
+    const uint32_t kTicksPerGate = kGate.top + 1UL;
+    const uint32_t kTicksPerSecond = F_CPU >> _t16Shift( T16_CTC_OCRNA, kGate.clockSource );
+    const uint32_t kTimeoutTicks = static_cast<uint32_t>(
+                                        static_cast<uint64_t>( kTicksPerSecond ) * PULSE_COUNTER_TIMEOUT_MS / 1000 );
+
+    // The 16-bit-counter, changed by the interrupt-service-routine
+    volatile uint16_t           pc_raw;
+
+    // The time in gate-timer-ticks: at the start of the running gate-time, and at the last pulse
+    volatile uint32_t           pc_gate_start;
+    volatile uint32_t           pc_pulse_time;
+
+    // Only used by pulseCounterGetFrequencyMilliHz(): the total and the time of the last pulse before the last call
+    uint8_t                     freq_valid;
+    uint32_t                    freq_total;
+    uint32_t                    freq_time;
+    uint32_t                    freq_milliHz;
+
+
+    inline uint16_t readRawCount() __attribute__((always_inline));
+    inline uint16_t readRawCount()
+    {
+        return pc_raw;
+    }
+
+    inline void clearRawCount()
+    {
+        pc_raw = 0;
+    }
+
+    // Returns the time in gate-timer-ticks. Must be called with interrupts disabled.
+    inline uint32_t readTime() __attribute__((always_inline));
+    inline uint32_t readTime()
+    {
+        uint16_t ticks = PcRegisters::tcntn();
+        uint32_t time = pc_gate_start + ticks;
+
+        // If the gate-time has just ended, and the interrupt-service-routine has not been executed yet, the
+        // compare-match-flag is set and the count-value is small.
+        if ( ( PcRegisters::tifr() & _BV(OCF1A) ) && ( ticks < kTicksPerGate / 2 ) )
+        {
+            time += kTicksPerGate;
+        }
+        return time;
+    }
+
+#else
+
+    // The 16-bit-counter is in GPIOR1 (low byte) and GPIOR2 (high byte), they can be read and written with in and
+    // out (one cycle each) instead of lds and sts. Must be called with interrupts disabled.
+    inline uint16_t readRawCount() __attribute__((always_inline));
+    inline uint16_t readRawCount()
+    {
+        return GPIOR1 | ( static_cast<uint16_t>( GPIOR2 ) << 8 );
+    }
+
+    inline void clearRawCount()
+    {
+        GPIOR1 = 0;
+        GPIOR2 = 0;
+    }
+
+#endif
+};
+
+
+
+#if PULSE_COUNTER_RECIPROCAL
+
+ISR( PC_INT_vect )
+{
+    pc_pulse_time = readTime();
+    pc_raw++;
+}
+
+#else
+
+// Only increments the 16-bit-counter in GPIOR1 and GPIOR2. avr-gcc would save and clear r1 and push SREG (33
+// cycles), the assembler-version keeps SREG in r0: 24 cycles from the first instruction to reti, plus 7 cycles
+// for the interrupt-response and the jump in the vector-table.
+ISR( PC_INT_vect, ISR_NAKED )
+{
+    __asm__ __volatile__
+    (
+        "push r0"                   "\n\t"  // 2 cycles
+        "in r0, __SREG__"           "\n\t"  // 1
+        "push r24"                  "\n\t"  // 2
+        "push r25"                  "\n\t"  // 2
+        "in r24, %[low]"            "\n\t"  // 1
+        "in r25, %[high]"           "\n\t"  // 1
+        "adiw r24, 1"               "\n\t"  // 2
+        "out %[high], r25"          "\n\t"  // 1
+        "out %[low], r24"           "\n\t"  // 1
+        "pop r25"                   "\n\t"  // 2
+        "pop r24"                   "\n\t"  // 2
+        "out __SREG__, r0"          "\n\t"  // 1
+        "pop r0"                    "\n\t"  // 2
+        "reti"                              // 4
+        :
+        : [low] "I" ( _SFR_IO_ADDR( GPIOR1 ) ), [high] "I" ( _SFR_IO_ADDR( GPIOR2 ) )
+    );
+}
+
+#endif
+
+
+// The end of a gate-time. The 16-bit-counter can't change here (interrupts are disabled).
+ISR( PC_GATE_vect )
+{
+    uint16_t raw = readRawCount();
+    uint16_t pulses = raw - pc_last_raw;
+
+    pc_last_raw = raw;
+    pc_gate_count = pulses;
+    pc_gate_ready = 1;
+    pc_total += pulses;
+
+#if PULSE_COUNTER_RECIPROCAL
+    pc_gate_start += kTicksPerGate;
+#endif
+}
+
+
+
+
+int8_t pulseCounterInit( uint8_t extIntEventType )
+{
+    if ( extIntEventType == EXTINT_LOW_LEVEL_ACTIVE )
+    {
+        return -1;
+    }
+
+    ExtInt extInt( PULSE_COUNTER_INT, extIntEventType );
+    extInt.disable();
+
+    PcTimer::disableInterrupts( T16_INT_COMP_MATCH_A );
+    PcTimer::selectClockSource( T16_CLK_OFF );
+    PcRegisters::tccrna() = 0;          // PWM-pins off
+    PcTimer::setActualCountValue( 0 );
+
+    clearRawCount();
+    pc_last_raw = 0;
+    pc_gate_count = 0;
+    pc_gate_ready = 0;
+    pc_total = 0;
+
+#if PULSE_COUNTER_RECIPROCAL
+    pc_gate_start = 0;
+    pc_pulse_time = 0;
+    freq_valid = 0;
+    freq_milliHz = 0;
+#endif
+
+    PcTimer::clearPendingInterruptEvents( T16_INT_COMP_MATCH_A );
+    PcTimer::enableInterrupts( T16_INT_COMP_MATCH_A );
+
+    extInt.clearPendingEvent();
+    extInt.enable();
+
+    // Sets the mode and the TOP-value, and starts the gate-timer
+    PcTimer::setFrequency( kGate );
+    return 0;
+}
+
+
+
+
+void pulseCounterStop()
+{
+    disableExtInt( PULSE_COUNTER_INT );
+    PcTimer::selectClockSource( T16_CLK_OFF );
+    PcTimer::disableInterrupts( T16_INT_COMP_MATCH_A );
+}
+
+
+
+
+uint32_t pulseCounterGetTotal()
+{
+    uint32_t total;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        // The pulses of the running gate-time are not yet in pc_total
+        total = pc_total + static_cast<uint16_t>( readRawCount() - pc_last_raw );
+    }
+
+    return total;
+}
+
+
+
+
+void pulseCounterClearTotal()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        // pc_last_raw stays unchanged, so the count of the running gate-time stays correct
+        pc_total = -static_cast<uint32_t>( static_cast<uint16_t>( readRawCount() - pc_last_raw ) );
+    }
+
+#if PULSE_COUNTER_RECIPROCAL
+    // The next call of pulseCounterGetFrequencyMilliHz() starts a new measurement
+    freq_valid = 0;
+#endif
+}
+
+
+
+
+uint8_t pulseCounterGetGateCount( uint16_t* count )
+{
+    uint8_t ready;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        *count = pc_gate_count;
+        ready = pc_gate_ready;
+        pc_gate_ready = 0;
+    }
+
+    return ready;
+}
+
+
+
+
+#if PULSE_COUNTER_RECIPROCAL
+
+uint32_t pulseCounterGetFrequencyMilliHz()
+{
+    uint32_t total;
+    uint32_t pulseTime;
+    uint32_t now;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        total = pc_total + static_cast<uint16_t>( readRawCount() - pc_last_raw );
+        pulseTime = pc_pulse_time;
+        now = readTime();
+    }
+
+    uint32_t pulses = total - freq_total;
+
+    if ( pulses != 0 )
+    {
+        uint32_t ticks = pulseTime - freq_time;
+
+        if ( freq_valid && ticks != 0 )
+        {
+            freq_milliHz = static_cast<uint32_t>(
+                ( static_cast<uint64_t>( pulses ) * kTicksPerSecond * 1000 + ticks / 2 ) / ticks );
+        }
+
+        freq_valid = 1;
+        freq_total = total;
+        freq_time = pulseTime;
+        return freq_milliHz;
+    }
+
+    // No pulse since the last call: the period is at least the time since the last pulse
+    uint32_t sinceLastPulse = now - freq_time;
+
+    if ( ! freq_valid || sinceLastPulse >= kTimeoutTicks )
+    {
+        // The next pulse starts a new measurement
+        freq_valid = 0;
+        freq_milliHz = 0;
+        return 0;
+    }
+
+    uint32_t limit = static_cast<uint32_t>(
+        static_cast<uint64_t>( kTicksPerSecond ) * 1000 / ( sinceLastPulse + 1 ) );
+    if ( freq_milliHz > limit )
+    {
+        freq_milliHz = limit;
+    }
+    return freq_milliHz;
+}
+
+#else
+
+uint32_t pulseCounterGetFrequencyMilliHz()
+{
+    uint16_t count;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        count = pc_gate_count;
+    }
+
+    return static_cast<uint32_t>(
+        ( static_cast<uint64_t>( count ) * F_CPU * 1000 + kGate.periodCycles / 2 ) / kGate.periodCycles );
+}
+
+#endif
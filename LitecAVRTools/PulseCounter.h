@@ -0,0 +1,181 @@
+/*
+    PulseCounter.h - Counts pulses on an external Interrupt and measures
+    their frequency with a gate-time or reciprocally.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to count pulses (for example of a flow-sensor) on the pin of an external Interrupt, and
+ * to measure their frequency.
+ *
+ * To use these functions, include PulseCounter.h in your source code and link against PulseCounter.cpp,
+ * ExternalInterrupts.cpp and Timer16Bit.cpp.
+ *
+ * The interrupt-service-routine of the external Interrupt `PULSE_COUNTER_INT` only increments a 16-bit-counter. By
+ * default this counter is kept in the general-purpose-I/O-registers GPIOR1 (low byte) and GPIOR2 (high byte), and
+ * the interrupt-service-routine is written in assembler: it needs 31 clock-cycles per pulse, including the
+ * interrupt-response.
+ *
+ * The Timer/Counter `PULSE_COUNTER_GATE_TIMER` runs in CTC-mode with the period `PULSE_COUNTER_GATE_MS` (the
+ * gate-time). Its compare-match-interrupt takes a snapshot of the 16-bit-counter at the end of each gate-time: the
+ * difference to the last snapshot is the number of pulses in this gate-time, and it is added to a 32-bit total.
+ * So the 16-bit-counter is extended lazily, once per gate-time, and not in each pulse.
+ *
+ * With `PULSE_COUNTER_RECIPROCAL` the interrupt-service-routine also stores the time of each pulse, and the
+ * frequency is calculated from the number of pulses and the time between the first and the last of them. This is
+ * exact for low frequencies, where a gate-time contains only a few pulses.
+ *
+ * \note Linking against PulseCounter.cpp installs the interrupt-service-routine of the external Interrupt
+ * `PULSE_COUNTER_INT` and the compare-match-interrupt A of the Timer/Counter `PULSE_COUNTER_GATE_TIMER`. Don't use
+ * them for other purposes. Without `PULSE_COUNTER_RECIPROCAL`, GPIOR1 and GPIOR2 are used by this module. If
+ * ExternalInterruptsDispatch.cpp is linked too, clear the bit of `PULSE_COUNTER_INT` in `EXTINT_DISPATCH_MASK`.
+ */
+
+
+
+#ifndef PulseCounter_h
+#define PulseCounter_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * The external Interrupt, whose pin is the input of the pulses (default 0: pin PD2 on the ATmega328p, PD0 on the
+ * ATmega2560).
+ */
+#ifndef PULSE_COUNTER_INT
+#define PULSE_COUNTER_INT               0
+#endif
+
+
+/*!
+ * The 16-bit-Timer/Counter, that defines the gate-time: 1 (default), or 3, 4, 5 on the ATmega2560.
+ */
+#ifndef PULSE_COUNTER_GATE_TIMER
+#define PULSE_COUNTER_GATE_TIMER        1
+#endif
+
+#if PULSE_COUNTER_GATE_TIMER != 1 && PULSE_COUNTER_GATE_TIMER != 3 && PULSE_COUNTER_GATE_TIMER != 4 \
+        && PULSE_COUNTER_GATE_TIMER != 5
+    #error "PULSE_COUNTER_GATE_TIMER must be 1, 3, 4 or 5"
+#endif
+
+
+/*!
+ * The gate-time in milliseconds (default 100). The frequency has a resolution of 1000 / PULSE_COUNTER_GATE_MS Hz
+ * (without `PULSE_COUNTER_RECIPROCAL`). A gate-time can have at most 65535 pulses, so the highest frequency is
+ * 65535000 / PULSE_COUNTER_GATE_MS Hz. The longest gate-time is 4194 milliseconds at 16 MHz.
+ */
+#ifndef PULSE_COUNTER_GATE_MS
+#define PULSE_COUNTER_GATE_MS           100
+#endif
+
+#if PULSE_COUNTER_GATE_MS < 1
+    #error "PULSE_COUNTER_GATE_MS must be at least 1"
+#endif
+
+
+/*!
+ * 1 for the reciprocal frequency-measurement, 0 (default) for the gate-time. The reciprocal measurement needs
+ * about 100 instead of 31 clock-cycles per pulse.
+ */
+#ifndef PULSE_COUNTER_RECIPROCAL
+#define PULSE_COUNTER_RECIPROCAL        0
+#endif
+
+
+/*!
+ * With `PULSE_COUNTER_RECIPROCAL`: the frequency is 0, if there was no pulse for this time in milliseconds
+ * (default 5000, so the lowest frequency is 0.2 Hz). Must be shorter than 4 hours.
+ */
+#ifndef PULSE_COUNTER_TIMEOUT_MS
+#define PULSE_COUNTER_TIMEOUT_MS        5000
+#endif
+
+
+/*!
+ * \brief Initializes the external Interrupt and the gate-timer. The total and the counts are set to 0.
+ *
+ * Interrupts must be globally enabled.
+ *
+ * \arg \c extIntEventType EXTINT_RISING_EDGE, EXTINT_FALLING_EDGE (one count per pulse) or EXTINT_ANY_EDGE (two
+ *      counts per pulse).
+ *
+ * \returns 0 on success, or -1 for EXTINT_LOW_LEVEL_ACTIVE.
+ */
+
+int8_t pulseCounterInit( uint8_t extIntEventType );
+
+
+/*!
+ * \brief Disables the external Interrupt and stops the gate-timer. The total keeps its value.
+ */
+
+void pulseCounterStop();
+
+
+/*!
+ * \brief Returns the number of pulses since `pulseCounterInit()` or `pulseCounterClearTotal()`, including the
+ * pulses of the running gate-time.
+ */
+
+uint32_t pulseCounterGetTotal();
+
+
+/*!
+ * \brief Sets the total to 0, for example after the volume of a flow-sensor was read.
+ */
+
+void pulseCounterClearTotal();
+
+
+/*!
+ * \brief Gets the number of pulses in the last complete gate-time.
+ *
+ * \arg \c count The number of pulses is written here (0 before the end of the first gate-time).
+ *
+ * \returns 1, if a gate-time has ended since the last call, otherwise 0 (and the same count is written again).
+ */
+
+uint8_t pulseCounterGetGateCount( uint16_t* count );
+
+
+/*!
+ * \brief Returns the frequency of the pulses in millihertz (1/1000 Hz).
+ *
+ * Without `PULSE_COUNTER_RECIPROCAL` this is the number of pulses in the last complete gate-time, divided by the
+ * gate-time.
+ *
+ * With `PULSE_COUNTER_RECIPROCAL` this is the number of pulses since the last call, divided by the time between
+ * the last pulse before the last call and the last pulse before this call. So the resolution is the resolution of
+ * the gate-timer, independent of the time between the calls. If there was no pulse since the last call, the
+ * frequency decreases with the time since the last pulse, and it is 0 after `PULSE_COUNTER_TIMEOUT_MS`. Call this
+ * function at least every 65535 pulses.
+ */
+
+uint32_t pulseCounterGetFrequencyMilliHz();
+
+
+#endif
@@ -0,0 +1,436 @@
+/*
+    PwmAudio.cpp - Plays 8-bit audio-samples with a hardware-PWM-signal on a
+    half-bridge, paced by its own sample-rate-interrupt.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "PwmAudio.h"
+
+#include <stddef.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+
+#include "AdpcmDecoder.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+#include "Timer8Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == 2 || SYSTEM_CLOCK_TIMER == PWM_AUDIO_TIMER
+    #error "The PwmAudio-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    typedef TimerCounter16< PWM_AUDIO_TIMER >       PwmTimer;
+    typedef Timer16Registers< PWM_AUDIO_TIMER >     PwmRegisters;
+    typedef TimerCounter8< 2 >                      PaceTimer;
+
+    // Prescaler and TOP-value of the PWM-carrier, calculated at compile-time
+    constexpr Timer16_Frequency kPwm = timer16FrequencyFromHz( PWM_AUDIO_PWM_FREQUENCY, T16_PWM_PHI_F_CORRECT_ICRN );
+
+    static_assert( kPwm.clockSource == T16_PRESC_1, "PWM_AUDIO_PWM_FREQUENCY is too low or too high" );
+    static_assert( kPwm.top > 2 * PWM_AUDIO_DEAD_TIME + 16, "PWM_AUDIO_DEAD_TIME is too large for the PWM-frequency" );
+
+    // The range of the compare-match-value of OCnB. OCnA is always 2 * PWM_AUDIO_DEAD_TIME larger.
+    const uint16_t kSpan = kPwm.top - 2 * PWM_AUDIO_DEAD_TIME;
+
+
+    // Timer2 in CTC-mode generates the sample-rate. The smallest prescaler, for which the period fits into 8 bits,
+    // is used.
+    constexpr uint32_t paceTicks( uint16_t prescaler )
+    {
+        return ( F_CPU / prescaler + PWM_AUDIO_SAMPLE_RATE / 2 ) / PWM_AUDIO_SAMPLE_RATE;
+    }
+
+    constexpr uint16_t kPacePrescaler = paceTicks( 1 ) <= 256 ? 1 : paceTicks( 8 ) <= 256 ? 8
+                                        : paceTicks( 32 ) <= 256 ? 32 : paceTicks( 64 ) <= 256 ? 64
+                                        : paceTicks( 128 ) <= 256 ? 128 : paceTicks( 256 ) <= 256 ? 256 : 1024;
+
+    static_assert( paceTicks( kPacePrescaler ) <= 256 && paceTicks( kPacePrescaler ) >= 2,
+                   "PWM_AUDIO_SAMPLE_RATE can't be generated with Timer2" );
+
+    const Timer8_ClockSource kPaceClockSource = kPacePrescaler == 1 ? T8_PRESC_1
+                                                : kPacePrescaler == 8 ? T8_PRESC_8
+                                                : kPacePrescaler == 32 ? T8_PRESC_32
+                                                : kPacePrescaler == 64 ? T8_PRESC_64
+                                                : kPacePrescaler == 128 ? T8_PRESC_128
+                                                : kPacePrescaler == 256 ? T8_PRESC_256 : T8_PRESC_1024;
+
+    const uint8_t kPaceTop = static_cast<uint8_t>( paceTicks( kPacePrescaler ) - 1 );
+
+
+    enum
+    {
+        kSourceNone,
+        kSourceProgmem,
+        kSourceAdpcm,
+        kSourceBuffers,
+        kSourceCallback
+    };
+
+    volatile uint8_t            audio_source;
+
+    // Sources kSourceProgmem and kSourceAdpcm. For kSourceAdpcm the length counts samples, not bytes.
+    const uint8_t*              audio_progmem_start;
+    const uint8_t*              audio_progmem_position;
+    uint16_t                    audio_progmem_length;
+    uint16_t                    audio_progmem_remaining;
+    uint8_t                     audio_progmem_loop;
+    uint8_t                     audio_adpcm_high_nibble;
+    AdpcmDecoder                audio_adpcm;
+
+    // Source kSourceBuffers. A buffer with length 0 is free. The ISR plays the buffers alternately, starting with
+    // audio_active, and the main program fills them alternately, starting with audio_fill.
+    uint8_t                     audio_buffers[ 2 ][ PWM_AUDIO_BUFFER_SIZE ];
+    volatile uint8_t            audio_length[ 2 ];
+    uint8_t                     audio_active;
+    uint8_t                     audio_position;
+    uint8_t                     audio_fill;
+    volatile uint16_t           audio_underruns;
+
+    // Source kSourceCallback
+    PwmAudioCallback            audio_callback;
+
+    // The compare-match-value of OCnB written last
+    uint16_t                    audio_last_ocrb;
+
+
+    // Writes a sample into the two compare-match-registers.
+    // In phase-and-frequency-correct mode the registers are double-buffered and updated at BOTTOM, which can happen
+    // between the two writes. The register, whose change increases the distance between OCRnA and OCRnB, is
+    // written first. So a PWM-period with one old and one new value has a longer dead-time, never a shorter one.
+    inline void writeSample( uint8_t sample ) __attribute__((always_inline));
+    inline void writeSample( uint8_t sample )
+    {
+        uint16_t ocrb;
+
+        if ( kSpan <= 256 )
+        {
+            ocrb = ( static_cast<uint16_t>( sample ) * kSpan ) >> 8;
+        }
+        else
+        {
+            ocrb = static_cast<uint16_t>( ( static_cast<uint32_t>( sample ) * kSpan ) >> 8 );
+        }
+
+        uint16_t ocra = ocrb + 2 * PWM_AUDIO_DEAD_TIME;
+
+        if ( ocrb > audio_last_ocrb )
+        {
+            PwmRegisters::ocrna() = ocra;
+            PwmRegisters::ocrnb() = ocrb;
+        }
+        else
+        {
+            PwmRegisters::ocrnb() = ocrb;
+            PwmRegisters::ocrna() = ocra;
+        }
+
+        audio_last_ocrb = ocrb;
+    }
+};
+
+
+
+ISR( TIMER2_COMPA_vect )
+{
+    uint8_t sample = PWM_AUDIO_SILENCE;
+
+    switch ( audio_source )
+    {
+        case kSourceProgmem:
+            sample = pgm_read_byte( audio_progmem_position );
+            audio_progmem_position++;
+            if ( --audio_progmem_remaining == 0 )
+            {
+                if ( audio_progmem_loop )
+                {
+                    audio_progmem_position = audio_progmem_start;
+                    audio_progmem_remaining = audio_progmem_length;
+                }
+                else
+                {
+                    audio_source = kSourceNone;
+                }
+            }
+            break;
+
+        case kSourceAdpcm:
+        {
+            uint8_t code = pgm_read_byte( audio_progmem_position );
+            if ( audio_adpcm_high_nibble )
+            {
+                code >>= 4;
+                audio_progmem_position++;
+            }
+            audio_adpcm_high_nibble ^= 1;
+            sample = adpcmDecodeNibble( &audio_adpcm, code );
+            if ( --audio_progmem_remaining == 0 )
+            {
+                if ( audio_progmem_loop )
+                {
+                    audio_progmem_position = audio_progmem_start;
+                    audio_progmem_remaining = audio_progmem_length;
+                    audio_adpcm_high_nibble = 0;
+                    adpcmDecoderInit( &audio_adpcm );
+                }
+                else
+                {
+                    audio_source = kSourceNone;
+                }
+            }
+            break;
+        }
+
+        case kSourceBuffers:
+        {
+            uint8_t active = audio_active;
+            uint8_t length = audio_length[ active ];
+
+            if ( length == 0 )
+            {
+                if ( audio_underruns != 0xFFFF )
+                {
+                    audio_underruns++;
+                }
+                break;
+            }
+
+            sample = audio_buffers[ active ][ audio_position ];
+            if ( ++audio_position >= length )
+            {
+                // Hand the buffer back to the main program, and continue with the other one
+                audio_length[ active ] = 0;
+                audio_active = active ^ 1;
+                audio_position = 0;
+            }
+            break;
+        }
+
+        case kSourceCallback:
+            sample = audio_callback();
+            break;
+
+        default:
+            break;
+    }
+
+    writeSample( sample );
+}
+
+
+
+
+void pwmAudioInit()
+{
+    // Stop the sample-rate-interrupt
+    PaceTimer::disableInterrupts( T8_INT_COMP_MATCH_A );
+    PaceTimer::selectClockSource( T8_CLK_OFF );
+    audio_source = kSourceNone;
+
+    // Turn both transistors off: OCnB high (upper transistor off), OCnA low (lower transistor off)
+    PwmTimer::selectClockSource( T16_CLK_OFF );
+    PwmTimer::setMode( T16_NORMAL );
+    PwmTimer::setPwmPinMode( T16_COMP_B, T16_PIN_SET_ON_MATCH );
+    PwmTimer::setPwmPinMode( T16_COMP_A, T16_PIN_CLEAR_ON_MATCH );
+    PwmTimer::forceOutputCompareMatch( T16_COMP_B | T16_COMP_A );
+}
+
+
+
+
+void pwmAudioStart()
+{
+    audio_source = kSourceNone;
+
+    PwmTimer::setMode( kPwm.mode );
+    PwmTimer::setTopValue( kPwm.top );
+    audio_last_ocrb = 0;
+    writeSample( PWM_AUDIO_SILENCE );
+    PwmTimer::setPwmPinMode( T16_COMP_B, T16_PIN_PWM_INVERTED );
+    PwmTimer::setPwmPinMode( T16_COMP_A, T16_PIN_PWM_INVERTED );
+    PwmTimer::setActualCountValue( 0 );
+    PwmTimer::selectClockSource( kPwm.clockSource );
+
+    // Timer2 in CTC-mode with OCR2A as TOP. setMode() doesn't change the COM2A- and COM2B-bits, so the pins OC2A
+    // and OC2B are disconnected explicitly.
+    PaceTimer::setMode( T8_CTC_OCRNA );
+    PaceTimer::setPwmPinMode( T8_COMP_A, T8_PIN_OFF );
+    PaceTimer::setPwmPinMode( T8_COMP_B, T8_PIN_OFF );
+    PaceTimer::setTopValue( kPaceTop );
+    PaceTimer::setActualCountValue( 0 );
+    PaceTimer::clearPendingInterruptEvents( T8_INT_COMP_MATCH_A );
+    PaceTimer::enableInterrupts( T8_INT_COMP_MATCH_A );
+    PaceTimer::selectClockSource( kPaceClockSource );
+}
+
+
+
+
+void pwmAudioStop()
+{
+    pwmAudioInit();
+}
+
+
+
+
+void pwmAudioPlayProgmem( const uint8_t* samples, uint16_t length, uint8_t loop )
+{
+    if ( length == 0 )
+    {
+        pwmAudioSilence();
+        return;
+    }
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        audio_progmem_start = samples;
+        audio_progmem_position = samples;
+        audio_progmem_length = length;
+        audio_progmem_remaining = length;
+        audio_progmem_loop = loop;
+        audio_source = kSourceProgmem;
+    }
+}
+
+
+
+
+void pwmAudioPlayAdpcmProgmem( const uint8_t* data, uint16_t samples, uint8_t loop )
+{
+    if ( samples == 0 )
+    {
+        pwmAudioSilence();
+        return;
+    }
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        audio_progmem_start = data;
+        audio_progmem_position = data;
+        audio_progmem_length = samples;
+        audio_progmem_remaining = samples;
+        audio_progmem_loop = loop;
+        audio_adpcm_high_nibble = 0;
+        adpcmDecoderInit( &audio_adpcm );
+        audio_source = kSourceAdpcm;
+    }
+}
+
+
+
+
+void pwmAudioPlayBuffers()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        audio_length[ 0 ] = 0;
+        audio_length[ 1 ] = 0;
+        audio_active = 0;
+        audio_position = 0;
+        audio_fill = 0;
+        audio_source = kSourceBuffers;
+    }
+}
+
+
+
+
+uint8_t* pwmAudioGetFreeBuffer()
+{
+    if ( audio_length[ audio_fill ] != 0 )
+    {
+        return NULL;
+    }
+
+    return audio_buffers[ audio_fill ];
+}
+
+
+
+
+void pwmAudioSubmitBuffer( uint8_t length )
+{
+    if ( length == 0 )
+    {
+        return;
+    }
+    if ( length > PWM_AUDIO_BUFFER_SIZE )
+    {
+        length = PWM_AUDIO_BUFFER_SIZE;
+    }
+
+    // Writing the length (one byte) hands the buffer to the ISR
+    audio_length[ audio_fill ] = length;
+    audio_fill ^= 1;
+}
+
+
+
+
+void pwmAudioPlayCallback( PwmAudioCallback callback )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        audio_callback = callback;
+        audio_source = kSourceCallback;
+    }
+}
+
+
+
+
+uint8_t pwmAudioIsPlaying()
+{
+    return audio_source != kSourceNone;
+}
+
+
+
+
+uint16_t pwmAudioGetUnderruns()
+{
+    uint16_t underruns;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        underruns = audio_underruns;
+        audio_underruns = 0;
+    }
+
+    return underruns;
+}
+
+
+
+
+void pwmAudioSilence()
+{
+    audio_source = kSourceNone;
+}
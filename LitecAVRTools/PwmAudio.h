@@ -0,0 +1,229 @@
+/*
+    PwmAudio.h - Plays 8-bit audio-samples with a hardware-PWM-signal on a
+    half-bridge, paced by its own sample-rate-interrupt.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to play audio through a half-bridge (two transistors) driven by the PWM-pins OCnA and
+ * OCnB of a 16-bit-Timer/Counter.
+ *
+ * To use these functions, include PwmAudio.h in your source code and link against PwmAudio.cpp, Timer16Bit.cpp
+ * and AdpcmDecoder.cpp.
+ *
+ * The 16-bit-Timer/Counter `PWM_AUDIO_TIMER` generates the PWM-carrier (default 40 kHz) in
+ * phase-and-frequency-correct mode. Timer/Counter2 generates a compare-match-interrupt with the sample-rate
+ * (default 8000 Hz). Only this interrupt-service-routine runs: it takes the next sample from the selected source
+ * (an array in flash-memory with 8-bit or IMA-ADPCM-compressed samples, a double buffer in RAM, or a
+ * callback-function) and writes the two compare-match-values.
+ *
+ * The half-bridge is connected like in exampleTimer16Bit_PWM.cpp: the upper transistor is on with a low level on
+ * OCnB, the lower transistor is on with a high level on OCnA. The compare-match-value of OCnA is always
+ * `2 * PWM_AUDIO_DEAD_TIME` larger than the one of OCnB, so there is a dead-time between turning off one
+ * transistor and turning on the other one.
+ *
+ * \note Linking against PwmAudio.cpp installs the interrupt-service-routine TIMER2_COMPA_vect. Timer/Counter2 and
+ * the Timer/Counter `PWM_AUDIO_TIMER` can't be used for other purposes.
+ */
+
+
+
+#ifndef PwmAudio_h
+#define PwmAudio_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * The 16-bit-Timer/Counter, that generates the PWM-signal: 1 (default), or 3, 4, 5 on the ATmega2560.
+ */
+#ifndef PWM_AUDIO_TIMER
+#define PWM_AUDIO_TIMER             1
+#endif
+
+
+/*!
+ * The frequency of the PWM-carrier in Hz. It should be far above the audible range. The resolution is
+ * F_CPU / 2 / PWM_AUDIO_PWM_FREQUENCY steps (200 at 16 MHz and 40 kHz).
+ */
+#ifndef PWM_AUDIO_PWM_FREQUENCY
+#define PWM_AUDIO_PWM_FREQUENCY     40000
+#endif
+
+
+/*!
+ * The sample-rate in Hz. This is the frequency of the interrupt-service-routine.
+ */
+#ifndef PWM_AUDIO_SAMPLE_RATE
+#define PWM_AUDIO_SAMPLE_RATE       8000
+#endif
+
+
+/*!
+ * Half the difference between the compare-match-values of OCnA and OCnB, in timer-ticks. In
+ * phase-and-frequency-correct mode the counter passes this difference once while counting up and once while
+ * counting down, so the dead-time between switching off one transistor and switching on the other one is
+ * `2 * PWM_AUDIO_DEAD_TIME` clock-cycles (2.5 microseconds at 16 MHz with the default 20).
+ */
+#ifndef PWM_AUDIO_DEAD_TIME
+#define PWM_AUDIO_DEAD_TIME         20
+#endif
+
+
+/*!
+ * Number of samples in each of the two RAM-buffers (at most 255).
+ */
+#ifndef PWM_AUDIO_BUFFER_SIZE
+#define PWM_AUDIO_BUFFER_SIZE       64
+#endif
+
+#if PWM_AUDIO_BUFFER_SIZE < 1 || PWM_AUDIO_BUFFER_SIZE > 255
+    #error "PWM_AUDIO_BUFFER_SIZE must be between 1 and 255"
+#endif
+
+
+/*!
+ * The sample, that is played, when no source is selected or the RAM-buffers are empty (the middle of the range).
+ */
+#define PWM_AUDIO_SILENCE           128
+
+
+/*!
+ * A function, that returns the next sample. It is called by the interrupt-service-routine, so it must be short.
+ */
+typedef uint8_t (*PwmAudioCallback)();
+
+
+/*!
+ * \brief Initializes the PWM-pins OCnA and OCnB, so that both transistors are off.
+ *
+ * The Timer/Counter is stopped, and a compare-match is forced: OCnB is set high and OCnA low. After this function
+ * make the two pins outputs (for example with `setGpioPinModeOutput()`), and then call `pwmAudioStart()`.
+ */
+
+void pwmAudioInit();
+
+
+/*!
+ * \brief Starts the PWM-carrier (with silence) and the sample-rate-interrupt.
+ *
+ * Interrupts must be globally enabled.
+ */
+
+void pwmAudioStart();
+
+
+/*!
+ * \brief Stops the playback and the PWM, and turns both transistors off.
+ */
+
+void pwmAudioStop();
+
+
+/*!
+ * \brief Plays an array of samples in flash-memory.
+ *
+ * \arg \c samples Pointer to the array, declared with PROGMEM.
+ * \arg \c length The number of samples.
+ * \arg \c loop If non-zero, the samples are played again and again.
+ */
+
+void pwmAudioPlayProgmem( const uint8_t* samples, uint16_t length, uint8_t loop );
+
+
+/*!
+ * \brief Plays IMA-ADPCM-compressed audio-data in flash-memory (4 bits per sample, see AdpcmDecoder.h).
+ *
+ * The samples are decoded in the interrupt-service-routine. Create the data with `tools/adpcmEncode.py`.
+ *
+ * \arg \c data Pointer to the array, declared with PROGMEM.
+ * \arg \c samples The number of samples (twice the number of bytes, or one less).
+ * \arg \c loop If non-zero, the samples are played again and again.
+ */
+
+void pwmAudioPlayAdpcmProgmem( const uint8_t* data, uint16_t samples, uint8_t loop );
+
+
+/*!
+ * \brief Plays the samples, that are written into the two RAM-buffers.
+ *
+ * The buffers are played alternately. Fill them with `pwmAudioGetFreeBuffer()` and `pwmAudioSubmitBuffer()`. If
+ * both are empty, silence is played and counted as underrun.
+ */
+
+void pwmAudioPlayBuffers();
+
+
+/*!
+ * \brief Returns a pointer to the RAM-buffer, that is to be filled next, or NULL if both buffers are still waiting
+ * to be played.
+ *
+ * Write up to `PWM_AUDIO_BUFFER_SIZE` samples into the buffer and then call `pwmAudioSubmitBuffer()`.
+ */
+
+uint8_t* pwmAudioGetFreeBuffer();
+
+
+/*!
+ * \brief Hands the buffer returned by `pwmAudioGetFreeBuffer()` to the interrupt-service-routine for playing.
+ *
+ * \arg \c length The number of samples written into the buffer (1 .. PWM_AUDIO_BUFFER_SIZE).
+ */
+
+void pwmAudioSubmitBuffer( uint8_t length );
+
+
+/*!
+ * \brief Plays the samples returned by a function, that is called by the interrupt-service-routine for each sample.
+ *
+ * \arg \c callback The function. It must be short, it is executed PWM_AUDIO_SAMPLE_RATE times per second.
+ */
+
+void pwmAudioPlayCallback( PwmAudioCallback callback );
+
+
+/*!
+ * \brief Returns non-zero, while samples from flash-memory (8-bit or ADPCM) are played (always 1 for RAM-buffers
+ * and callback).
+ */
+
+uint8_t pwmAudioIsPlaying();
+
+
+/*!
+ * \brief Returns the number of samples, for which the RAM-buffers were empty, since the last call (at most 65535).
+ */
+
+uint16_t pwmAudioGetUnderruns();
+
+
+/*!
+ * \brief Stops the playback, silence is played.
+ */
+
+void pwmAudioSilence();
+
+
+#endif
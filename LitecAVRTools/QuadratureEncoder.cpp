@@ -0,0 +1,338 @@
+/*
+    QuadratureEncoder.cpp - Decodes the A- and B-signals of an incremental
+    encoder with two external Interrupts.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "QuadratureEncoder.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "ExternalInterrupts.h"
+#include "GpioPinMacros.h"
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == QUADRATURE_ENCODER_VELOCITY_TIMER
+    #error "The QuadratureEncoder-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+#endif
+
+#if QUADRATURE_ENCODER_INT_A >= EXT_INT_COUNT || QUADRATURE_ENCODER_INT_B >= EXT_INT_COUNT
+    #error "QUADRATURE_ENCODER_INT_A or QUADRATURE_ENCODER_INT_B doesn't exist on this microcontroller"
+#endif
+
+
+
+// The interrupt-vectors of the external Interrupts, for example INT0_vect
+#define QE_INT_A_vect               litecAvrName3( INT, QUADRATURE_ENCODER_INT_A, _vect )
+#define QE_INT_B_vect               litecAvrName3( INT, QUADRATURE_ENCODER_INT_B, _vect )
+
+// The pins of the external Interrupts. Both signals are read at the same time, if they are on the same port.
+#ifndef EXTINT_PIN_REGISTER
+    #error "The pins of the external Interrupts of this microcontroller are unknown. Add them in ExternalInterrupts.h."
+#elif EXT_INT_COUNT == 8
+    #define QE_SAME_PORT            ( ( QUADRATURE_ENCODER_INT_A < 4 ) == ( QUADRATURE_ENCODER_INT_B < 4 ) )
+#else
+    #define QE_SAME_PORT            1
+#endif
+
+#define QE_PIN_A                    EXTINT_PIN_REGISTER( QUADRATURE_ENCODER_INT_A )
+#define QE_PIN_B                    EXTINT_PIN_REGISTER( QUADRATURE_ENCODER_INT_B )
+#define QE_MASK_A                   _BV( EXTINT_PIN_BIT( QUADRATURE_ENCODER_INT_A ) )
+#define QE_MASK_B                   _BV( EXTINT_PIN_BIT( QUADRATURE_ENCODER_INT_B ) )
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    // Marks a transition, in which both signals changed
+    const int8_t kInvalid = 2;
+
+    // The change of the position, indexed by the old state (bits 3, 2) and the new state (bits 1, 0) of the
+    // signals. The state is A in bit 1 and B in bit 0. Forward (A leads B) is 00 -> 10 -> 11 -> 01 -> 00.
+    // The table is in RAM, because reading it from flash takes one cycle more.
+    int8_t qe_table[ 16 ] =
+    {
+    //  new: 00         01          10          11
+             0,         -1,         +1,         kInvalid,       // old: 00
+            +1,          0,         kInvalid,   -1,             // old: 01
+            -1,         kInvalid,    0,         +1,             // old: 10
+            kInvalid,   +1,         -1,          0              // old: 11
+    };
+
+    // Changed by the interrupt-service-routine
+    volatile int32_t            qe_position;
+    volatile uint8_t            qe_errors;
+
+    // Only used by the interrupt-service-routine (and by quadratureEncoderInit()). qe_state is the last state of
+    // the signals, already shifted into bits 3 and 2 for the table-index.
+    uint8_t                     qe_state;
+    int8_t                      qe_direction;
+
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0
+
+    typedef TimerCounter16< QUADRATURE_ENCODER_VELOCITY_TIMER >     QeTimer;
+    typedef Timer16Registers< QUADRATURE_ENCODER_VELOCITY_TIMER >   QeRegisters;
+
+    const uint32_t kTicksPerSecond = F_CPU / QUADRATURE_ENCODER_VELOCITY_PRESCALER;
+
+    // The count-value of the velocity-timer at the last edge. Changed by the interrupt-service-routine.
+    volatile uint16_t           qe_edge_time;
+
+    // Only used by quadratureEncoderGetVelocity()
+    uint8_t                     vel_valid;
+    int32_t                     vel_position;
+    uint16_t                    vel_time;
+    int32_t                     vel_velocity;
+
+#endif
+
+
+    // Reads both signals, in bit 1 (A) and bit 0 (B)
+    inline uint8_t readSignals() __attribute__((always_inline));
+    inline uint8_t readSignals()
+    {
+        uint8_t a;
+        uint8_t b;
+
+        if ( QE_SAME_PORT )
+        {
+            // Both signals at the same time
+            uint8_t pins = QE_PIN_A;
+            a = pins & QE_MASK_A;
+            b = pins & QE_MASK_B;
+        }
+        else
+        {
+            a = QE_PIN_A & QE_MASK_A;
+            b = QE_PIN_B & QE_MASK_B;
+        }
+
+        return ( a ? 0x02 : 0x00 ) | ( b ? 0x01 : 0x00 );
+    }
+};
+
+
+
+ISR( QE_INT_A_vect )
+{
+    uint8_t index = qe_state | readSignals();
+    qe_state = ( index << 2 ) & 0x0C;
+
+    int8_t step = qe_table[ index ];
+
+    // If both signals changed, this interrupt-service-routine is called twice (once for each external Interrupt),
+    // but the second call finds no change.
+    if ( step == 0 )
+    {
+        return;
+    }
+
+    if ( step == kInvalid )
+    {
+        // An edge was missed: assume, that the encoder still moves in the same direction
+        step = qe_direction * 2;
+        uint8_t errors = qe_errors;
+        if ( errors != 0xFF )
+        {
+            qe_errors = errors + 1;
+        }
+    }
+    else
+    {
+        qe_direction = step;
+    }
+
+    qe_position += step;
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0
+    qe_edge_time = QeRegisters::tcntn();
+#endif
+}
+
+
+// Both external Interrupts have the same interrupt-service-routine
+ISR( QE_INT_B_vect, ISR_ALIASOF( QE_INT_A_vect ) );
+
+
+
+
+void quadratureEncoderInit()
+{
+    ExtInt extIntA( QUADRATURE_ENCODER_INT_A, EXTINT_ANY_EDGE );
+    ExtInt extIntB( QUADRATURE_ENCODER_INT_B, EXTINT_ANY_EDGE );
+
+    extIntA.disable();
+    extIntB.disable();
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0
+    QeTimer::selectClockSource( T16_CLK_OFF );
+    QeTimer::setMode( T16_NORMAL );
+    #if QUADRATURE_ENCODER_VELOCITY_PRESCALER == 8
+    QeTimer::selectClockSource( T16_PRESC_8 );
+    #elif QUADRATURE_ENCODER_VELOCITY_PRESCALER == 64
+    QeTimer::selectClockSource( T16_PRESC_64 );
+    #else
+    QeTimer::selectClockSource( T16_PRESC_256 );
+    #endif
+    vel_valid = 0;
+    vel_position = 0;
+    vel_velocity = 0;
+#endif
+
+    qe_state = readSignals() << 2;
+    qe_direction = 0;
+    qe_position = 0;
+    qe_errors = 0;
+
+    extIntA.clearPendingEvent();
+    extIntB.clearPendingEvent();
+    extIntA.enable();
+    extIntB.enable();
+}
+
+
+
+
+void quadratureEncoderStop()
+{
+    disableExtInt( QUADRATURE_ENCODER_INT_A );
+    disableExtInt( QUADRATURE_ENCODER_INT_B );
+}
+
+
+
+
+int32_t quadratureEncoderGetPosition()
+{
+    int32_t position;
+
+    // An interrupt between the reads of the four bytes would give a mixed value. Then the second read differs.
+    do
+    {
+        position = qe_position;
+    } while ( position != qe_position );
+
+    return position;
+}
+
+
+
+
+void quadratureEncoderSetPosition( int32_t position )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        qe_position = position;
+    }
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0
+    // The next velocity is calculated from the new position
+    vel_valid = 0;
+    vel_position = position;
+#endif
+}
+
+
+
+
+uint8_t quadratureEncoderGetErrors()
+{
+    return qe_errors;
+}
+
+
+
+
+void quadratureEncoderClearErrors()
+{
+    qe_errors = 0;
+}
+
+
+
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0
+
+int32_t quadratureEncoderGetVelocity()
+{
+    int32_t position;
+    uint16_t edgeTime;
+    uint16_t now;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        position = qe_position;
+        edgeTime = qe_edge_time;
+        now = QeRegisters::tcntn();
+    }
+
+    int32_t counts = position - vel_position;
+
+    if ( counts != 0 )
+    {
+        uint16_t ticks = edgeTime - vel_time;
+
+        if ( vel_valid && ticks != 0 )
+        {
+            uint32_t magnitude = static_cast<uint32_t>(
+                ( static_cast<uint64_t>( counts < 0 ? -counts : counts ) * kTicksPerSecond + ticks / 2 ) / ticks );
+            vel_velocity = ( counts < 0 ) ? -static_cast<int32_t>( magnitude ) : static_cast<int32_t>( magnitude );
+        }
+
+        vel_valid = 1;
+        vel_position = position;
+        vel_time = edgeTime;
+        return vel_velocity;
+    }
+
+    // No edge since the last call: the encoder moves at most one count in the time since the last edge
+    uint16_t sinceLastEdge = now - vel_time;
+
+    if ( sinceLastEdge >= 0x8000 )
+    {
+        // Keep the timestamp of the last edge within the range of the timer
+        vel_time = now - 0x8000;
+        vel_velocity = 0;
+        return 0;
+    }
+
+    uint32_t limit = kTicksPerSecond / ( sinceLastEdge + 1 );
+    if ( vel_velocity > static_cast<int32_t>( limit ) )
+    {
+        vel_velocity = limit;
+    }
+    else if ( vel_velocity < -static_cast<int32_t>( limit ) )
+    {
+        vel_velocity = -static_cast<int32_t>( limit );
+    }
+    return vel_velocity;
+}
+
+#endif
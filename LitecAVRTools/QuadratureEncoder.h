@@ -0,0 +1,176 @@
+/*
+    QuadratureEncoder.h - Decodes the A- and B-signals of an incremental
+    encoder with two external Interrupts.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to read the position (and the velocity) of a motor with an incremental encoder, that
+ * has two signals A and B shifted by 90 degrees.
+ *
+ * To use these functions, include QuadratureEncoder.h in your source code and link against QuadratureEncoder.cpp
+ * and ExternalInterrupts.cpp (and Timer16Bit.cpp, if the velocity is measured).
+ *
+ * Signal A is connected to the pin of the external Interrupt `QUADRATURE_ENCODER_INT_A`, signal B to the pin of
+ * `QUADRATURE_ENCODER_INT_B`. Both external Interrupts react on any edge, so each edge of both signals is counted
+ * (four counts per period of the signals). One interrupt-service-routine serves both external Interrupts: it reads
+ * both pins, and looks up the change of the position in a table with 16 entries, indexed by the old and the new
+ * state of the signals, instead of an if/else-chain.
+ *
+ * \note Linking against QuadratureEncoder.cpp installs the interrupt-service-routines of both external Interrupts.
+ * If ExternalInterruptsDispatch.cpp is linked too, clear their bits in `EXTINT_DISPATCH_MASK`.
+ */
+
+
+
+#ifndef QuadratureEncoder_h
+#define QuadratureEncoder_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * The external Interrupt for signal A (default 0: pin PD2 on the ATmega328p, PD0 on the ATmega2560).
+ */
+#ifndef QUADRATURE_ENCODER_INT_A
+#define QUADRATURE_ENCODER_INT_A        0
+#endif
+
+
+/*!
+ * The external Interrupt for signal B (default 1: pin PD3 on the ATmega328p, PD1 on the ATmega2560).
+ */
+#ifndef QUADRATURE_ENCODER_INT_B
+#define QUADRATURE_ENCODER_INT_B        1
+#endif
+
+#if QUADRATURE_ENCODER_INT_A == QUADRATURE_ENCODER_INT_B
+    #error "QUADRATURE_ENCODER_INT_A and QUADRATURE_ENCODER_INT_B must be different"
+#endif
+
+
+/*!
+ * The 16-bit-Timer/Counter, whose count-value is the timestamp of each edge for the velocity-measurement: 1, 3, 4,
+ * 5, or 0 (default) to measure no velocity. `quadratureEncoderInit()` lets it run in normal mode without interrupts,
+ * so other modules can still read its count-value.
+ */
+#ifndef QUADRATURE_ENCODER_VELOCITY_TIMER
+#define QUADRATURE_ENCODER_VELOCITY_TIMER       0
+#endif
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0 && QUADRATURE_ENCODER_VELOCITY_TIMER != 1 \
+        && QUADRATURE_ENCODER_VELOCITY_TIMER != 3 && QUADRATURE_ENCODER_VELOCITY_TIMER != 4 \
+        && QUADRATURE_ENCODER_VELOCITY_TIMER != 5
+    #error "QUADRATURE_ENCODER_VELOCITY_TIMER must be 0, 1, 3, 4 or 5"
+#endif
+
+
+/*!
+ * The prescaler of the velocity-timer: 8, 64 (default) or 256. The timestamps wrap around after 65536 timer-ticks
+ * (262 milliseconds with prescaler 64 at 16 MHz), so `quadratureEncoderGetVelocity()` must be called more often.
+ */
+#ifndef QUADRATURE_ENCODER_VELOCITY_PRESCALER
+#define QUADRATURE_ENCODER_VELOCITY_PRESCALER   64
+#endif
+
+#if QUADRATURE_ENCODER_VELOCITY_PRESCALER != 8 && QUADRATURE_ENCODER_VELOCITY_PRESCALER != 64 \
+        && QUADRATURE_ENCODER_VELOCITY_PRESCALER != 256
+    #error "QUADRATURE_ENCODER_VELOCITY_PRESCALER must be 8, 64 or 256"
+#endif
+
+
+/*!
+ * \brief Initializes both external Interrupts (any edge) and the velocity-timer, and sets the position to 0.
+ *
+ * The pins must be inputs (this is the state after reset), with pullup-resistors, if the encoder has open-collector
+ * outputs. Interrupts must be globally enabled.
+ */
+
+void quadratureEncoderInit();
+
+
+/*!
+ * \brief Disables both external Interrupts. The position keeps its value.
+ */
+
+void quadratureEncoderStop();
+
+
+/*!
+ * \brief Returns the position in counts (four counts per period of the signals). It increases, when signal A
+ * leads signal B.
+ *
+ * The position is read without disabling interrupts: it is read twice, until both values are the same. So the
+ * interrupt-latency of the encoder doesn't grow.
+ */
+
+int32_t quadratureEncoderGetPosition();
+
+
+/*!
+ * \brief Sets the position to the given value.
+ */
+
+void quadratureEncoderSetPosition( int32_t position );
+
+
+/*!
+ * \brief Returns the number of invalid transitions, where both signals had changed (at most 255).
+ *
+ * This happens, if the edges come faster than the interrupt-service-routine can handle them, or if the signals
+ * have spikes. The position is changed by two counts in the direction of the last valid transition then, but it
+ * may be wrong.
+ */
+
+uint8_t quadratureEncoderGetErrors();
+
+
+/*!
+ * \brief Clears the number of invalid transitions.
+ */
+
+void quadratureEncoderClearErrors();
+
+
+#if QUADRATURE_ENCODER_VELOCITY_TIMER != 0
+
+/*!
+ * \brief Returns the velocity in counts per second, negative in negative direction.
+ *
+ * The velocity is calculated from the counts and the timestamps of the last edges since the last call, so it is
+ * exact to the resolution of the timer, independent of the time between the calls. If there was no edge since the
+ * last call, the velocity decreases with the time since the last edge. It is 0 after 32768 timer-ticks without
+ * an edge.
+ *
+ * Call this function regularly, at least every 65536 timer-ticks (every 100 milliseconds is a good choice with
+ * prescaler 64 at 16 MHz). The first call after `quadratureEncoderInit()` returns 0.
+ */
+
+int32_t quadratureEncoderGetVelocity();
+
+#endif
+
+
+#endif
@@ -0,0 +1,407 @@
+/*
+    RealTimeClock.cpp - A real-time-clock using Timer/Counter2 in asynchronous
+    mode with a 32.768 kHz watch crystal.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "RealTimeClock.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+
+
+
+namespace
+{
+    // Timer2 counts 32768 Hz / 128 = 256 ticks per second
+    const uint16_t kTicksPerSecond = 256;
+
+    // Duration of one tick in nanoseconds (1/256 s)
+    const int32_t kNanosecondsPerTick = 3906250L;
+
+    const uint32_t kSecondsPerDay = 86400UL;
+
+    // 2000-01-01 was a Saturday
+    const uint8_t kWeekdayOfEpoch = 6;
+
+    const uint8_t kDaysInMonth[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    // All bits of ASSR, that show a pending update of an asynchronous register
+    const uint8_t kAsyncBusyFlags = _BV(TCN2UB) | _BV(OCR2AUB) | _BV(OCR2BUB) | _BV(TCR2AUB) | _BV(TCR2BUB);
+
+
+    // Whole seconds since 2000-01-01. Increased by the overflow-interrupt.
+    volatile uint32_t           rtcSeconds;
+
+    // Drift-correction: number of ticks (0..255) added to TCNT2, changed by the overflow-interrupt according
+    // to the trim.
+    volatile uint8_t            rtcTickOffset;
+
+    // Trim in ppb (nanoseconds per second), and the not yet corrected nanoseconds.
+    int32_t                     rtcTrim;
+    int32_t                     rtcTrimAccumulator;
+
+    // Difference between rtcMillis() and millis() for rtcDisciplineMillis()
+    uint32_t                    disciplineOffset;
+    uint8_t                     disciplineStarted;
+
+
+    inline uint8_t isLeapYear( uint16_t year )
+    {
+        // Sufficient for the years 2000 .. 2135 (2100 is not a leap year)
+        return ( year % 4 == 0 ) && ( year != 2100 );
+    }
+
+
+    uint8_t daysInMonth( uint16_t year, uint8_t month )
+    {
+        if ( month == 2 && isLeapYear( year ) )
+        {
+            return 29;
+        }
+        return kDaysInMonth[ month - 1 ];
+    }
+
+
+    // Reads seconds and ticks (0..255) of the real-time-clock consistently, including the drift-correction.
+    void readRtc( uint32_t& seconds, uint8_t& ticks )
+    {
+        uint16_t t;
+
+        ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+        {
+            seconds = rtcSeconds;
+            t = TCNT2;
+
+            // TCNT2 is still counting: if it has just overflowed, the interrupt has not increased the seconds yet.
+            if ( ( TIFR2 & _BV(TOV2) ) && ( t < 255 ) )
+            {
+                seconds++;
+            }
+
+            t += rtcTickOffset;
+        }
+
+        if ( t >= kTicksPerSecond )
+        {
+            t -= kTicksPerSecond;
+            seconds++;
+        }
+
+        ticks = static_cast<uint8_t>( t );
+    }
+
+
+    // Waits until all updates of asynchronous Timer2-registers are done.
+    inline void waitForAsyncUpdate()
+    {
+        while ( ASSR & kAsyncBusyFlags )
+        {
+        }
+    }
+};
+
+
+
+
+ISR( TIMER2_OVF_vect )
+{
+    uint32_t s = rtcSeconds + 1;
+    uint8_t offset = rtcTickOffset;
+    int32_t accumulator = rtcTrimAccumulator + rtcTrim;
+
+    // Apply the drift-correction in steps of one tick
+    if ( accumulator >= kNanosecondsPerTick )
+    {
+        accumulator -= kNanosecondsPerTick;
+        offset++;
+        if ( offset == 0 )
+        {
+            s++;
+        }
+    }
+    else if ( accumulator <= -kNanosecondsPerTick )
+    {
+        accumulator += kNanosecondsPerTick;
+        if ( offset == 0 )
+        {
+            s--;
+        }
+        offset--;
+    }
+
+    rtcTrimAccumulator = accumulator;
+    rtcTickOffset = offset;
+    rtcSeconds = s;
+}
+
+
+
+
+void rtcInit()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        TIMSK2 = 0;
+
+        // Clock Timer2 from the watch crystal. The contents of TCNT2, OCR2x and TCCR2x may be corrupted by this.
+        ASSR = _BV(AS2);
+
+        TCNT2 = 0;
+        TCCR2A = 0;                             // normal mode
+        TCCR2B = _BV(CS22) | _BV(CS20);         // prescaler 128: overflow every second
+        waitForAsyncUpdate();
+
+        TIFR2 = _BV(TOV2) | _BV(OCF2A) | _BV(OCF2B);   // clear pending interrupts (write 1 to clear)
+        TIMSK2 = _BV(TOIE2);
+
+        rtcSeconds = 0;
+        rtcTickOffset = 0;
+        rtcTrimAccumulator = 0;
+        disciplineStarted = 0;
+    }
+}
+
+
+
+
+void rtcSetSeconds( uint32_t seconds )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        TCNT2 = 0;
+        waitForAsyncUpdate();
+        TIFR2 = _BV(TOV2);
+
+        rtcSeconds = seconds;
+        rtcTickOffset = 0;
+        rtcTrimAccumulator = 0;
+        disciplineStarted = 0;
+    }
+}
+
+
+
+
+uint32_t rtcGetSeconds()
+{
+    uint32_t seconds;
+    uint8_t ticks;
+
+    readRtc( seconds, ticks );
+
+    return seconds;
+}
+
+
+
+
+uint32_t rtcMillis()
+{
+    uint32_t seconds;
+    uint8_t ticks;
+
+    readRtc( seconds, ticks );
+
+    return seconds * 1000 + ( ( static_cast<uint32_t>( ticks ) * 1000 ) >> 8 );
+}
+
+
+
+
+void rtcSecondsToDateTime( uint32_t seconds, RtcDateTime* dateTime )
+{
+    uint32_t days = seconds / kSecondsPerDay;
+    uint32_t rest = seconds % kSecondsPerDay;
+
+    dateTime->second = rest % 60;
+    rest /= 60;
+    dateTime->minute = rest % 60;
+    dateTime->hour = rest / 60;
+    dateTime->weekday = ( days + kWeekdayOfEpoch ) % 7;
+
+    uint16_t year = 2000;
+    while ( 1 )
+    {
+        uint16_t daysInYear = isLeapYear( year ) ? 366 : 365;
+        if ( days < daysInYear )
+        {
+            break;
+        }
+        days -= daysInYear;
+        year++;
+    }
+
+    uint8_t month = 1;
+    while ( 1 )
+    {
+        uint8_t d = daysInMonth( year, month );
+        if ( days < d )
+        {
+            break;
+        }
+        days -= d;
+        month++;
+    }
+
+    dateTime->year = year;
+    dateTime->month = month;
+    dateTime->day = days + 1;
+}
+
+
+
+
+uint32_t rtcDateTimeToSeconds( const RtcDateTime* dateTime )
+{
+    uint32_t days = 0;
+
+    for ( uint16_t year = 2000; year < dateTime->year; year++ )
+    {
+        days += isLeapYear( year ) ? 366 : 365;
+    }
+    for ( uint8_t month = 1; month < dateTime->month; month++ )
+    {
+        days += daysInMonth( dateTime->year, month );
+    }
+    days += dateTime->day - 1;
+
+    return days * kSecondsPerDay + dateTime->hour * 3600UL + dateTime->minute * 60U + dateTime->second;
+}
+
+
+
+
+int8_t rtcSetDateTime( const RtcDateTime* dateTime )
+{
+    if ( dateTime->year < 2000 || dateTime->year > 2135 ||
+         dateTime->month < 1 || dateTime->month > 12 ||
+         dateTime->day < 1 || dateTime->day > daysInMonth( dateTime->year, dateTime->month ) ||
+         dateTime->hour > 23 || dateTime->minute > 59 || dateTime->second > 59 )
+    {
+        return -1;
+    }
+
+    rtcSetSeconds( rtcDateTimeToSeconds( dateTime ) );
+    return 0;
+}
+
+
+
+
+void rtcGetDateTime( RtcDateTime* dateTime )
+{
+    rtcSecondsToDateTime( rtcGetSeconds(), dateTime );
+}
+
+
+
+
+void rtcSetTrim( int32_t ppb )
+{
+    if ( ppb > kNanosecondsPerTick )
+    {
+        ppb = kNanosecondsPerTick;
+    }
+    else if ( ppb < -kNanosecondsPerTick )
+    {
+        ppb = -kNanosecondsPerTick;
+    }
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        rtcTrim = ppb;
+    }
+}
+
+
+
+
+int32_t rtcGetTrim()
+{
+    int32_t ppb;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        ppb = rtcTrim;
+    }
+
+    return ppb;
+}
+
+
+
+
+void rtcDisciplineMillis()
+{
+    // The RTC-time has a resolution of 1/256 s, so differences smaller than one tick are ignored
+    const long kDeadbandMs = 4;
+
+    uint32_t rtcMs = rtcMillis();
+
+    if ( ! disciplineStarted )
+    {
+        disciplineOffset = rtcMs - millis();
+        disciplineStarted = 1;
+        return;
+    }
+
+    long difference = static_cast<long>( rtcMs - disciplineOffset - millis() );
+
+    if ( difference >= kDeadbandMs || difference <= -kDeadbandMs )
+    {
+        adjustSystemClockMillis( difference );
+    }
+}
+
+
+
+
+void rtcSleepPowerSave()
+{
+    // All asynchronous registers must be updated, before going to sleep. Otherwise the CPU could not wake up.
+    waitForAsyncUpdate();
+
+    set_sleep_mode( SLEEP_MODE_PWR_SAVE );
+    cli();
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+
+    // After wake-up TCNT2 must not be read, before one cycle of the watch crystal has passed. Writing a register
+    // and waiting for the end of its update ensures this.
+    TCCR2A = TCCR2A;
+    waitForAsyncUpdate();
+}
+
+
+
+
+void rtcSleepUntil( uint32_t seconds )
+{
+    while ( static_cast<int32_t>( rtcGetSeconds() - seconds ) < 0 )
+    {
+        rtcSleepPowerSave();
+    }
+}
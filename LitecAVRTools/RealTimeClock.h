@@ -0,0 +1,208 @@
+/*
+    RealTimeClock.h - A real-time-clock using Timer/Counter2 in asynchronous
+    mode with a 32.768 kHz watch crystal.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to use a real-time-clock, that keeps date and time, even while the CPU sleeps in
+ * power-save-mode.
+ *
+ * To use these functions, include RealTimeClock.h in your source code and link against RealTimeClock.cpp and
+ * SystemClock.cpp.
+ *
+ * A 32.768 kHz watch crystal must be connected to the pins TOSC1 and TOSC2 (PG4 and PG3 on the ATmega2560). On
+ * the ATmega328p these are the pins of the main crystal (PB6 and PB7), so the CPU must run on its internal
+ * RC-oscillator.
+ *
+ * \note Linking against RealTimeClock.cpp installs an interrupt function on Timer2 (TIMER2_OVF_vect). If you
+ * have other uses for Timer2, do not link against RealTimeClock.cpp.
+ */
+
+
+
+#ifndef RealTimeClock_h
+#define RealTimeClock_h
+
+#include <stdint.h>
+
+#include "SystemClock.h"
+
+#if SYSTEM_CLOCK_TIMER == 2
+    #error "The RealTimeClock-module needs Timer2, so it can't be used as system clock (SYSTEM_CLOCK_TIMER 2)"
+#endif
+
+
+/*!
+ * A date and time. The real-time-clock counts seconds since 2000-01-01 00:00:00, so the years 2000 to 2135 can
+ * be represented.
+ */
+struct RtcDateTime
+{
+    uint16_t year;          //!< 2000 .. 2135
+    uint8_t month;          //!< 1 .. 12
+    uint8_t day;            //!< 1 .. 31
+    uint8_t hour;           //!< 0 .. 23
+    uint8_t minute;         //!< 0 .. 59
+    uint8_t second;         //!< 0 .. 59
+    uint8_t weekday;        //!< 0 (Sunday) .. 6 (Saturday). Ignored by `rtcSetDateTime()`.
+};
+
+
+/*!
+ * \brief Initializes Timer/Counter2 in asynchronous mode and starts the real-time-clock at 2000-01-01 00:00:00.
+ *
+ * Timer2 counts the 32.768 kHz oscillations of the watch crystal with prescaler 128, so it overflows every
+ * second. The function waits until the asynchronous registers are updated. The watch crystal needs up to one
+ * second to start oscillating, so the clock can start a little late after power-up.
+ *
+ * Interrupts must be globally enabled, to use the real-time-clock.
+ */
+
+void rtcInit();
+
+
+/*!
+ * \brief Sets the time in seconds since 2000-01-01 00:00:00. The fraction of a second starts at 0.
+ *
+ * \arg \c seconds the number of seconds since 2000-01-01 00:00:00.
+ */
+
+void rtcSetSeconds( uint32_t seconds );
+
+
+/*!
+ * \brief Returns the time in seconds since 2000-01-01 00:00:00.
+ */
+
+uint32_t rtcGetSeconds();
+
+
+/*!
+ * \brief Returns the time in milliseconds, with a resolution of 1/256 second.
+ *
+ * The value overflows after 2^32 milliseconds (about 49 days), just like `millis()`. It can be used for
+ * time-differences, like `millis()`.
+ */
+
+uint32_t rtcMillis();
+
+
+/*!
+ * \brief Sets date and time.
+ *
+ * \arg \c dateTime Pointer to the date and time to set. The field `weekday` is ignored.
+ *
+ * \returns 0 on success, -1 if one of the fields is out of range (then the clock is not changed).
+ */
+
+int8_t rtcSetDateTime( const RtcDateTime* dateTime );
+
+
+/*!
+ * \brief Reads the actual date and time (including the weekday).
+ *
+ * \arg \c dateTime Pointer to a `RtcDateTime`-struct, which is filled in.
+ */
+
+void rtcGetDateTime( RtcDateTime* dateTime );
+
+
+/*!
+ * \brief Converts seconds since 2000-01-01 00:00:00 into date and time.
+ */
+
+void rtcSecondsToDateTime( uint32_t seconds, RtcDateTime* dateTime );
+
+
+/*!
+ * \brief Converts date and time into seconds since 2000-01-01 00:00:00. The fields are not checked.
+ */
+
+uint32_t rtcDateTimeToSeconds( const RtcDateTime* dateTime );
+
+
+/*!
+ * \brief Sets the drift-correction of the watch crystal.
+ *
+ * The trim is given in parts per billion (1000 ppb = 1 ppm = 86.4 ms per day). A positive value makes the clock
+ * run faster (use it, if the crystal is too slow), a negative value makes it run slower. The correction is applied
+ * in steps of 1/256 second, so the error at any moment is less than 4 ms plus the remaining drift. The trim is
+ * limited to +-3906250 ppb (one step per second).
+ *
+ * To calibrate: compare the clock with an accurate time-source over some days. If the clock lost `d`
+ * seconds in `t` seconds, the trim is `d * 1000000000 / t`.
+ *
+ * \arg \c ppb the trim in parts per billion.
+ */
+
+void rtcSetTrim( int32_t ppb );
+
+
+/*!
+ * \brief Returns the drift-correction set by `rtcSetTrim()`.
+ */
+
+int32_t rtcGetTrim();
+
+
+/*!
+ * \brief Disciplines `millis()` against the real-time-clock.
+ *
+ * The first call remembers the difference between `rtcMillis()` and `millis()`. Each further call corrects
+ * `millis()` with `adjustSystemClockMillis()`, if it differs from the real-time-clock by one RTC-step (4 ms) or
+ * more. So `millis()` gets the accuracy of the watch crystal, and includes the time spent in power-save-mode.
+ * `millis()` never goes backwards: if it is ahead, it stands still until the real-time-clock has caught up.
+ *
+ * Call this function regularly (for example once per second), and after each wake-up from power-save-mode.
+ */
+
+void rtcDisciplineMillis();
+
+
+/*!
+ * \brief Puts the CPU into power-save-mode, until the next interrupt.
+ *
+ * In power-save-mode only Timer2 (and the external interrupts) keep running, so the CPU wakes up at the latest
+ * with the next overflow of Timer2 (at the next full second). The system clock stops during this time, call
+ * `rtcDisciplineMillis()` after waking up.
+ *
+ * Before going to sleep, the function waits until at least one cycle of the watch crystal has passed since the
+ * last wake-up, and until all asynchronous registers of Timer2 are updated. Otherwise the CPU could not wake up
+ * again, or the time could be read wrong (see the datasheet, asynchronous operation of Timer/Counter2).
+ */
+
+void rtcSleepPowerSave();
+
+
+/*!
+ * \brief Sleeps in power-save-mode, until the real-time-clock reaches a certain time.
+ *
+ * \arg \c seconds the time to wake up, in seconds since 2000-01-01 00:00:00 (see `rtcGetSeconds()`). If this time
+ *         has already been reached, the function returns immediately.
+ */
+
+void rtcSleepUntil( uint32_t seconds );
+
+
+#endif
@@ -0,0 +1,378 @@
+/*
+    SoftPwm.cpp - Many PWM-channels (for example for hobby-servos or LEDs) on
+    arbitrary GPIO-pins, generated in software with one 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "SoftPwm.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "GpioPinMacros.h"
+#include "IsrProfiler.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == SOFT_PWM_TIMER
+    #error "The SoftPwm-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+
+
+
+// The interrupt-vector of the timer selected with SOFT_PWM_TIMER, for example TIMER1_COMPA_vect
+#define SP_COMPA_vect               litecAvrName3( TIMER, SOFT_PWM_TIMER, _COMPA_vect )
+
+#if SOFT_PWM_PRESCALER == 1
+#define SP_CLOCK_SOURCE             T16_PRESC_1
+#elif SOFT_PWM_PRESCALER == 8
+#define SP_CLOCK_SOURCE             T16_PRESC_8
+#else
+#define SP_CLOCK_SOURCE             T16_PRESC_64
+#endif
+
+// The interrupt-service-routine is measured by the IsrProfiler-module, if ISR_PROFILER_SOFT_PWM_SLOT is defined as
+// the number of a profiler-slot.
+#if ISR_PROFILER_ENABLED && defined(ISR_PROFILER_SOFT_PWM_SLOT)
+#define SP_PROFILE_ENTER()          PROFILE_ISR_ENTER( ISR_PROFILER_SOFT_PWM_SLOT )
+#define SP_PROFILE_EXIT()           PROFILE_ISR_EXIT( ISR_PROFILER_SOFT_PWM_SLOT )
+#else
+#define SP_PROFILE_ENTER()
+#define SP_PROFILE_EXIT()
+#endif
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    typedef TimerCounter16< SOFT_PWM_TIMER >        SpTimer;
+    typedef Timer16Registers< SOFT_PWM_TIMER >      SpRegisters;
+
+    // An edge, that is nearer than this to the actual count-value, is not left to a new interrupt (whose entry and
+    // exit take longer), but the interrupt-service-routine waits for it.
+    const uint16_t kLatencyTicks = 100 / SOFT_PWM_PRESCALER + 1;
+
+    // Pulse-widths from this value on are "always high": the falling edge would be too near to the next period.
+    const uint16_t kMaxPulseTicks = SOFT_PWM_PERIOD_TICKS - 2 * kLatencyTicks;
+
+    const uint8_t kNotAttached = 0xFF;
+
+
+    // The falling edges of all channels with the same pulse-width. toggle[ p ] contains the pins of port p.
+    struct Edge
+    {
+        uint16_t time;
+        uint8_t toggle[ SOFT_PWM_PORTS ];
+    };
+
+    struct Schedule
+    {
+        uint8_t high[ SOFT_PWM_PORTS ];             // The pins, that are high at the beginning of the period
+        uint8_t edgeCount;
+        Edge edges[ SOFT_PWM_CHANNELS ];            // Sorted by time
+    };
+
+
+    // Changed by the interrupt-service-routine
+
+    Schedule                    sp_schedule[ 2 ];
+    volatile uint8_t            sp_active;          // The schedule used by the interrupt-service-routine
+    volatile uint8_t            sp_pending;         // 1, if the other schedule is to be used from the next period
+    uint8_t                     sp_next_edge;       // The next edge, or edgeCount for the beginning of the period
+
+
+    // The ports with attached pins, and the attached pins of each port
+    uint8_t                     sp_port_count;
+    volatile uint8_t*           sp_pin_register[ SOFT_PWM_PORTS ];
+    volatile uint8_t*           sp_port_register[ SOFT_PWM_PORTS ];
+    uint8_t                     sp_attached[ SOFT_PWM_PORTS ];
+
+
+    // Only used by the main program
+
+    uint8_t                     sp_channel_port[ SOFT_PWM_CHANNELS ];
+    uint8_t                     sp_channel_mask[ SOFT_PWM_CHANNELS ];
+    uint16_t                    sp_channel_ticks[ SOFT_PWM_CHANNELS ];
+};
+
+
+
+ISR( SP_COMPA_vect )
+{
+    SP_PROFILE_ENTER();
+
+    const Schedule* s = &sp_schedule[ sp_active ];
+    uint8_t next = sp_next_edge;
+
+    if ( next >= s->edgeCount )
+    {
+        // Beginning of the period: take over a new schedule, and set all pins with a pulse high. The pins are
+        // toggled, so the other pins of the ports are not touched (no read-modify-write of PORTx).
+        if ( sp_pending )
+        {
+            sp_active ^= 1;
+            sp_pending = 0;
+            s = &sp_schedule[ sp_active ];
+        }
+        for ( uint8_t p = 0; p < sp_port_count; p++ )
+        {
+            *sp_pin_register[ p ] = ( *sp_port_register[ p ] ^ s->high[ p ] ) & sp_attached[ p ];
+        }
+        next = 0;
+    }
+
+    while ( next < s->edgeCount )
+    {
+        const Edge* e = &s->edges[ next ];
+        uint16_t now = SpRegisters::tcntn();
+
+        if ( e->time > now + kLatencyTicks )
+        {
+            SpRegisters::ocrna() = e->time;
+            sp_next_edge = next;
+            SP_PROFILE_EXIT();
+            return;
+        }
+        while ( SpRegisters::tcntn() < e->time )
+        { /*wait for the edge*/ }
+
+        for ( uint8_t p = 0; p < sp_port_count; p++ )
+        {
+            if ( e->toggle[ p ] )
+            {
+                *sp_pin_register[ p ] = e->toggle[ p ];
+            }
+        }
+        next++;
+    }
+
+    // The next interrupt is at the beginning of the next period
+    SpRegisters::ocrna() = 0;
+    sp_next_edge = next;
+
+    SP_PROFILE_EXIT();
+}
+
+
+
+
+void softPwmInit()
+{
+    SpTimer::selectClockSource( T16_CLK_OFF );
+    SpTimer::disableInterrupts( T16_INT_COMP_MATCH_A );
+
+    for ( uint8_t c = 0; c < SOFT_PWM_CHANNELS; c++ )
+    {
+        sp_channel_port[ c ] = kNotAttached;
+        sp_channel_ticks[ c ] = 0;
+    }
+    sp_port_count = 0;
+    sp_schedule[ 0 ].edgeCount = 0;
+    sp_schedule[ 1 ].edgeCount = 0;
+    for ( uint8_t p = 0; p < SOFT_PWM_PORTS; p++ )
+    {
+        sp_schedule[ 0 ].high[ p ] = 0;
+        sp_schedule[ 1 ].high[ p ] = 0;
+        sp_attached[ p ] = 0;
+    }
+    sp_active = 0;
+    sp_pending = 0;
+    sp_next_edge = 0;
+
+    // CTC-mode with ICRn as TOP, the compare-match-interrupt A at 0 is the beginning of the period
+    SpTimer::setMode( T16_CTC_ICRN );
+    SpTimer::setTopValue( SOFT_PWM_PERIOD_TICKS - 1 );
+    SpTimer::setPwmPinMode( T16_COMP_A, T16_PIN_OFF );
+    SpRegisters::ocrna() = 0;
+    SpRegisters::tcntn() = 0;
+    SpTimer::clearPendingInterruptEvents( T16_INT_COMP_MATCH_A );
+    SpTimer::enableInterrupts( T16_INT_COMP_MATCH_A );
+    SpTimer::selectClockSource( SP_CLOCK_SOURCE );
+}
+
+
+
+
+void softPwmStop()
+{
+    SpTimer::selectClockSource( T16_CLK_OFF );
+    SpTimer::disableInterrupts( T16_INT_COMP_MATCH_A );
+
+    for ( uint8_t p = 0; p < sp_port_count; p++ )
+    {
+        *sp_port_register[ p ] &= ~sp_attached[ p ];
+    }
+}
+
+
+
+
+int8_t softPwmAttachPin( uint8_t channel, volatile uint8_t* ddr, volatile uint8_t* port, volatile uint8_t* pin,
+                         uint8_t pinNumber )
+{
+    if ( channel >= SOFT_PWM_CHANNELS || sp_channel_port[ channel ] != kNotAttached )
+    {
+        return -1;
+    }
+
+    uint8_t p = 0;
+    while ( p < sp_port_count && sp_pin_register[ p ] != pin )
+    {
+        p++;
+    }
+    if ( p >= SOFT_PWM_PORTS )
+    {
+        return -1;
+    }
+
+    uint8_t mask = 1 << pinNumber;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        *port &= ~mask;
+        *ddr |= mask;
+        if ( p == sp_port_count )
+        {
+            sp_pin_register[ p ] = pin;
+            sp_port_register[ p ] = port;
+            sp_port_count++;
+        }
+        sp_attached[ p ] |= mask;
+    }
+
+    sp_channel_port[ channel ] = p;
+    sp_channel_mask[ channel ] = mask;
+    sp_channel_ticks[ channel ] = 0;
+    return 0;
+}
+
+
+
+
+void softPwmSetTicks( uint8_t channel, uint16_t ticks )
+{
+    if ( channel < SOFT_PWM_CHANNELS )
+    {
+        sp_channel_ticks[ channel ] = ticks;
+    }
+}
+
+
+
+
+void softPwmSetMicros( uint8_t channel, uint16_t us )
+{
+    softPwmSetTicks( channel, static_cast<uint16_t>( static_cast<uint32_t>( us ) * ( F_CPU / 1000000UL )
+                                                     / SOFT_PWM_PRESCALER ) );
+}
+
+
+
+
+void softPwmSetDuty8( uint8_t channel, uint8_t duty )
+{
+    softPwmSetTicks( channel, static_cast<uint16_t>( ( static_cast<uint32_t>( duty ) * SOFT_PWM_PERIOD_TICKS
+                                                       + 127 ) / 255 ) );
+}
+
+
+
+
+void softPwmUpdate()
+{
+    // The interrupt-service-routine reads the other schedule only, while sp_pending is set. So after clearing it,
+    // the other schedule can be built, and sp_active doesn't change.
+    sp_pending = 0;
+    Schedule* s = &sp_schedule[ sp_active ^ 1 ];
+
+    // The channels with a falling edge, sorted by their pulse-width (insertion-sort)
+    uint8_t order[ SOFT_PWM_CHANNELS ];
+    uint8_t count = 0;
+
+    for ( uint8_t p = 0; p < SOFT_PWM_PORTS; p++ )
+    {
+        s->high[ p ] = 0;
+    }
+
+    for ( uint8_t c = 0; c < SOFT_PWM_CHANNELS; c++ )
+    {
+        uint8_t p = sp_channel_port[ c ];
+        uint16_t ticks = sp_channel_ticks[ c ];
+
+        if ( p == kNotAttached || ticks == 0 )
+        {
+            continue;
+        }
+        s->high[ p ] |= sp_channel_mask[ c ];
+        if ( ticks >= kMaxPulseTicks )
+        {
+            continue;
+        }
+
+        uint8_t i = count;
+        while ( i > 0 && sp_channel_ticks[ order[ i - 1 ] ] > ticks )
+        {
+            order[ i ] = order[ i - 1 ];
+            i--;
+        }
+        order[ i ] = c;
+        count++;
+    }
+
+    // One edge for each distinct pulse-width
+    uint8_t edgeCount = 0;
+    Edge* e = s->edges;
+
+    for ( uint8_t i = 0; i < count; i++ )
+    {
+        uint8_t c = order[ i ];
+        uint16_t ticks = sp_channel_ticks[ c ];
+
+        if ( edgeCount == 0 || e->time != ticks )
+        {
+            if ( edgeCount != 0 )
+            {
+                e++;
+            }
+            edgeCount++;
+            e->time = ticks;
+            for ( uint8_t p = 0; p < SOFT_PWM_PORTS; p++ )
+            {
+                e->toggle[ p ] = 0;
+            }
+        }
+        e->toggle[ sp_channel_port[ c ] ] |= sp_channel_mask[ c ];
+    }
+    s->edgeCount = edgeCount;
+
+    sp_pending = 1;
+}
+
+
+
+
+uint8_t softPwmUpdatePending()
+{
+    return sp_pending;
+}
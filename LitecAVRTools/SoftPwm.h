@@ -0,0 +1,219 @@
+/*
+    SoftPwm.h - Many PWM-channels (for example for hobby-servos or LEDs) on
+    arbitrary GPIO-pins, generated in software with one 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to generate up to 32 PWM-signals on arbitrary GPIO-pins, for example for hobby-servos
+ * or dimmable LEDs.
+ *
+ * To use these functions, include SoftPwm.h in your source code and link against SoftPwm.cpp and Timer16Bit.cpp.
+ *
+ * All channels have the same period (`SOFT_PWM_PERIOD_US`). Each channel is high from the beginning of the period
+ * for its pulse-width, and then low. The Timer/Counter `SOFT_PWM_TIMER` runs in CTC-mode with the period as TOP.
+ * The falling edges of all channels are sorted into a schedule, and the compare-match-interrupt A occurs only at
+ * the beginning of the period and at the distinct times of the falling edges. All pins of one port, that change at
+ * the same time, are toggled with one write to the PINx-register.
+ *
+ * The pulse-widths are set with `softPwmSetMicros()`, `softPwmSetDuty8()` or `softPwmSetTicks()`, and take effect
+ * after `softPwmUpdate()`. This function builds a new schedule in a second buffer. The interrupt-service-routine
+ * switches to the new schedule at the beginning of the next period, so a period never uses parts of two schedules.
+ *
+ * \note Linking against SoftPwm.cpp installs the compare-match-interrupt A of the Timer/Counter `SOFT_PWM_TIMER`.
+ * Don't use this Timer/Counter for other purposes. Other pins of the ports used by SoftPwm can still be used, the
+ * interrupt-service-routine doesn't change them.
+ */
+
+
+
+#ifndef SoftPwm_h
+#define SoftPwm_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * The 16-bit-Timer/Counter used for the PWM: 1 (default), or 3, 4, 5 on the ATmega2560.
+ */
+#ifndef SOFT_PWM_TIMER
+#define SOFT_PWM_TIMER              1
+#endif
+
+#if SOFT_PWM_TIMER != 1 && SOFT_PWM_TIMER != 3 && SOFT_PWM_TIMER != 4 && SOFT_PWM_TIMER != 5
+    #error "SOFT_PWM_TIMER must be 1, 3, 4 or 5"
+#endif
+
+
+/*!
+ * The number of channels (1 .. 32). Each channel needs 4 bytes of RAM, plus 2 * (2 + SOFT_PWM_PORTS) bytes for the
+ * two schedules.
+ */
+#ifndef SOFT_PWM_CHANNELS
+#define SOFT_PWM_CHANNELS           16
+#endif
+
+#if SOFT_PWM_CHANNELS < 1 || SOFT_PWM_CHANNELS > 32
+    #error "SOFT_PWM_CHANNELS must be between 1 and 32"
+#endif
+
+
+/*!
+ * The maximum number of different ports (A, B, C, ...), on which the channels are (1 .. 8). The
+ * interrupt-service-routine needs about 12 clock-cycles per port for each edge.
+ */
+#ifndef SOFT_PWM_PORTS
+#define SOFT_PWM_PORTS              3
+#endif
+
+#if SOFT_PWM_PORTS < 1 || SOFT_PWM_PORTS > 8
+    #error "SOFT_PWM_PORTS must be between 1 and 8"
+#endif
+
+
+/*!
+ * The period in microseconds. The default 20000 (50 Hz) is the period of hobby-servos. For LEDs a shorter period
+ * (for example 5000) avoids flicker.
+ */
+#ifndef SOFT_PWM_PERIOD_US
+#define SOFT_PWM_PERIOD_US          20000
+#endif
+
+
+/*!
+ * The prescaler of the Timer/Counter: 1, 8 (default) or 64. This is the resolution of the pulse-widths (0.5
+ * microseconds with prescaler 8 at 16 MHz). The period must fit into 65536 timer-ticks.
+ */
+#ifndef SOFT_PWM_PRESCALER
+#define SOFT_PWM_PRESCALER          8
+#endif
+
+#if SOFT_PWM_PRESCALER != 1 && SOFT_PWM_PRESCALER != 8 && SOFT_PWM_PRESCALER != 64
+    #error "SOFT_PWM_PRESCALER must be 1, 8 or 64"
+#endif
+
+
+/*!
+ * The period in timer-ticks.
+ */
+#define SOFT_PWM_PERIOD_TICKS       ( ( F_CPU / 1000000UL ) * SOFT_PWM_PERIOD_US / SOFT_PWM_PRESCALER )
+
+#if SOFT_PWM_PERIOD_TICKS > 65000UL || SOFT_PWM_PERIOD_TICKS < 1000UL
+    #error "SOFT_PWM_PERIOD_US doesn't fit to SOFT_PWM_PRESCALER (the period must be 1000 .. 65000 timer-ticks)"
+#endif
+
+
+/*!
+ * \brief Initializes the Timer/Counter and starts the PWM. All channels are off, until pins are attached and
+ * pulse-widths are set.
+ *
+ * Interrupts must be globally enabled.
+ */
+
+void softPwmInit();
+
+
+/*!
+ * \brief Stops the Timer/Counter and sets all attached pins low.
+ */
+
+void softPwmStop();
+
+
+/*!
+ * \brief Attaches a GPIO-pin to a channel. The pin is made an output with a low level.
+ *
+ * Use the macro `softPwmAttach()` instead of calling this function directly.
+ *
+ * \returns 0 on success, or -1 if `channel` is too large, or the pin is on a port, that would be one more than
+ *      `SOFT_PWM_PORTS`.
+ */
+
+int8_t softPwmAttachPin( uint8_t channel, volatile uint8_t* ddr, volatile uint8_t* port, volatile uint8_t* pin,
+                         uint8_t pinNumber );
+
+
+/*!
+ * \brief Attaches a GPIO-pin to a channel. The pin is made an output with a low level.
+ *
+ * For example `softPwmAttach( 0, GpioPin( D, 5 ) );`
+ *
+ * \arg \c channel The channel, 0 .. SOFT_PWM_CHANNELS-1.
+ * \arg \c pinName a GPIO pin name macro generated by GpioPin().
+ *
+ * \returns 0 on success, or -1 (see `softPwmAttachPin()`).
+ */
+
+#define softPwmAttach( channel, pinName )                   _softPwmAttach( channel, pinName )
+
+#define _softPwmAttach( channel, ddr, port, pin, nbr )      softPwmAttachPin( channel, &ddr, &port, &pin, nbr )
+
+
+/*!
+ * \brief Sets the pulse-width of a channel in timer-ticks. It takes effect after `softPwmUpdate()`.
+ *
+ * \arg \c ticks 0 (always low) to SOFT_PWM_PERIOD_TICKS (always high). Pulse-widths very near to the period are
+ *      made "always high", because the end of the pulse would collide with the beginning of the next period.
+ */
+
+void softPwmSetTicks( uint8_t channel, uint16_t ticks );
+
+
+/*!
+ * \brief Sets the pulse-width of a channel in microseconds, for example 1000 .. 2000 for a hobby-servo. It takes
+ * effect after `softPwmUpdate()`.
+ */
+
+void softPwmSetMicros( uint8_t channel, uint16_t us );
+
+
+/*!
+ * \brief Sets the duty-cycle of a channel: 0 (always low) to 255 (always high), for example for a LED. It takes
+ * effect after `softPwmUpdate()`.
+ */
+
+void softPwmSetDuty8( uint8_t channel, uint8_t duty );
+
+
+/*!
+ * \brief Builds the schedule from the pulse-widths of all channels. The interrupt-service-routine uses it from the
+ * beginning of the next period.
+ *
+ * Set all changed pulse-widths first, and then call this function once. If the previous schedule hasn't been taken
+ * over yet, it is replaced. The calculation sorts the channels, it takes about 0.5 ms for 32 channels at 16 MHz.
+ */
+
+void softPwmUpdate();
+
+
+/*!
+ * \brief Returns non-zero, while the schedule built by `softPwmUpdate()` has not yet been taken over by the
+ * interrupt-service-routine.
+ */
+
+uint8_t softPwmUpdatePending();
+
+
+#endif
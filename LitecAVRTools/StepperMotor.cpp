@@ -0,0 +1,455 @@
+/*
+    StepperMotor.cpp - Drives a stepper-motor (STEP- and DIR-input of a driver)
+    with a trapezoidal speed-profile from a 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "StepperMotor.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "GpioPinMacros.h"
+#include "IsrProfiler.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+
+#if SYSTEM_CLOCK_TIMER == STEPPER_TIMER
+    #error "The StepperMotor-module can't use the timer of the system clock (SYSTEM_CLOCK_TIMER)"
+#endif
+
+
+
+// The interrupt-vector of the timer selected with STEPPER_TIMER, for example TIMER1_COMPA_vect
+#define ST_COMPA_vect               litecAvrName3( TIMER, STEPPER_TIMER, _COMPA_vect )
+
+#if STEPPER_PRESCALER == 1
+#define ST_CLOCK_SOURCE             T16_PRESC_1
+#elif STEPPER_PRESCALER == 8
+#define ST_CLOCK_SOURCE             T16_PRESC_8
+#else
+#define ST_CLOCK_SOURCE             T16_PRESC_64
+#endif
+
+// The interrupt-service-routine is measured by the IsrProfiler-module, if ISR_PROFILER_STEPPER_SLOT is defined as
+// the number of a profiler-slot.
+#if ISR_PROFILER_ENABLED && defined(ISR_PROFILER_STEPPER_SLOT)
+#define ST_PROFILE_ENTER()          PROFILE_ISR_ENTER( ISR_PROFILER_STEPPER_SLOT )
+#define ST_PROFILE_EXIT()           PROFILE_ISR_EXIT( ISR_PROFILER_STEPPER_SLOT )
+#else
+#define ST_PROFILE_ENTER()
+#define ST_PROFILE_EXIT()
+#endif
+
+
+
+namespace
+{
+    // These variables are private to this module
+
+    typedef TimerCounter16< STEPPER_TIMER >         StTimer;
+    typedef Timer16Registers< STEPPER_TIMER >       StRegisters;
+
+    // The shortest interval in timer-ticks
+    const uint16_t kMinDelayTicks = STEPPER_MIN_INTERVAL_CYCLES / STEPPER_PRESCALER;
+
+    // The first interval of a move is c0 = 0.676 * f * sqrt( 2 / accel ) timer-ticks (AVR446, the factor 0.676
+    // corrects the error of the approximation in the first steps). This is 16 * 0.676 * sqrt(2) * f, so that
+    // c0 = kC0Factor / sqrt( 256 * accel ) can be calculated with an integer square root.
+    const uint32_t kC0Factor = ( STEPPER_TIMER_FREQUENCY / 1000UL ) * 15296UL;
+
+    enum StepperState { kIdle, kAccel, kRun, kDecel };
+
+
+    // Changed by the interrupt-service-routine
+
+    volatile uint8_t            st_state;
+    volatile uint16_t           st_delay;           // The interval between the next two steps in timer-ticks
+    volatile uint32_t           st_steps_left;
+    volatile int32_t            st_position;
+    uint32_t                    st_accel_n;         // Number of the step in the acceleration-ramp
+    uint32_t                    st_rest;            // Remainder of the last division, carried to the next one
+
+
+    // Set by stepperMove() before the interrupt is enabled
+
+    int8_t                      st_direction;
+    uint16_t                    st_min_delay;       // The interval at the highest speed
+    volatile uint32_t           st_decel_steps;     // The deceleration starts, when this number of steps is left
+    uint16_t                    st_accel;
+    uint16_t                    st_decel;
+
+    volatile uint8_t*           st_step_pin;
+    uint8_t                     st_step_mask;
+    volatile uint8_t*           st_dir_port;
+    uint8_t                     st_dir_mask;
+
+
+    // Returns ( 2 * c + rest ) / divisor and keeps the remainder for the next step. During a ramp the numerator and
+    // the divisor mostly fit into 16 bits, the much faster 16-bit-division is used then.
+    inline uint16_t stDivide( uint16_t c, uint32_t divisor ) __attribute__((always_inline));
+    inline uint16_t stDivide( uint16_t c, uint32_t divisor )
+    {
+        uint32_t numerator = 2 * static_cast<uint32_t>( c ) + st_rest;
+
+        if ( numerator < divisor )
+        {
+            st_rest = numerator;
+            return 0;
+        }
+        if ( numerator <= 0xFFFF && divisor <= 0xFFFF )
+        {
+            uint16_t n16 = static_cast<uint16_t>( numerator );
+            uint16_t d16 = static_cast<uint16_t>( divisor );
+            st_rest = n16 % d16;
+            return n16 / d16;
+        }
+        st_rest = numerator % divisor;
+        return static_cast<uint16_t>( numerator / divisor );
+    }
+
+
+    // The interval for the step, after which stepsLeft steps are left: c = c + ( 2 * c + rest ) / ( 4 * n - 1 )
+    // with n = stepsLeft (AVR446 with negative n).
+    inline uint16_t stDecelerate( uint16_t c, uint32_t stepsLeft ) __attribute__((always_inline));
+    inline uint16_t stDecelerate( uint16_t c, uint32_t stepsLeft )
+    {
+        uint32_t next = static_cast<uint32_t>( c ) + stDivide( c, 4 * stepsLeft - 1 );
+
+        return next > 0xFFFF ? 0xFFFF : static_cast<uint16_t>( next );
+    }
+
+
+    // Integer square root
+    uint16_t stSqrt( uint32_t x )
+    {
+        uint32_t result = 0;
+        uint32_t bit = 1UL << 30;
+
+        while ( bit > x )
+        {
+            bit >>= 2;
+        }
+        while ( bit != 0 )
+        {
+            if ( x >= result + bit )
+            {
+                x -= result + bit;
+                result = ( result >> 1 ) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return static_cast<uint16_t>( result );
+    }
+};
+
+
+
+ISR( ST_COMPA_vect )
+{
+    ST_PROFILE_ENTER();
+
+    // The rising edge of the STEP-pin (writing to PINx toggles the pin). The counter has just been reset to 0, the
+    // interval to the next step, calculated in the last call, is written first.
+    *st_step_pin = st_step_mask;
+    StRegisters::ocrna() = st_delay;
+    st_position += st_direction;
+
+    uint32_t stepsLeft = st_steps_left - 1;
+    st_steps_left = stepsLeft;
+
+    if ( stepsLeft == 0 )
+    {
+        StTimer::selectClockSource( T16_CLK_OFF );
+        StTimer::disableInterrupts( T16_INT_COMP_MATCH_A );
+        st_state = kIdle;
+    }
+    else
+    {
+        uint16_t c = st_delay;
+
+        switch ( st_state )
+        {
+        case kAccel:
+            if ( stepsLeft <= st_decel_steps )
+            {
+                st_state = kDecel;
+                st_rest = 0;
+                c = stDecelerate( c, stepsLeft );
+            }
+            else
+            {
+                // c = c - ( 2 * c + rest ) / ( 4 * n + 1 )
+                uint32_t n = st_accel_n + 1;
+                st_accel_n = n;
+                c -= stDivide( c, 4 * n + 1 );
+                if ( c <= st_min_delay )
+                {
+                    c = st_min_delay;
+                    st_state = kRun;
+                }
+            }
+            break;
+
+        case kRun:
+            if ( stepsLeft <= st_decel_steps )
+            {
+                st_state = kDecel;
+                st_rest = 0;
+                c = stDecelerate( c, stepsLeft );
+            }
+            break;
+
+        default:
+            c = stDecelerate( c, stepsLeft );
+            break;
+        }
+        st_delay = c;
+    }
+
+    // The falling edge of the STEP-pin. The calculation above makes the pulse at least a few microseconds long.
+    *st_step_pin = st_step_mask;
+
+    ST_PROFILE_EXIT();
+}
+
+
+
+
+void stepperInitPins( volatile uint8_t* stepDdr, volatile uint8_t* stepPort, volatile uint8_t* stepPin,
+                      uint8_t stepPinNumber,
+                      volatile uint8_t* dirDdr, volatile uint8_t* dirPort, volatile uint8_t* dirPin,
+                      uint8_t dirPinNumber )
+{
+    (void) dirPin;
+
+    StTimer::selectClockSource( T16_CLK_OFF );
+    StTimer::disableInterrupts( T16_INT_COMP_MATCH_A );
+    StTimer::setMode( T16_CTC_OCRNA );
+    StTimer::setPwmPinMode( T16_COMP_A, T16_PIN_OFF );
+
+    st_step_pin = stepPin;
+    st_step_mask = 1 << stepPinNumber;
+    st_dir_port = dirPort;
+    st_dir_mask = 1 << dirPinNumber;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        *stepPort &= ~st_step_mask;
+        *stepDdr |= st_step_mask;
+        *dirPort &= ~st_dir_mask;
+        *dirDdr |= st_dir_mask;
+    }
+
+    st_state = kIdle;
+    st_steps_left = 0;
+    st_position = 0;
+}
+
+
+
+
+int8_t stepperMove( int32_t steps, uint16_t speed, uint16_t accel, uint16_t decel )
+{
+    if ( st_state != kIdle || speed == 0 || speed > STEPPER_MAX_SPEED || accel == 0 || decel == 0 )
+    {
+        return -1;
+    }
+    if ( steps == 0 )
+    {
+        return 0;
+    }
+
+    uint32_t stepCount;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        if ( steps > 0 )
+        {
+            *st_dir_port |= st_dir_mask;
+            st_direction = 1;
+            stepCount = static_cast<uint32_t>( steps );
+        }
+        else
+        {
+            *st_dir_port &= ~st_dir_mask;
+            st_direction = -1;
+            stepCount = static_cast<uint32_t>( -steps );
+        }
+    }
+
+    // The number of steps to accelerate to the speed: speed^2 / ( 2 * accel )
+    uint32_t speedSquared = static_cast<uint32_t>( speed ) * speed;
+    uint32_t maxSpeedLimit = speedSquared / ( 2 * static_cast<uint32_t>( accel ) );
+    if ( maxSpeedLimit == 0 )
+    {
+        maxSpeedLimit = 1;
+    }
+
+    // The number of steps, after which the deceleration must start at the latest:
+    // stepCount * decel / ( accel + decel ), calculated with the fraction in 16.16-fixed-point
+    uint32_t ratio = ( static_cast<uint32_t>( decel ) << 16 ) / ( static_cast<uint32_t>( accel ) + decel );
+    uint32_t accelLimit = ( stepCount >> 16 ) * ratio + ( ( ( stepCount & 0xFFFF ) * ratio ) >> 16 );
+    if ( accelLimit == 0 )
+    {
+        accelLimit = 1;
+    }
+
+    uint32_t decelSteps;
+    if ( maxSpeedLimit < accelLimit )
+    {
+        // Trapezoid: the speed is reached
+        decelSteps = speedSquared / ( 2 * static_cast<uint32_t>( decel ) );
+    }
+    else
+    {
+        // Triangle: decelerate directly after accelerating
+        decelSteps = stepCount - accelLimit;
+    }
+
+    uint32_t minDelay = ( STEPPER_TIMER_FREQUENCY + speed / 2 ) / speed;
+    st_min_delay = minDelay > 0xFFFF ? 0xFFFF : static_cast<uint16_t>( minDelay );
+
+    // The first interval. If it doesn't fit into 16 bits, the ramp starts later, at the step n with the interval
+    // 65535 = f * sqrt( 2 / accel ) / ( 2 * sqrt( n ) ) = c0 / ( 0.676 * 2 * sqrt( n ) ), so
+    // n = ( c0 / 256 )^2 / ( 0.676 * 2 * 65535 / 256 )^2.
+    uint32_t c0 = kC0Factor / stSqrt( static_cast<uint32_t>( accel ) << 8 );
+    uint32_t accelN = 0;
+    if ( c0 > 0xFFFF )
+    {
+        uint32_t q = c0 >> 8;
+        accelN = q * q / 119795UL;
+        c0 = 0xFFFF;
+    }
+
+    st_accel = accel;
+    st_decel = decel;
+    st_decel_steps = decelSteps;
+    st_steps_left = stepCount;
+    st_accel_n = accelN;
+    st_rest = 0;
+    if ( c0 <= st_min_delay )
+    {
+        st_delay = st_min_delay;
+        st_state = kRun;
+    }
+    else
+    {
+        st_delay = static_cast<uint16_t>( c0 );
+        st_state = kAccel;
+    }
+
+    // The first step is made after the shortest interval
+    StRegisters::tcntn() = 0;
+    StRegisters::ocrna() = kMinDelayTicks;
+    StTimer::clearPendingInterruptEvents( T16_INT_COMP_MATCH_A );
+    StTimer::enableInterrupts( T16_INT_COMP_MATCH_A );
+    StTimer::selectClockSource( ST_CLOCK_SOURCE );
+
+    return 0;
+}
+
+
+
+
+void stepperStop()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        uint8_t state = st_state;
+        uint32_t needed;
+
+        if ( state == kAccel )
+        {
+            // The steps to decelerate from the actual speed: n * accel / decel
+            needed = st_accel_n * st_accel / st_decel;
+        }
+        else if ( state == kRun )
+        {
+            needed = st_decel_steps;
+        }
+        else
+        {
+            return;
+        }
+        if ( needed == 0 )
+        {
+            needed = 1;
+        }
+        if ( st_steps_left > needed )
+        {
+            st_steps_left = needed;
+        }
+        st_decel_steps = needed;
+    }
+}
+
+
+
+
+void stepperHalt()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        StTimer::selectClockSource( T16_CLK_OFF );
+        StTimer::disableInterrupts( T16_INT_COMP_MATCH_A );
+        st_state = kIdle;
+        st_steps_left = 0;
+    }
+}
+
+
+
+
+uint8_t stepperIsRunning()
+{
+    return st_state != kIdle;
+}
+
+
+
+
+int32_t stepperGetPosition()
+{
+    int32_t position;
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        position = st_position;
+    }
+    return position;
+}
+
+
+
+
+void stepperSetPosition( int32_t position )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        st_position = position;
+    }
+}
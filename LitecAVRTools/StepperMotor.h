@@ -0,0 +1,187 @@
+/*
+    StepperMotor.h - Drives a stepper-motor (STEP- and DIR-input of a driver)
+    with a trapezoidal speed-profile from a 16-bit-Timer/Counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to move a stepper-motor with a driver (for example A4988 or DRV8825), that has a STEP-
+ * and a DIR-input.
+ *
+ * To use these functions, include StepperMotor.h in your source code and link against StepperMotor.cpp and
+ * Timer16Bit.cpp.
+ *
+ * A move accelerates with a constant acceleration up to the given speed, runs with this speed, and decelerates
+ * with a constant deceleration to a stop at the target (a trapezoidal speed-profile). If the target is too near, the
+ * speed is not reached, and the move decelerates directly after accelerating (a triangular speed-profile).
+ *
+ * The Timer/Counter `STEPPER_TIMER` runs in CTC-mode with OCRnA as TOP (`T16_CTC_OCRNA`). The compare-match-interrupt
+ * A makes a step and writes the interval to the next step into OCRnA. The interval is calculated with the integer
+ * approximation of the application note AVR446 ("Linear speed control of stepper motor"): during acceleration and
+ * deceleration one 16-bit-division per step, while running with constant speed no calculation at all.
+ *
+ * \note Linking against StepperMotor.cpp installs the compare-match-interrupt A of the Timer/Counter
+ * `STEPPER_TIMER`. Don't use this Timer/Counter for other purposes.
+ */
+
+
+
+#ifndef StepperMotor_h
+#define StepperMotor_h
+
+#include <stdint.h>
+
+#include <avr/io.h>
+
+
+/*!
+ * The 16-bit-Timer/Counter used for the steps: 1 (default), or 3, 4, 5 on the ATmega2560.
+ */
+#ifndef STEPPER_TIMER
+#define STEPPER_TIMER               1
+#endif
+
+#if STEPPER_TIMER != 1 && STEPPER_TIMER != 3 && STEPPER_TIMER != 4 && STEPPER_TIMER != 5
+    #error "STEPPER_TIMER must be 1, 3, 4 or 5"
+#endif
+
+
+/*!
+ * The prescaler of the Timer/Counter: 1, 8 (default) or 64. The longest interval between two steps is 65535
+ * timer-ticks, so the prescaler determines the lowest speed (about 31 steps per second with prescaler 8 at 16 MHz).
+ * Moves with a lower speed or a lower acceleration need the prescaler 64.
+ */
+#ifndef STEPPER_PRESCALER
+#define STEPPER_PRESCALER           8
+#endif
+
+#if STEPPER_PRESCALER != 1 && STEPPER_PRESCALER != 8 && STEPPER_PRESCALER != 64
+    #error "STEPPER_PRESCALER must be 1, 8 or 64"
+#endif
+
+
+/*!
+ * The frequency of the timer-ticks in Hz.
+ */
+#define STEPPER_TIMER_FREQUENCY     ( F_CPU / STEPPER_PRESCALER )
+
+
+/*!
+ * The shortest interval between two steps in clock-cycles. The interrupt-service-routine needs up to about 350
+ * clock-cycles during acceleration and deceleration, so this limits the speed to 40000 steps per second at 16 MHz.
+ */
+#ifndef STEPPER_MIN_INTERVAL_CYCLES
+#define STEPPER_MIN_INTERVAL_CYCLES 400
+#endif
+
+
+/*!
+ * The highest speed in steps per second, that `stepperMove()` accepts.
+ */
+#define STEPPER_MAX_SPEED           ( F_CPU / STEPPER_MIN_INTERVAL_CYCLES )
+
+
+/*!
+ * \brief Initializes the Timer/Counter and the STEP- and DIR-pins (outputs with low level).
+ *
+ * Use the macro `stepperInit()` instead of calling this function directly.
+ */
+
+void stepperInitPins( volatile uint8_t* stepDdr, volatile uint8_t* stepPort, volatile uint8_t* stepPin,
+                      uint8_t stepPinNumber,
+                      volatile uint8_t* dirDdr, volatile uint8_t* dirPort, volatile uint8_t* dirPin,
+                      uint8_t dirPinNumber );
+
+
+/*!
+ * \brief Initializes the Timer/Counter and the STEP- and DIR-pins (outputs with low level).
+ *
+ * For example `stepperInit( GpioPin( D, 2 ), GpioPin( D, 3 ) );`. The position is set to 0.
+ *
+ * \arg \c stepPinName a GPIO pin name macro generated by GpioPin(). The pin is connected to the STEP-input of the
+ *      driver, a step is made at the rising edge.
+ * \arg \c dirPinName a GPIO pin name macro generated by GpioPin(). The pin is connected to the DIR-input of the
+ *      driver. It is high for moves in positive direction.
+ */
+
+#define stepperInit( stepPinName, dirPinName )              _stepperInit( stepPinName, dirPinName )
+
+#define _stepperInit( sDdr, sPort, sPin, sNbr, dDdr, dPort, dPin, dNbr )  \
+                            stepperInitPins( &sDdr, &sPort, &sPin, sNbr, &dDdr, &dPort, &dPin, dNbr )
+
+
+/*!
+ * \brief Starts a move by a number of steps. The function returns immediately, the steps are made by the
+ * interrupt-service-routine.
+ *
+ * Interrupts must be globally enabled.
+ *
+ * \arg \c steps The number of steps, negative values move in negative direction.
+ * \arg \c speed The highest speed in steps per second (1 .. STEPPER_MAX_SPEED).
+ * \arg \c accel The acceleration in steps per second per second (1 .. 65535).
+ * \arg \c decel The deceleration in steps per second per second (1 .. 65535).
+ *
+ * \returns 0 on success, or -1 if the motor is still moving or a parameter is out of range.
+ */
+
+int8_t stepperMove( int32_t steps, uint16_t speed, uint16_t accel, uint16_t decel );
+
+
+/*!
+ * \brief Decelerates the motor with the deceleration of the actual move to a stop (if it isn't already
+ * decelerating).
+ */
+
+void stepperStop();
+
+
+/*!
+ * \brief Stops the motor immediately, without deceleration. At higher speeds the motor may lose steps.
+ */
+
+void stepperHalt();
+
+
+/*!
+ * \brief Returns non-zero, while the motor is moving.
+ */
+
+uint8_t stepperIsRunning();
+
+
+/*!
+ * \brief Returns the position in steps (the sum of all steps made since `stepperInit()` or
+ * `stepperSetPosition()`).
+ */
+
+int32_t stepperGetPosition();
+
+
+/*!
+ * \brief Sets the position to the given value. This doesn't move the motor.
+ */
+
+void stepperSetPosition( int32_t position );
+
+
+#endif
@@ -33,42 +33,270 @@
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
 #include <util/atomic.h>
 
+#include "GpioPinMacros.h"
+#include "IsrProfiler.h"
+
+
+
+// The registers and bits of the timer selected with SYSTEM_CLOCK_TIMER, for example SC_TCNT is TCNT0, TCNT2
+// or TCNT1.
+#define SC_TCCRA                    litecAvrName3( TCCR, SYSTEM_CLOCK_TIMER, A )
+#define SC_TCCRB                    litecAvrName3( TCCR, SYSTEM_CLOCK_TIMER, B )
+#define SC_TCNT                     litecAvrName2( TCNT, SYSTEM_CLOCK_TIMER )
+#define SC_OCRA                     litecAvrName3( OCR, SYSTEM_CLOCK_TIMER, A )
+#define SC_TIMSK                    litecAvrName2( TIMSK, SYSTEM_CLOCK_TIMER )
+#define SC_TIFR                     litecAvrName2( TIFR, SYSTEM_CLOCK_TIMER )
+#define SC_TOV                      litecAvrName2( TOV, SYSTEM_CLOCK_TIMER )
+#define SC_TOIE                     litecAvrName2( TOIE, SYSTEM_CLOCK_TIMER )
+#define SC_OCFA                     litecAvrName3( OCF, SYSTEM_CLOCK_TIMER, A )
+#define SC_OCIEA                    litecAvrName3( OCIE, SYSTEM_CLOCK_TIMER, A )
+#define SC_WGM0                     litecAvrName3( WGM, SYSTEM_CLOCK_TIMER, 0 )
+#define SC_WGM1                     litecAvrName3( WGM, SYSTEM_CLOCK_TIMER, 1 )
+#define SC_OVF_vect                 litecAvrName3( TIMER, SYSTEM_CLOCK_TIMER, _OVF_vect )
+#define SC_COMPA_vect               litecAvrName3( TIMER, SYSTEM_CLOCK_TIMER, _COMPA_vect )
+
+// Clock-select-bits for the prescaler 64. Timer2 has more prescalers than the other timers, so its bits differ.
+#if SYSTEM_CLOCK_TIMER == 2
+#define SC_CS_PRESCALER_64          ( 1 << CS22 )
+#else
+#define SC_CS_PRESCALER_64          ( ( 1 << litecAvrName3( CS, SYSTEM_CLOCK_TIMER, 1 ) )                              \
+                                      | ( 1 << litecAvrName3( CS, SYSTEM_CLOCK_TIMER, 0 ) ) )
+#endif
+
+// The power-reduction-bits in PRR (PRR0 on the ATmega2560) without PRADC, and in PRR1. The reserved bits are not
+// included.
+#define SC_PRR0_BITS                ( _BV(PRTWI) | _BV(PRTIM2) | _BV(PRTIM0) | _BV(PRTIM1) | _BV(PRSPI)               \
+                                      | _BV(PRUSART0) )
+#if defined(PRR1)
+#define SC_PRR1_BITS                ( _BV(PRTIM5) | _BV(PRTIM4) | _BV(PRTIM3) | _BV(PRUSART3) | _BV(PRUSART2)        \
+                                      | _BV(PRUSART1) )
+#endif
+
+#if SYSTEM_CLOCK_TIMER == 0 || SYSTEM_CLOCK_TIMER == 2
+#define SC_COUNTER_BITS             8
+#else
+#define SC_COUNTER_BITS             16
+#endif
+
+// The interrupt-routines of the system clock are measured by the IsrProfiler-module, if
+// ISR_PROFILER_SYSTEM_CLOCK_SLOT is defined as the number of a profiler-slot.
+#if ISR_PROFILER_ENABLED && defined(ISR_PROFILER_SYSTEM_CLOCK_SLOT)
+#define SC_PROFILE_ENTER()          PROFILE_ISR_ENTER( ISR_PROFILER_SYSTEM_CLOCK_SLOT )
+#define SC_PROFILE_EXIT()           PROFILE_ISR_EXIT( ISR_PROFILER_SYSTEM_CLOCK_SLOT )
+#else
+#define SC_PROFILE_ENTER()
+#define SC_PROFILE_EXIT()
+#endif
+
 
 
 namespace
 {
     // These variables are private to this module
 
-    // The prescaler is set so that timer0 ticks every 64 clock cycles, and the
-    // the overflow handler is called every 256 ticks.
-    const unsigned long kMicrosecondsPerOverflowTIMER0 = ( clockCyclesToMicroseconds( 64 * 256 ) );
+#if SC_COUNTER_BITS == 8
+    typedef uint8_t CounterType;
+#else
+    typedef uint16_t CounterType;
+#endif
+
+    // Highest value of the counter
+    const CounterType kCounterTop = static_cast<CounterType>( ~0 );
+
+    // The prescaler is set so that the timer ticks every 64 clock cycles, and the overflow handler is called every
+    // 256 (8-bit-timer) or 65536 (16-bit-timer) ticks. The macros from SystemClock.h use the whole number of clock
+    // cycles per microsecond, which is not exact for F_CPU like 18.432 MHz. So the conversions between ticks and
+    // microseconds use a whole number and a 32-bit binary fraction, calculated from F_CPU at compile-time.
+
+    // Number of microseconds per tick: 4 at 16 MHz, 3.2 at 20 MHz
+    const unsigned long kMicrosecondsPerTick = ( 64000000UL / F_CPU );
+    const unsigned long kMicrosecondsPerTickFraction = ( ( ( 64000000ULL % F_CPU ) << 32 ) / F_CPU );
+
+    // Number of microseconds per overflow-period, the exact value for micros()
+    const unsigned long kMicrosecondsPerOverflowWhole = ( ( 64000000ULL << SC_COUNTER_BITS ) / F_CPU );
+    const unsigned long kMicrosecondsPerOverflowFraction = ( ( ( ( 64000000ULL << SC_COUNTER_BITS ) % F_CPU ) << 32 )
+                                                             / F_CPU );
+
+    // Number of ticks per microsecond as 32-bit binary fraction (it is less than one)
+    const unsigned long kTicksPerMicrosecondFraction = ( ( static_cast<unsigned long long>( F_CPU ) << 32 )
+                                                         / 64000000UL );
+
+    // Number of microseconds per overflow-period, rounded to the nearest value. Used for the millisecond count.
+    const unsigned long kMicrosecondsPerOverflow = ( ( ( 64000000ULL << SC_COUNTER_BITS ) + F_CPU / 2 ) / F_CPU );
+
+    // The whole number of milliseconds per timer overflow
+    const unsigned long kMillisInc = ( kMicrosecondsPerOverflow / 1000 );
+
+#if SYSTEM_CLOCK_TICKLESS
+
+    // The fractional number of milliseconds per timer overflow in microseconds
+    const uint16_t kFractMicrosInc = ( kMicrosecondsPerOverflow % 1000 );
+
+    // Software-extension of the hardware-counter. This is the only variable changed by the overflow interrupt.
+    volatile unsigned long      clock_overflow_count;
+
+    // millis() is calculated from the counter only, when it is called. These variables hold the milliseconds
+    // (and the fraction of a millisecond in microseconds) at the beginning of overflow-period
+    // clock_millis_overflow_count. Only accessed with interrupts disabled.
+    unsigned long               clock_millis;
+    unsigned long               clock_millis_overflow_count;
+    uint16_t                    clock_fract_micros;
+
+    // The alarm (see setSystemClockAlarm()). It fires in overflow-period alarmOverflowCount, when the counter
+    // reaches alarmTick. The compare-match-interrupt is only enabled during this overflow-period.
+    enum
+    {
+        kAlarmOff,
+        kAlarmWaitingForOverflow,
+        kAlarmCompareMatchArmed,
+        kAlarmExpired
+    };
+
+    volatile uint8_t            alarmState;
+    unsigned long               alarmOverflowCount;
+    CounterType                 alarmTick;
+
+    volatile unsigned long      clock_compare_match_count;
 
-    // The whole number of milliseconds per timer0 overflow
-    const unsigned long kMillisInc = ( kMicrosecondsPerOverflowTIMER0 / 1000 );
+#else
 
-    // The fractional number of milliseconds per timer0 overflow. Shift right
+    // The fractional number of milliseconds per timer overflow. Shift right
     // by three to fit these numbers into a byte (for 8 MHz, 12 MHz, and 16 MHz this doesn't lose precision).
-    const uint8_t kFractInc =  ( ( kMicrosecondsPerOverflowTIMER0 % 1000 ) >> 3 );
+    const uint8_t kFractInc =  ( ( kMicrosecondsPerOverflow % 1000 ) >> 3 );
     const uint8_t kFractMax =  ( 1000 >> 3 );
 
+    // The number of milliseconds at the end of delayMillisecondsIdle(), that are busy-waited: one overflow-period
+    // (64 * 256 clock cycles), rounded up to whole milliseconds. 2 at 16 MHz, 3 at 8 MHz.
+    const unsigned long kIdleBusyWaitMillis = ( 64UL * 256 * 1000 + F_CPU - 1 ) / F_CPU;
+
     // Variables to keep track of time
-    volatile unsigned long      timer0_overflow_count;
-    volatile unsigned long      timer0_millis;
-    uint8_t                     timer0_fract;
+    volatile unsigned long      clock_overflow_count;
+    volatile unsigned long      clock_millis;
+    uint8_t                     clock_fract;
+
+#endif
+
+
+    // Value that millis() doesn't fall below after a negative adjustSystemClockMillis(). Only accessed with
+    // interrupts disabled.
+    unsigned long               clock_millis_floor;
+    uint8_t                     clock_millis_floor_active;
+
+
+    // Reads the overflow-count and the hardware-counter consistently. Must be called with interrupts disabled.
+    inline void readCounter( unsigned long& m, CounterType& t ) __attribute__((always_inline));
+    inline void readCounter( unsigned long& m, CounterType& t )
+    {
+        m = clock_overflow_count;
+        t = SC_TCNT;
+
+        //The counter is still counting. Therefore check, if it just had an overflow. If so, increase the
+        //copy of clock_overflow_count, because the interrupt-service-routine had not been executed yet, and has
+        //not yet increased clock_overflow_count.
+        if ( ( SC_TIFR & _BV(SC_TOV) ) && ( t < kCounterTop ) )
+        {
+            m++;
+        }
+    }
+
+
+    // Returns the upper 32 bits of the 64-bit-product a * b, built from four 16-bit-multiplications. A full
+    // 64-bit-multiplication would be much slower. With b == 0 the compiler removes the function completely.
+    inline unsigned long multiplyHigh( unsigned long a, unsigned long b ) __attribute__((always_inline));
+    inline unsigned long multiplyHigh( unsigned long a, unsigned long b )
+    {
+        uint16_t aLow = static_cast<uint16_t>( a );
+        uint16_t aHigh = static_cast<uint16_t>( a >> 16 );
+        uint16_t bLow = static_cast<uint16_t>( b );
+        uint16_t bHigh = static_cast<uint16_t>( b >> 16 );
+
+        unsigned long lowLow = static_cast<unsigned long>( aLow ) * bLow;
+        unsigned long lowHigh = static_cast<unsigned long>( aLow ) * bHigh;
+        unsigned long highLow = static_cast<unsigned long>( aHigh ) * bLow;
+        unsigned long highHigh = static_cast<unsigned long>( aHigh ) * bHigh;
+
+        // The carry from the lower 32 bits of the product
+        unsigned long middle = ( lowLow >> 16 ) + static_cast<uint16_t>( lowHigh ) + static_cast<uint16_t>( highLow );
+
+        return highHigh + ( lowHigh >> 16 ) + ( highLow >> 16 ) + ( middle >> 16 );
+    }
+
+
+    // Converts ticks of the counter into microseconds, rounded down.
+    inline unsigned long microsecondsFromTicks( unsigned long ticks ) __attribute__((always_inline));
+    inline unsigned long microsecondsFromTicks( unsigned long ticks )
+    {
+        return ticks * kMicrosecondsPerTick + multiplyHigh( ticks, kMicrosecondsPerTickFraction );
+    }
+
+
+#if SYSTEM_CLOCK_TICKLESS
+
+    // Enables the compare-match-interrupt for the alarm. Called with interrupts disabled, in the overflow-period
+    // in which the alarm fires.
+    void armAlarm()
+    {
+        SC_OCRA = alarmTick;
+        SC_TIFR = _BV(SC_OCFA);     // clear an old compare-match (write 1 to clear)
+
+        if ( SC_TCNT >= alarmTick )
+        {
+            // alarm-time has already been reached
+            alarmState = kAlarmExpired;
+            return;
+        }
+
+        alarmState = kAlarmCompareMatchArmed;
+        SC_TIMSK |= _BV(SC_OCIEA);
+    }
+
+#endif
 
 };
 
 
 
 
-ISR( TIMER0_OVF_vect )
+#if SYSTEM_CLOCK_TICKLESS
+
+ISR( SC_OVF_vect )
+{
+    SC_PROFILE_ENTER();
+
+    // Only the software-extension of the hardware-counter is done here. millis() and micros() are calculated from
+    // the counter, when they are called.
+    unsigned long m = clock_overflow_count + 1;
+    clock_overflow_count = m;
+
+    if ( alarmState == kAlarmWaitingForOverflow && m == alarmOverflowCount )
+    {
+        armAlarm();
+    }
+
+    SC_PROFILE_EXIT();
+}
+
+
+ISR( SC_COMPA_vect )
+{
+    SC_TIMSK &= ~_BV(SC_OCIEA);
+    alarmState = kAlarmExpired;
+    clock_compare_match_count++;
+}
+
+#else
+
+ISR( SC_OVF_vect )
 {
+    SC_PROFILE_ENTER();
+
     // Copy these to local variables so they can be stored in registers
     // (volatile variables must be read from memory on every access)
-    unsigned long m = timer0_millis;
-    uint8_t f = timer0_fract;
+    unsigned long m = clock_millis;
+    uint8_t f = clock_fract;
 
     m += kMillisInc;
     f += kFractInc;
@@ -78,25 +306,115 @@ ISR( TIMER0_OVF_vect )
         ++m;
     }
 
-    timer0_fract = f;
-    timer0_millis = m;
-    timer0_overflow_count++;
+    clock_fract = f;
+    clock_millis = m;
+    clock_overflow_count++;
+
+    SC_PROFILE_EXIT();
 }
 
+#endif
+
+
+
+namespace
+{
+    // Returns the millisecond count. Must be called with interrupts disabled.
+#if SYSTEM_CLOCK_TICKLESS
+
+    unsigned long readMillis()
+    {
+        unsigned long ms;
+
+        unsigned long m;
+        CounterType t;
+        readCounter( m, t );
+
+        // First add the whole overflow-periods, that have passed since the last call
+        unsigned long n = m - clock_millis_overflow_count;
+        clock_millis_overflow_count = m;
+
+        if ( n < 64 )
+        {
+            // Usual case: millis() is called at least every 64 overflows. 64*999 fits into 16 bits.
+            clock_millis += n * kMillisInc;
+            clock_fract_micros += static_cast<uint16_t>( n ) * kFractMicrosInc;
+            while ( clock_fract_micros >= 1000 )
+            {
+                clock_fract_micros -= 1000;
+                clock_millis++;
+            }
+        }
+        else
+        {
+            // n * kFractMicrosInc could overflow: Split n into n = q*1000 + r
+            unsigned long q = n / 1000;
+            uint16_t r = n % 1000;
+            unsigned long fract = static_cast<unsigned long>( r ) * kFractMicrosInc + clock_fract_micros;
+
+            clock_millis += n * kMillisInc + q * kFractMicrosInc + fract / 1000;
+            clock_fract_micros = fract % 1000;
+        }
+
+        // Then add the microseconds of the actual overflow-period
+#if SC_COUNTER_BITS == 8
+        // less than 2 ms: at most one subtraction
+        uint16_t us = clock_fract_micros + static_cast<uint16_t>( microsecondsFromTicks( t ) );
+        ms = clock_millis;
+        while ( us >= 1000 )
+        {
+            us -= 1000;
+            ms++;
+        }
+#else
+        // up to 524 ms (at 8 MHz)
+        unsigned long us = clock_fract_micros + microsecondsFromTicks( t );
+        ms = clock_millis + us / 1000;
+#endif
+
+        return ms;
+    }
+
+#else
+
+    inline unsigned long readMillis() __attribute__((always_inline));
+    inline unsigned long readMillis()
+    {
+        return clock_millis;
+    }
+
+#endif
+};
+
+
 
 
 unsigned long millis()
 {
-    // Disable interrupts while we read timer0_millis or we might get an
-    // inconsistent value (e.g. in the middle of a write to timer0_millis)
-    unsigned long m;
+    // Disable interrupts while we read clock_millis or we might get an
+    // inconsistent value (e.g. in the middle of a write to clock_millis)
+    unsigned long ms;
 
     ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
     {
-        m = timer0_millis;
+        ms = readMillis();
+
+        // After adjustSystemClockMillis() with a negative value, millis() holds the value it had before, until
+        // the millisecond count has caught up again. So millis() never goes backwards.
+        if ( clock_millis_floor_active )
+        {
+            if ( static_cast<long>( ms - clock_millis_floor ) < 0 )
+            {
+                ms = clock_millis_floor;
+            }
+            else
+            {
+                clock_millis_floor_active = 0;
+            }
+        }
     }
 
-    return m;
+    return ms;
 }
 
 
@@ -106,23 +424,102 @@ unsigned long micros()
 {
     // Disable interrupts to avoid reading inconsistent values
     unsigned long m;
-    uint8_t t;
+    CounterType t;
 
     ATOMIC_BLOCK( ATOMIC_RESTORESTATE ) //Here, interrupts are disabled
     {
-        m = timer0_overflow_count;
-        t = TCNT0;
+        readCounter( m, t );
+    }
+
+    // The whole overflow-periods and the ticks of the actual period are converted separately. So the result is
+    // continuous (modulo 2^32), also if a tick is not a whole number of microseconds. At 16 MHz this is the same
+    // as ( (m << SC_COUNTER_BITS) + t ) * 4.
+    return m * kMicrosecondsPerOverflowWhole + multiplyHigh( m, kMicrosecondsPerOverflowFraction )
+           + microsecondsFromTicks( t );
+}
+
+
+
+
+#if SYSTEM_CLOCK_TICKLESS
+
+void setSystemClockAlarm( unsigned long us )
+{
+    unsigned long ticks = multiplyHigh( us, kTicksPerMicrosecondFraction );
+
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        unsigned long m;
+        CounterType t;
+        readCounter( m, t );
 
-        //TCNT0 is still counting. Therefore check, if TCNT0 just had an overflow. If so, increase the
-        //copy of timer0_overflow_count, because the interrupt-service-routine had not been executed yet, and has
-        //not yet increased timer0_overflow_count.
-        if ( ( TIFR0 & _BV(TOV0) ) && ( t < 255 ) )
+        unsigned long target = t + ticks;
+        alarmOverflowCount = m + ( target >> SC_COUNTER_BITS );
+        alarmTick = static_cast<CounterType>( target );
+
+        SC_TIMSK &= ~_BV(SC_OCIEA);
+        alarmState = kAlarmWaitingForOverflow;
+
+        // If an overflow is pending, the overflow-interrupt still arms the alarm.
+        if ( clock_overflow_count == alarmOverflowCount )
         {
-            m++;
+            armAlarm();
+        }
+    }
+}
+
+
+uint8_t isSystemClockAlarmExpired()
+{
+    return alarmState == kAlarmExpired;
+}
+
+
+void cancelSystemClockAlarm()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        SC_TIMSK &= ~_BV(SC_OCIEA);
+        alarmState = kAlarmOff;
+    }
+}
+
+#endif
+
+
+
+
+void adjustSystemClockMillis( long ms )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        if ( ms < 0 )
+        {
+            // millis() must not go backwards: it holds its actual value, until the count has caught up.
+            clock_millis_floor = millis();
+            clock_millis_floor_active = 1;
         }
+
+        // In tickless mode clock_millis is the millisecond count at the beginning of an overflow-period, so
+        // adding to it shifts all values returned by millis() later on.
+        clock_millis += ms;
     }
+}
+
+
 
-    return ( (m << 8) + t ) * ( 64 / clockCyclesPerMicrosecond() );
+
+void getSystemClockStatistics( SystemClockStatistics* statistics )
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        statistics->overflowInterrupts = clock_overflow_count;
+#if SYSTEM_CLOCK_TICKLESS
+        statistics->compareMatchInterrupts = clock_compare_match_count;
+#else
+        statistics->compareMatchInterrupts = 0;
+#endif
+    }
 }
 
 
@@ -145,150 +542,210 @@ void delayMilliseconds( unsigned long ms )
 
 
 
-// Delay for the given number of microseconds.  Assumes an 8 MHz, 12 MHz, or 16 MHz clock.
-void delayMicroseconds( unsigned int us )
+#if SYSTEM_CLOCK_TICKLESS
+
+void delayMillisecondsIdle( unsigned long ms )
 {
-    // Code adapted from wiring.c, Copyright (c) 2005-2006 David A. Mellis
+    set_sleep_mode( SLEEP_MODE_IDLE );
 
-    // Calling avrlib's delay_us() function with low values (e.g. 1 or
-    // 2 microseconds) gives delays longer than desired.
-    // delay_us( us);
+    while ( ms > 0 )
+    {
+        // The alarm takes microseconds as 32-bit-value. Split long delays into pieces of one minute.
+        unsigned long piece = ( ms > 60000 ) ? 60000 : ms;
+        ms -= piece;
 
-#if F_CPU == 16000000L
+        setSystemClockAlarm( piece * 1000 );
 
-    // For the 16 MHz clock on most Arduino boards.
+        // Sleep until the compare-match-interrupt of the alarm. Other interrupts (for example the
+        // overflow-interrupt) also wake the CPU up, then it goes to sleep again.
+        while ( 1 )
+        {
+            cli();
+            if ( isSystemClockAlarmExpired() )
+            {
+                sei();
+                break;
+            }
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+        }
+    }
+}
 
-    // 16 cycles = 1 us
+#else
 
-    // The overhead of the function call is 14 cycles for
-    // constant delay, 16 for variable delay, which is 1us
+void delayMillisecondsIdle( unsigned long ms )
+{
+    uint16_t start = static_cast<uint16_t>( micros() );
 
-    // For a one-microsecond delay, simply return
+    set_sleep_mode( SLEEP_MODE_IDLE );
 
-    // Takes 3 cycles if false, 4 cycles if true
-    if ( us <= 1 )
+    while ( ms > 0 )
     {
-        return;
+        // Interrupts are disabled while checking the time. Otherwise the overflow-interrupt could happen
+        // between checking the time and going to sleep, and we would sleep one overflow-period too long.
+        cli();
+
+        if ( ( static_cast<uint16_t>( micros() ) - start ) >= 1000 )
+        {
+            sei();
+            ms--;
+            start += 1000;
+        }
+        else if ( ms > kIdleBusyWaitMillis )
+        {
+            // The next interrupt (at the latest the next timer-overflow) wakes the CPU up again.
+            // sei() takes effect after the following instruction, so no interrupt is served before sleep_cpu().
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+        }
+        else
+        {
+            // The last milliseconds are busy-waited: The next overflow could come up to one overflow-period
+            // (1.024 ms at 16 MHz) too late.
+            sei();
+        }
     }
+}
 
-    // The timing loop takes 1/4 of a microsecond (4 cycles) per iteration
-    // So execute it four times for each microsecond of delay requested.
+#endif
 
-    // Multiply by 4; takes 4 cycles
-    us <<= 2;
 
-    // Account for the time taken in the preceeding commands.  We just
-    // burned 21 (23) cycles above, plus 2 cycles for the adjustment below.
-    // Total 23 (25) cycles, so remove 6 iterations, (6*4=24)
-    // us is at least 8 so we can substract 6
 
-    // Takes 2 cycles
-    us -= 6;
 
-#elif F_CPU == 12000000L
+void delayMillisecondsIdlePeripheralsOff( unsigned long ms )
+{
+    // Stop the clocks of all peripherals, except the clock of the system clock timer, and restore the
+    // Power-Reduction-Register(s) after the delay. Timers 3, 4 and 5 are in PRR1. Only the defined bits are set,
+    // the reserved bits keep their value. The clock of the ADC is only stopped, if the ADC is disabled (ADEN).
+    uint8_t adcBit = ( ADCSRA & _BV(ADEN) ) ? 0 : _BV(PRADC);
+#if defined(PRR0)
+    uint8_t prr0 = PRR0;
+    #if SYSTEM_CLOCK_TIMER <= 2
+    PRR0 = prr0 | adcBit | ( SC_PRR0_BITS & ~_BV( litecAvrName2( PRTIM, SYSTEM_CLOCK_TIMER ) ) );
+    #else
+    PRR0 = prr0 | adcBit | SC_PRR0_BITS;
+    #endif
+    #if defined(PRR1)
+    uint8_t prr1 = PRR1;
+        #if SYSTEM_CLOCK_TIMER <= 2
+    PRR1 = prr1 | SC_PRR1_BITS;
+        #else
+    PRR1 = prr1 | ( SC_PRR1_BITS & ~_BV( litecAvrName2( PRTIM, SYSTEM_CLOCK_TIMER ) ) );
+        #endif
+    #endif
+#else
+    uint8_t prr = PRR;
+    PRR = prr | adcBit | ( SC_PRR0_BITS & ~_BV( litecAvrName2( PRTIM, SYSTEM_CLOCK_TIMER ) ) );
+#endif
 
-    // For the 12 MHz clock of the Adafruit Trinket and others.
+    delayMillisecondsIdle( ms );
 
-    // 12 cycles - 1 us
+#if defined(PRR0)
+    PRR0 = prr0;
+    #if defined(PRR1)
+    PRR1 = prr1;
+    #endif
+#else
+    PRR = prr;
+#endif
+}
 
-    // The overhead of the function call is 14 (16) cycles, which is 1.5us
 
-    // For a 1 microsecond delay, simply return
 
-    // Takes 3 cycles if false, 4 cycles if true
-    if ( us <= 1 )
+
+namespace
+{
+    // Busy wait for 4 * loops clock cycles. loops must not be 0.
+    inline void busyWaitLoops( uint16_t loops ) __attribute__((always_inline));
+    inline void busyWaitLoops( uint16_t loops )
     {
-        return;
+        __asm__ __volatile__
+        (
+            "1: sbiw %0,1" "\n\t" // 2 cycles
+            "brne 1b" : "=w" (loops) : "0" (loops) // 2 cycles
+        );
     }
+};
 
-    // The timing loop takes 1/3 of a microsecond (4 cycles) per iteration
-    // So execute it three times for each microsecond of delay requested.
-
-    // Multiply by 3 (actually by 2 and add again); takes 5 cycles
-    us = (us << 1) + us;
-
-    // Account for the time taken in the preceeding commands.  We just
-    // burned 22 (24) cycles above, plus 2 cycles for the adjustment below.
-    // Total 24 (26) cycles, so remove 6 iterations, (6*4=24)
-    // us is at least 6 so at most we can substract 5 (us ==0 breaks the loop)
-    // Close enough....
-
-    // Takes 2 cycles
-    us -= 5;
-
-#elif F_CPU == 8000000L
 
-    // For the 8 MHz internal clock on the ATmega168
 
-    // 8 cycles = 1 us
+// Delay for the given number of microseconds. Works for any F_CPU.
+void delayMicrosecondsRuntime( unsigned int us )
+{
+    // The timing loop takes 4 cycles per iteration. This is the number of loop-iterations per microsecond as
+    // fixed-point number with 8 fractional bits, rounded to the nearest value. For 16 MHz this is exactly 4.0
+    // (1024), for 14.7456 MHz it is 3.6875 (944) instead of 3.6864, which is an error of 0.03%.
+    const unsigned long kLoopsPerMicrosecondQ8 = ( ( F_CPU * 64UL ) + 500000UL ) / 1000000UL;
 
-    // The overhead of the function call is 14 (16) cycles, which is 2us
+    // The cycles spent outside of the timing loop (call, multiplication, comparisons and return) are subtracted
+    // as whole loop-iterations.
+    const unsigned long kOverheadLoops = ( DELAY_MICROSECONDS_OVERHEAD_CYCLES + 2 ) / 4;
 
-    // For a 1 or 2 microsecond delay, simply return
+    unsigned long loops = ( static_cast<unsigned long>( us ) * kLoopsPerMicrosecondQ8 ) >> 8;
 
-    // Takes 3 cycles if false, 4 cycles if true
-    if ( us <= 2 )
+    // Delays shorter than the overhead simply return
+    if ( loops <= kOverheadLoops )
     {
         return;
     }
 
-    // The timing loop takes 1/2 of a microsecond (4 cycles) per iteration
-    // So execute it twice for each microsecond of delay requested.
-
-    // Multiply by 2; takes 2 cycles
-    us <<= 1;
-
-    // Account for the time taken in the preceeding commands.  We just
-    // burned 19 (21) cycles above, plus 2 cycles for the adjustment below.
-    // Total 21 (23) cycles, so remove 5 iterations, (5*4=20)
-    // us is at least 6 so at most we can substract 5
-    // Close enough....
+    loops -= kOverheadLoops;
 
-    // Takes 2 cycles
-    us -= 5;
-
-#else
-
-#error "delayMicroseconds() is only implemented for CPU speeds of 8 MHz, 12 MHz, or 16 MHz."
-
-#endif
+    // The loop-counter of the timing loop has 16 bits. Longer delays (for example more than 13 ms at 20 MHz)
+    // are split.
+    while ( loops > 0xFFFF )
+    {
+        busyWaitLoops( 0xFFFF );
+        loops -= 0xFFFF;
+    }
 
-    // Busy wait
-    __asm__ __volatile__
-    (
-        "1: sbiw %0,1" "\n\t" // 2 cycles
-        "brne 1b" : "=w" (us) : "0" (us) // 2 cycles
-    );
+    busyWaitLoops( static_cast<uint16_t>( loops ) );
 }
 
 
 
 
-void initTimer0AsSystemClock()
+void initSystemClock()
 {
     ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
     {
-        // Use Timer0 for the system clock, but configure it so it also supports
-        // fast hardware pwm (using phase-correct PWM would mean that Timer0
-        // overflowed half as often)
-
-        TCCR0A = 0;     // Clear all settings
-        TCCR0B = 0;     // Clear all settings
-        TIMSK0 = 0;     // Disable all interrupts
-        TCNT0  = 0;     // initialize counter value to 0
-
-        TCCR0A |= (1 << WGM01) | (1 << WGM00);
+        SC_TCCRA = 0;   // Clear all settings
+        SC_TCCRB = 0;   // Clear all settings
+        SC_TIMSK = 0;   // Disable all interrupts
+        SC_TCNT  = 0;   // initialize counter value to 0
+
+#if SYSTEM_CLOCK_TICKLESS
+        // Normal mode: OCRxA is not double-buffered, so the alarm can be programmed at any time.
+        // Hardware pwm on OCxA and OCxB is not available in this mode.
+#else
+        // Configure the 8-bit timer so it also supports fast hardware pwm (using phase-correct PWM would
+        // mean that the timer overflowed half as often)
+        SC_TCCRA |= (1 << SC_WGM1) | (1 << SC_WGM0);
+#endif
 
-        // set timer 0 prescale factor to 64
-        TCCR0B |= (1 << CS01) | (1 << CS00);
+        // set the prescale factor to 64
+        SC_TCCRB |= SC_CS_PRESCALER_64;
 
-        // enable timer 0 overflow interrupt
-        TIMSK0 |= (1 << TOIE0);
+        // enable the overflow interrupt
+        SC_TIMSK |= (1 << SC_TOIE);
 
         // Reset counters
-        timer0_overflow_count = 0;
-        timer0_millis = 0;
-        timer0_fract = 0;
+        clock_overflow_count = 0;
+        clock_millis = 0;
+        clock_millis_floor_active = 0;
+#if SYSTEM_CLOCK_TICKLESS
+        clock_millis_overflow_count = 0;
+        clock_fract_micros = 0;
+        clock_compare_match_count = 0;
+        alarmState = kAlarmOff;
+#else
+        clock_fract = 0;
+#endif
     }
 }
 
@@ -35,9 +35,10 @@
  *
  * To use these functions, include SystemClock.h in your source code and link against SystemClock.cpp.
  *
- * \note Linking against SystemClock.cpp installs a interrupt function on timer0.  This interrupt
- * routine is installed regardless of whether the system clock is actually initialized or not.
- * If you have other uses for timer0, do not use SystemClock functions and do not link against SystemClock.cpp.
+ * \note Linking against SystemClock.cpp installs a interrupt function on timer0 (or on the timer selected with
+ * `SYSTEM_CLOCK_TIMER`).  This interrupt routine is installed regardless of whether the system clock is actually
+ * initialized or not. If you have other uses for this timer, do not use SystemClock functions and do not link
+ * against SystemClock.cpp.
  *
  * Interrupts must globally be enabled using `sei();` from <avr/interrupt.h>
  */
@@ -47,6 +48,8 @@
 #ifndef SystemClock_h
 #define SystemClock_h
 
+#include <stdint.h>
+
 #ifndef F_CPU
     #error "F_CPU must be defined, to use the SystemClock-Module"
 #endif
@@ -56,18 +59,113 @@
 #define microsecondsToClockCycles( a )      ( (a) * clockCyclesPerMicrosecond() )
 
 
+/*!
+ * With this macro the hardware timer used for the system clock is selected: 0 or 2 for the 8-bit timers
+ * Timer0 and Timer2, and 1, 3, 4 or 5 for one of the 16-bit timers (Timer3, Timer4 and Timer5 only exist on the
+ * ATmega2560). The default is Timer0, like the Arduino-library.
+ *
+ * With a 16-bit timer the overflow interrupt happens 256 times less often, because the upper 8 bits of the
+ * tick-count come from the hardware. A system clock on a 16-bit timer always runs in tickless mode (see
+ * `SYSTEM_CLOCK_TICKLESS`).
+ *
+ * The macro must have the same value in all source files, so it is best defined on the command line of the
+ * compiler (for example `-DSYSTEM_CLOCK_TIMER=1`).
+ */
+#ifndef SYSTEM_CLOCK_TIMER
+#define SYSTEM_CLOCK_TIMER          0
+#endif
+
+#if SYSTEM_CLOCK_TIMER < 0 || SYSTEM_CLOCK_TIMER > 5
+    #error "SYSTEM_CLOCK_TIMER must be 0, 1, 2, 3, 4 or 5"
+#endif
+
+
+/*!
+ * With this macro the tickless mode of the system clock is turned on (non-zero value) or off (0).
+ *
+ * Without tickless mode, the Timer0-overflow-interrupt (every 1.024 ms at 16 MHz) counts the elapsed milliseconds,
+ * and Timer0 runs in fast-PWM-mode, so the PWM-pins OC0A and OC0B can still be used.
+ *
+ * In tickless mode, the overflow-interrupt only extends the 8-bit-counter TCNT0 by software. `millis()` and
+ * `micros()` are calculated from the counter, when they are called. Timer0 runs in normal mode, and its
+ * compare-match-channel A is used to generate an interrupt exactly at a scheduled time (see
+ * `setSystemClockAlarm()`). `delayMillisecondsIdle()` uses this alarm, so the CPU is woken up exactly when the delay
+ * is over. OC0A and OC0B can't be used as PWM-pins in tickless mode.
+ *
+ * The same applies to the timer selected with `SYSTEM_CLOCK_TIMER`.
+ */
+#ifndef SYSTEM_CLOCK_TICKLESS
+    #if SYSTEM_CLOCK_TIMER == 0 || SYSTEM_CLOCK_TIMER == 2
+    #define SYSTEM_CLOCK_TICKLESS       0
+    #else
+    #define SYSTEM_CLOCK_TICKLESS       1
+    #endif
+#endif
+
+#if !SYSTEM_CLOCK_TICKLESS && SYSTEM_CLOCK_TIMER != 0 && SYSTEM_CLOCK_TIMER != 2
+    #error "A system clock on a 16-bit timer only works in tickless mode (SYSTEM_CLOCK_TICKLESS 1)"
+#endif
+
+
+/*!
+ * Number of interrupts executed by the system clock, see `getSystemClockStatistics()`.
+ */
+struct SystemClockStatistics
+{
+    unsigned long overflowInterrupts;       //!< Number of overflow-interrupts since initialization
+    unsigned long compareMatchInterrupts;   //!< Number of alarm-interrupts (only in tickless mode)
+};
+
+
 /*!
  * \brief This function initializes a system clock that tracks elapsed milliseconds.
  *
- * The system clock uses timer0, so you cannot use timer0 for other functions if you
- * use the system clock functionality.
+ * The system clock uses timer0 (or the timer selected with `SYSTEM_CLOCK_TIMER`), so you cannot use this timer
+ * for other functions if you use the system clock functionality.
  *
- * \note Linking against SystemClock.cpp installs a interrupt function on timer0.  This interrupt
+ * \note Linking against SystemClock.cpp installs a interrupt function on this timer.  This interrupt
  * routine is installed regardless of whether the system clock is actually initialized or not.
- * If you have other uses for timer0, do not use SystemClock functions and do not link against SystemClock.cpp.
+ * If you have other uses for the timer, do not use SystemClock functions and do not link against SystemClock.cpp.
  */
 
-void initTimer0AsSystemClock();
+void initSystemClock();
+
+
+/*!
+ * \brief Initializes the system clock.
+ *
+ * This inline function is a synonym for initSystemClock(). It is kept for compatibility with existing code. If
+ * `SYSTEM_CLOCK_TIMER` selects another timer, this timer is used instead of Timer0.
+ */
+
+inline void initTimer0AsSystemClock()
+{ initSystemClock(); }
+
+
+/*!
+ * Number of clock cycles `delayMicrosecondsRuntime()` spends outside of its timing loop (function call,
+ * conversion from microseconds to loop-iterations, and return). These cycles are subtracted from the delay.
+ * The default 40 is an estimate from the expected instruction sequence, not measured on generated code. The real
+ * value depends on the compiler-version and -options: count the cycles of a call with a variable argument in a
+ * simulator (for example simavr), and define the result on the command line of the compiler.
+ */
+#ifndef DELAY_MICROSECONDS_OVERHEAD_CYCLES
+#define DELAY_MICROSECONDS_OVERHEAD_CYCLES      40
+#endif
+
+
+/*!
+ * \brief Delay a certain number of microseconds. This is the function for non-constant arguments.
+ *
+ * Normally `delayMicroseconds()` is used, which calls this function, if its argument is not a compile-time-constant.
+ * The number of loop-iterations per microsecond and the overhead-correction are calculated from F_CPU at
+ * compile-time, so this function works for every CPU-clock (for example 20 MHz, 18.432 MHz or 14.7456 MHz).
+ * Delays shorter than `DELAY_MICROSECONDS_OVERHEAD_CYCLES` return immediately.
+ *
+ * \arg \c us the number of microseconds to delay.
+ */
+
+void delayMicrosecondsRuntime( unsigned int us );
 
 
 /*!
@@ -75,12 +173,27 @@ void initTimer0AsSystemClock();
  * This function works independently of Timer0 (It is not necessary to call `initTimer0AsSystemClock()` before using
  * `delayMicroseconds`.
  *
+ * If `us` is a compile-time-constant (and optimization is turned on), the delay is cycle-exact: The number of
+ * clock-cycles is calculated from F_CPU by the compiler, and an inline delay-loop is generated. Otherwise the
+ * function `delayMicrosecondsRuntime()` is called, which subtracts an estimated overhead.
+ *
  * \arg \c us the number of microseconds to delay.
  *
- * \note This function only works for CPU clocks running at either 8 MHz, 12 MHz, or 16 MHz.
+ * \note Interrupts served during the delay prolong the delay.
  */
 
-void delayMicroseconds( unsigned int us );
+inline void delayMicroseconds( unsigned int us ) __attribute__((always_inline));
+inline void delayMicroseconds( unsigned int us )
+{
+#if defined(__OPTIMIZE__)
+    if ( __builtin_constant_p( us ) )
+    {
+        __builtin_avr_delay_cycles( ( static_cast<unsigned long long>( us ) * F_CPU + 500000ULL ) / 1000000ULL );
+        return;
+    }
+#endif
+    delayMicrosecondsRuntime( us );
+}
 
 
 /*!
@@ -94,6 +207,42 @@ void delayMicroseconds( unsigned int us );
 void delayMilliseconds( unsigned long ms );
 
 
+/*!
+ * \brief Delay a certain number of milliseconds, while the CPU sleeps in idle-mode.
+ *
+ * Same as `delayMilliseconds()`, but the CPU is put into idle-sleep-mode (`SLEEP_MODE_IDLE`) between the
+ * Timer0-overflow-interrupts, instead of permanently reading the time. The CPU only wakes up at each interrupt
+ * (every 1.024 ms at 16 MHz, or earlier, if another interrupt happens), checks the time, and goes to sleep again.
+ * The last milliseconds (one overflow-period rounded up: 2 at 16 MHz, 3 at 8 MHz) are busy-waited, so the delay is
+ * as exact as with `delayMilliseconds()`. In tickless mode the alarm wakes the CPU up exactly, and nothing is
+ * busy-waited.
+ *
+ * Note: initTimer0AsSystemClock() must have been called, and interrupts must be globally enabled
+ * before using this function. Interrupts are enabled when this function returns.
+ *
+ * \arg \c ms the number of milliseconds to delay.
+ */
+
+void delayMillisecondsIdle( unsigned long ms );
+
+
+/*!
+ * \brief Delay a certain number of milliseconds, while the CPU sleeps and unused peripherals are switched off.
+ *
+ * Same as `delayMillisecondsIdle()`, but during the delay the clocks of all peripherals except Timer0 are stopped
+ * using the Power-Reduction-Register(s) (PRR, or PRR0 and PRR1 on the ATmega2560). This further reduces the
+ * current consumption. After the delay, the Power-Reduction-Register(s) are restored. The ADC is only stopped, if
+ * it is disabled (ADEN in ADCSRA is 0), so an enabled ADC keeps working.
+ *
+ * ATTENTION: Only use this function, if no other peripheral has to work during the delay. For example a byte
+ * still being transmitted by a USART is truncated, and Timer/Counter1 stops counting.
+ *
+ * \arg \c ms the number of milliseconds to delay.
+ */
+
+void delayMillisecondsIdlePeripheralsOff( unsigned long ms );
+
+
 /*!
  * \brief Delay a certain number of milliseconds.
  *
@@ -137,4 +286,61 @@ unsigned long micros();
 unsigned long millis();
 
 
+/*!
+ * \brief Adds a number of milliseconds to the millisecond count returned by `millis()`.
+ *
+ * This is used to discipline `millis()` against a more accurate time-base, for example the RealTimeClock-module,
+ * or to account for the time spent in a sleep-mode, in which the system clock stops. Only `millis()` is changed,
+ * `micros()` keeps counting undisturbed, so it can still be used to measure short durations.
+ *
+ * \arg \c ms the number of milliseconds to add (negative to subtract).
+ */
+
+void adjustSystemClockMillis( long ms );
+
+
+/*!
+ * \brief Returns the number of interrupts, that the system clock has executed since it was initialized.
+ *
+ * Together with the execution time of one interrupt, this tells how much CPU-time the system clock needs.
+ *
+ * \arg \c statistics Pointer to a `SystemClockStatistics`-struct, which is filled in.
+ */
+
+void getSystemClockStatistics( SystemClockStatistics* statistics );
+
+
+#if SYSTEM_CLOCK_TICKLESS
+
+/*!
+ * \brief Schedules an alarm `us` microseconds from now (only available in tickless mode).
+ *
+ * The compare-match-interrupt of Timer0 is programmed to happen at the alarm-time, so the CPU is woken up from
+ * sleep exactly at this time. Use `isSystemClockAlarmExpired()` to check, if the alarm-time has been reached.
+ * There is only one alarm. Setting a new alarm replaces the old one. `delayMillisecondsIdle()` also uses this alarm.
+ *
+ * The resolution of the alarm is one Timer0-tick (4 microseconds at 16 MHz).
+ *
+ * \arg \c us the time until the alarm, in microseconds.
+ */
+
+void setSystemClockAlarm( unsigned long us );
+
+
+/*!
+ * \brief Returns non-zero, if the alarm set with `setSystemClockAlarm()` has expired.
+ */
+
+uint8_t isSystemClockAlarmExpired();
+
+
+/*!
+ * \brief Cancels the alarm set with `setSystemClockAlarm()`.
+ */
+
+void cancelSystemClockAlarm();
+
+#endif
+
+
 #endif
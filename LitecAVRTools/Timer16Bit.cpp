@@ -105,6 +105,31 @@ uint16_t TimerCounter16Bit::getTopValue()
 }
 
 
+int8_t TimerCounter16Bit::setFrequency( uint32_t hz, Timer16_mode mode, Timer16_Frequency* result )
+{
+    Timer16_Frequency f;
+    if ( hz == 0 || timer16CalculateFrequency( _t16SubCyclesFromHz( hz ), mode, result ? result : &f,
+                                               result != NULL ) != 0 )
+    {
+        return -1;
+    }
+    setFrequency( result ? *result : f );
+    return 0;
+}
+
+
+int8_t TimerCounter16Bit::setPeriodMicros( uint32_t us, Timer16_mode mode, Timer16_Frequency* result )
+{
+    Timer16_Frequency f;
+    if ( timer16CalculateFrequency( _t16SubCyclesFromMicros( us ), mode, result ? result : &f, result != NULL ) != 0 )
+    {
+        return -1;
+    }
+    setFrequency( result ? *result : f );
+    return 0;
+}
+
+
 void TimerCounter16Bit::setCompareMatchValue( Timer16_CompChannel channel, uint16_t compareMatchvalue )
 {
     switch (channel) {
@@ -219,3 +244,41 @@ void TimerCounter16Bit::forceOutputCompareMatch( Timer16_CompChannel channels)
 
     *m_tccrnc = tccrncValue;
 }
+
+
+int8_t timer16CalculateFrequency( uint32_t subCycles, Timer16_mode mode, Timer16_Frequency* result,
+                                  uint8_t withFrequencyAndError )
+{
+    if ( ! _t16HasVariableTop( mode ) || subCycles == 0 || subCycles > 0x80000000UL )
+    {
+        return -1;
+    }
+
+    //Try the prescalers from the smallest (highest resolution) to the largest. Only shifts, no divisions.
+    for ( uint8_t clockSource = T16_PRESC_1; clockSource <= T16_PRESC_1024; clockSource++ )
+    {
+        if ( _t16Fits( subCycles, mode, clockSource ) )
+        {
+            uint32_t ticks = _t16Ticks( subCycles, mode, clockSource );
+            uint32_t period = ticks << _t16Shift( mode, clockSource );
+
+            result->mode = mode;
+            result->clockSource = static_cast<Timer16_ClockSource>( clockSource );
+            result->top = static_cast<uint16_t>( ticks - 1 + _t16IsDualSlope( mode ) );
+            result->periodCycles = period;
+            result->frequencyHz = 0;
+            result->errorPpm = 0;
+
+            if ( withFrequencyAndError )
+            {
+                //The difference is at most half a timer-tick (16384 subCycles), so the product fits into 32 bits
+                result->frequencyHz = ( F_CPU + period / 2 ) / period;
+                result->errorPpm = static_cast<int32_t>( subCycles - ( period << 4 ) ) * 62500L
+                                   / static_cast<int32_t>( period );
+            }
+            return 0;
+        }
+    }
+
+    return -1;
+}
@@ -155,7 +155,213 @@ inline Timer16_Interrupts operator|(Timer16_Interrupts a, Timer16_Interrupts b)
 { return static_cast<Timer16_Interrupts>( static_cast<uint8_t>(a) | static_cast<uint8_t>(b) ); }
 
 
-//TODO: Add defines and functions for input-capture
+/*!
+ * Maximum error of the frequency, that `setFrequency` and `setPeriodMicros` accept, in parts per million (at least
+ * 10). For each prescaler (starting with the smallest one, which gives the highest resolution) the TOP-value is
+ * calculated. The first prescaler, for which the TOP-value fits into 16 bits, and for which the error is not larger
+ * than this limit, is used.
+ */
+#ifndef TIMER16_MAX_FREQUENCY_ERROR_PPM
+#define TIMER16_MAX_FREQUENCY_ERROR_PPM     10000
+#endif
+
+#if TIMER16_MAX_FREQUENCY_ERROR_PPM < 10
+    #error "TIMER16_MAX_FREQUENCY_ERROR_PPM must be at least 10"
+#endif
+
+
+/*!
+ * The result of the calculation of prescaler and TOP-value for a requested frequency or period. If the frequency
+ * can't be reached, `clockSource` is `T16_CLK_OFF`.
+ */
+struct Timer16_Frequency
+{
+    Timer16_mode mode;                  //!< The operating-mode, for which the values were calculated
+    Timer16_ClockSource clockSource;    //!< The prescaler, or T16_CLK_OFF, if the frequency can't be reached
+    uint16_t top;                       //!< The TOP-value
+    uint32_t periodCycles;              //!< The achieved period in CPU-clock-cycles
+    uint32_t frequencyHz;               //!< The achieved frequency, rounded to whole Hz
+    int32_t errorPpm;                   //!< Error of the achieved frequency in ppm (positive, if too high)
+};
+
+
+// private helper-functions for the frequency-calculation, used at compile-time and at runtime.
+// Requested periods are given in 1/16 CPU-clock-cycles ("subCycles"), so that the rounding of high frequencies to
+// whole clock-cycles doesn't hide their error. The longest possible period (2^27 cycles) still fits into 32 bits.
+// With C++11 they are constexpr. With an older standard (-std=gnu++98 is the default of avr-gcc 5) they are plain
+// inline-functions for the calculation at runtime, and only the compile-time-functions `timer16FrequencyFromHz` and
+// `timer16FrequencyFromMicros` are not available.
+#if __cplusplus >= 201103L
+#define T16_CONSTEXPR       constexpr
+#else
+#define T16_CONSTEXPR       inline
+#endif
+
+// 1 for the dual-slope modes (the timer counts up to TOP and down again), 0 for single-slope modes
+T16_CONSTEXPR uint8_t _t16IsDualSlope( Timer16_mode mode )
+{
+    return mode == T16_PWM_PHI_F_CORRECT_ICRN || mode == T16_PWM_PHI_F_CORRECT_OCRNA
+           || mode == T16_PWM_PHI_CORRECT_ICRN || mode == T16_PWM_PHI_CORRECT_OCRNA;
+}
+
+// 1 for the modes, in which the TOP-value is stored in OCRnA or ICRn
+T16_CONSTEXPR uint8_t _t16HasVariableTop( Timer16_mode mode )
+{
+    return _t16IsDualSlope( mode ) || mode == T16_CTC_OCRNA || mode == T16_CTC_ICRN
+           || mode == T16_FAST_PWM_ICRN || mode == T16_FAST_PWM_OCRNA;
+}
+
+// log2 of the prescaler of the clock-sources T16_PRESC_1 .. T16_PRESC_1024, plus one for dual-slope modes
+T16_CONSTEXPR uint8_t _t16Shift( Timer16_mode mode, uint8_t clockSource )
+{
+    return ( clockSource == T16_PRESC_1 ? 0 : clockSource == T16_PRESC_8 ? 3 : clockSource == T16_PRESC_64 ? 6
+             : clockSource == T16_PRESC_256 ? 8 : 10 ) + _t16IsDualSlope( mode );
+}
+
+// number of timer-clock-periods (dual slope: TOP, single slope: TOP+1), rounded to the nearest value
+T16_CONSTEXPR uint32_t _t16Ticks( uint32_t subCycles, Timer16_mode mode, uint8_t clockSource )
+{
+    return ( subCycles + ( 8UL << _t16Shift( mode, clockSource ) ) ) >> ( _t16Shift( mode, clockSource ) + 4 );
+}
+
+T16_CONSTEXPR uint32_t _t16AbsDiff( uint32_t a, uint32_t b )
+{
+    return a > b ? a - b : b - a;
+}
+
+// 1, if the ticks give a valid TOP-value (at least 3 in PWM-modes) and the error is within the limit.
+// The difference is at most half a timer-tick (16384 subCycles), so the product fits into 32 bits.
+T16_CONSTEXPR uint8_t _t16Fits( uint32_t subCycles, Timer16_mode mode, uint8_t clockSource )
+{
+    return _t16Ticks( subCycles, mode, clockSource ) <= ( _t16IsDualSlope( mode ) ? 0xFFFFUL : 0x10000UL )
+           && _t16Ticks( subCycles, mode, clockSource )
+                    >= ( ( mode == T16_CTC_OCRNA || mode == T16_CTC_ICRN ) ? 1UL : 4UL - _t16IsDualSlope( mode ) )
+           && _t16AbsDiff( _t16Ticks( subCycles, mode, clockSource ) << ( _t16Shift( mode, clockSource ) + 4 ),
+                           subCycles )
+                    * ( 1000000UL / TIMER16_MAX_FREQUENCY_ERROR_PPM ) <= subCycles;
+}
+
+#if __cplusplus >= 201103L
+
+constexpr Timer16_Frequency _t16Result( uint32_t subCycles, Timer16_mode mode, uint8_t clockSource,
+                                        uint32_t period )
+{
+    return Timer16_Frequency{ mode, static_cast<Timer16_ClockSource>( clockSource ),
+                              static_cast<uint16_t>( _t16Ticks( subCycles, mode, clockSource ) - 1
+                                                     + _t16IsDualSlope( mode ) ),
+                              period, ( F_CPU + period / 2 ) / period,
+                              static_cast<int32_t>( static_cast<int32_t>( subCycles - ( period << 4 ) ) * 62500L
+                                                    / static_cast<int32_t>( period ) ) };
+}
+
+constexpr Timer16_Frequency _t16Search( uint32_t subCycles, Timer16_mode mode, uint8_t clockSource )
+{
+    return clockSource > T16_PRESC_1024 || ! _t16HasVariableTop( mode ) || subCycles == 0
+                || subCycles > 0x80000000UL
+           ? Timer16_Frequency{ mode, T16_CLK_OFF, 0, 0, 0, 0 }
+           : _t16Fits( subCycles, mode, clockSource )
+             ? _t16Result( subCycles, mode, clockSource,
+                           _t16Ticks( subCycles, mode, clockSource ) << _t16Shift( mode, clockSource ) )
+             : _t16Search( subCycles, mode, clockSource + 1 );
+}
+
+
+/*!
+ * \brief Calculates prescaler and TOP-value for a frequency at compile-time.
+ *
+ * Use this function with constant arguments, then the compiler does the calculation, and no code is generated. Needs
+ * C++11 (`-std=gnu++11`).
+ * The result can be checked with `static_assert` and passed to `setFrequency`:
+ * ```C
+ * constexpr Timer16_Frequency pwm40kHz = timer16FrequencyFromHz( 40000, T16_PWM_PHI_F_CORRECT_ICRN );
+ * static_assert( pwm40kHz.clockSource != T16_CLK_OFF, "40 kHz can't be reached" );
+ * tc1.setFrequency( pwm40kHz );
+ * ```
+ *
+ * \arg \c hz The frequency of the timer-period (overflow- or compare-match-interrupts, PWM-frequency). In CTC-mode
+ *      with `T16_PIN_TOGGLE_ON_MATCH` the frequency on the pin is half this frequency.
+ * \arg \c mode The operating-mode. Only modes, in which the TOP-value is stored in OCRnA or ICRn, can be used.
+ */
+constexpr Timer16_Frequency timer16FrequencyFromHz( uint32_t hz, Timer16_mode mode )
+{
+    return _t16Search( hz == 0 ? 0 : static_cast<uint32_t>( ( F_CPU * 16ULL + hz / 2 ) / hz ), mode, T16_PRESC_1 );
+}
+
+
+/*!
+ * \brief Calculates prescaler and TOP-value for a period in microseconds at compile-time.
+ *
+ * \see `timer16FrequencyFromHz`
+ */
+constexpr Timer16_Frequency timer16FrequencyFromMicros( uint32_t us, Timer16_mode mode )
+{
+    return _t16Search( us > 0x08000000UL / ( F_CPU / 1000000UL + 1 )
+                       ? 0xFFFFFFFFUL
+                       : static_cast<uint32_t>( ( static_cast<uint64_t>( us ) * F_CPU * 16 + 500000ULL ) / 1000000ULL ),
+                       mode, T16_PRESC_1 );
+}
+
+
+#endif
+
+
+/*!
+ * \brief Calculates prescaler and TOP-value for a period at runtime.
+ *
+ * This is the runtime-variant of `timer16FrequencyFromHz`, used by the `setFrequency`- and
+ * `setPeriodMicros`-methods. The prescalers are tried with shifts, no division is needed. `frequencyHz` and
+ * `errorPpm` are only calculated, if `withFrequencyAndError` is non-zero (this needs two 32-bit-divisions).
+ *
+ * \arg \c subCycles The requested period in 1/16 CPU-clock-cycles.
+ *
+ * \returns 0 on success, or -1, if the period can't be reached with the given mode.
+ */
+int8_t timer16CalculateFrequency( uint32_t subCycles, Timer16_mode mode, Timer16_Frequency* result,
+                                  uint8_t withFrequencyAndError );
+
+// private: converts a frequency into 1/16 CPU-clock-cycles at runtime (one 32-bit-division).
+inline uint32_t _t16SubCyclesFromHz( uint32_t hz )
+{
+    #if F_CPU > 0x0FFFFFFFUL
+        #error "F_CPU is too high for the frequency-calculation"
+    #endif
+    return ( F_CPU * 16UL + hz / 2 ) / hz;
+}
+
+// private: converts microseconds into 1/16 CPU-clock-cycles at runtime. Returns a value, that is too large for any
+// timer-period, if the period is too long. If F_CPU is not a multiple of 1 MHz, the fraction of a clock-cycle per
+// microsecond is a fixed-point-number with 32 fractional bits, calculated at compile-time, so there is no division:
+// one 32x32->64-bit-multiplication and a shift. The error is below 0.05 1/16-cycles, so the result is the same as
+// with `timer16FrequencyFromMicros`, except for values very close to .5.
+inline uint32_t _t16SubCyclesFromMicros( uint32_t us )
+{
+    if ( us > 0x08000000UL / ( F_CPU / 1000000UL + 1 ) )
+    {
+        return 0xFFFFFFFFUL;
+    }
+    #if F_CPU % 1000000UL != 0
+    const uint32_t kFraction = static_cast<uint32_t>( ( ( static_cast<uint64_t>( F_CPU % 1000000UL ) << 32 )
+                                                        + 500000UL ) / 1000000UL );
+    return us * ( F_CPU / 1000000UL * 16 )
+           + static_cast<uint32_t>( ( static_cast<uint64_t>( us ) * kFraction + ( 1UL << 27 ) ) >> 28 );
+    #else
+    return us * ( F_CPU / 1000000UL * 16 );
+    #endif
+}
+
+
+/*!
+ * The edge on the ICPn-input-pin, that triggers an input-capture: The actual count-value (TCNTn) is copied into the
+ * ICRn-register, and the input-capture-interrupt-event occurs.
+ *
+ * The hex-value represents the ICESn-Bit in the TCCRnB-Register
+ */
+enum Timer16_CaptureEdge
+{
+    T16_CAPTURE_FALLING =  0x00,
+    T16_CAPTURE_RISING =   0x01
+};
+
 
 //////////////////////////////////////////////////////////////////////////
 // C++ class API
@@ -265,6 +471,45 @@ public:
     uint16_t getTopValue();
 
 
+    /*!
+     * Sets operating-mode, TOP-value and prescaler for the requested frequency, and starts the Timer/Counter.
+     *
+     * The prescalers are tried from 1 to 1024. The first prescaler, for which the TOP-value fits into 16 bits and
+     * the error is not larger than `TIMER16_MAX_FREQUENCY_ERROR_PPM`, is used. This gives the highest resolution
+     * for the compare-match-values. The calculation needs one 32-bit-division (two more, if `result` is given).
+     * For constant frequencies better use `timer16FrequencyFromHz`, which does the calculation at compile-time.
+     *
+     * \arg \c hz The frequency of the timer-period (overflow- or compare-match-interrupts, PWM-frequency).
+     *
+     * \arg \c mode The operating-mode. Only modes, in which the TOP-value is stored in OCRnA or ICRn, can be used.
+     *
+     * \arg \c result If not NULL, the calculated values, the achieved frequency and the error are stored here.
+     *
+     * \returns 0 on success, or -1, if the frequency can't be reached (then the Timer/Counter is not changed).
+     */
+    int8_t setFrequency( uint32_t hz, Timer16_mode mode, Timer16_Frequency* result = NULL );
+
+    /*!
+     * Same as `setFrequency`, but the period is given in microseconds.
+     */
+    int8_t setPeriodMicros( uint32_t us, Timer16_mode mode, Timer16_Frequency* result = NULL );
+
+    /*!
+     * Sets operating-mode, TOP-value and prescaler calculated by `timer16FrequencyFromHz` or
+     * `timer16FrequencyFromMicros`, and starts the Timer/Counter. Nothing is changed, if the clock-source is
+     * `T16_CLK_OFF`.
+     */
+    void setFrequency( const Timer16_Frequency& frequency )
+    {
+        if ( frequency.clockSource != T16_CLK_OFF )
+        {
+            setMode( frequency.mode );
+            setTopValue( frequency.top );
+            selectClockSource( frequency.clockSource );
+        }
+    }
+
+
     /*!
      * On an ATmega328p there are two compare-match-registers for generating interrupts or a PWM-Signal:
      * OCR1A and OCR1B. The ATmega2560 has three compare-match-registers for each timer: OCRnA, OCRnB and OCRnC.
@@ -294,6 +539,15 @@ public:
     uint16_t getCompareMatchValue( Timer16_CompChannel channel );
 
 
+    /*!
+     * Writes the compare-match-registers OCRnA and OCRnB one after the other (first OCRnA), without the
+     * function-call and the switch of `setCompareMatchValue()`. So the two writes take a short and constant time,
+     * which is needed by `HalfBridgePwm`.
+     */
+    void setCompareMatchValuesAB( uint16_t valueA, uint16_t valueB )
+    { *m_ocrna = valueA; *m_ocrnb = valueB; }
+
+
     /**
      * Chooses how the PWM-output-Pins associated with the 16-Bit-Timer/Counter behave.
      *
@@ -365,6 +619,37 @@ public:
     void clearPendingInterruptEvents( Timer16_Interrupts interruptEnableFlags )
     { *m_tifr |= ((uint8_t)interruptEnableFlags); }
 
+    /*!
+     * Selects the edge on the ICPn-pin, that triggers an input-capture. After changing the edge, a pending
+     * input-capture-interrupt-event is cleared, as required by the datasheet.
+     *
+     * Input-capture only works, if the ICRn-register is not used as TOP-value (see `Timer16_mode`).
+     *
+     * \arg \c edge `T16_CAPTURE_RISING` or `T16_CAPTURE_FALLING`
+     */
+    void setInputCaptureEdge( Timer16_CaptureEdge edge )
+    {
+        *m_tccrnb = ( *m_tccrnb & ~(1<<ICES1) ) | ( ((uint8_t)edge) << ICES1 );
+        *m_tifr = (1<<ICF1);
+    }
+
+    /*!
+     * Turns the noise-canceler of the ICPn-input-pin on (non-zero argument) or off (0). With the noise-canceler the
+     * level on the pin must be stable for four clock-cycles, before an edge is detected. This delays the capture by
+     * four clock-cycles.
+     */
+    void setInputCaptureNoiseCanceler( uint8_t on )
+    {
+        if ( on )   *m_tccrnb |= (1<<ICNC1);
+        else        *m_tccrnb &= ~(1<<ICNC1);
+    }
+
+    /*!
+     * Returns the count-value, that was captured at the last input-capture (content of register ICRn).
+     */
+    uint16_t getInputCaptureValue()
+    { return *m_icrn; }
+
 
 private:
 
@@ -400,4 +685,332 @@ private:
 #endif
 
 
+
+//////////////////////////////////////////////////////////////////////////
+// C++ template API (registers bound at compile-time)
+//////////////////////////////////////////////////////////////////////////
+
+/*!
+ * The registers of the 16-Bit-Timer/Counter number `no`. There is a specialization of this template for each
+ * 16-Bit-Timer/Counter of the microcontroller (1 on the ATmega328p, 1, 3, 4 and 5 on the ATmega2560). It is used by
+ * `TimerCounter16`.
+ */
+template< uint8_t no > struct Timer16Registers;
+
+#ifdef OCR1C
+#define _makeTimer16Registers( no )                                                 \
+    template<> struct Timer16Registers< no >                                        \
+    {                                                                               \
+        static volatile uint8_t&  tccrna() { return TCCR##no##A; }                  \
+        static volatile uint8_t&  tccrnb() { return TCCR##no##B; }                  \
+        static volatile uint8_t&  tccrnc() { return TCCR##no##C; }                  \
+        static volatile uint16_t& tcntn()  { return TCNT##no; }                     \
+        static volatile uint16_t& ocrna()  { return OCR##no##A; }                   \
+        static volatile uint16_t& ocrnb()  { return OCR##no##B; }                   \
+        static volatile uint16_t& ocrnc()  { return OCR##no##C; }                   \
+        static volatile uint16_t& icrn()   { return ICR##no; }                      \
+        static volatile uint8_t&  timsk()  { return TIMSK##no; }                    \
+        static volatile uint8_t&  tifr()   { return TIFR##no; }                     \
+    }
+#else
+#define _makeTimer16Registers( no )                                                 \
+    template<> struct Timer16Registers< no >                                        \
+    {                                                                               \
+        static volatile uint8_t&  tccrna() { return TCCR##no##A; }                  \
+        static volatile uint8_t&  tccrnb() { return TCCR##no##B; }                  \
+        static volatile uint8_t&  tccrnc() { return TCCR##no##C; }                  \
+        static volatile uint16_t& tcntn()  { return TCNT##no; }                     \
+        static volatile uint16_t& ocrna()  { return OCR##no##A; }                   \
+        static volatile uint16_t& ocrnb()  { return OCR##no##B; }                   \
+        static volatile uint16_t& icrn()   { return ICR##no; }                      \
+        static volatile uint8_t&  timsk()  { return TIMSK##no; }                    \
+        static volatile uint8_t&  tifr()   { return TIFR##no; }                     \
+    }
+#endif
+
+_makeTimer16Registers( 1 );
+#ifdef TCCR3A
+_makeTimer16Registers( 3 );
+#endif
+#ifdef TCCR4A
+_makeTimer16Registers( 4 );
+#endif
+#ifdef TCCR5A
+_makeTimer16Registers( 5 );
+#endif
+
+
+/*!
+ * The same API as `TimerCounter16Bit`, but the Timer/Counter is chosen at compile-time with the template-argument
+ * `no` (1 on the ATmega328p, 1, 3, 4 or 5 on the ATmega2560). All methods are static and inline, and the registers
+ * are accessed directly with their addresses, so an object of this class needs no RAM for pointers. If the
+ * arguments are constants, the switch-statements are evaluated by the compiler. For example
+ * `setCompareMatchValue( T16_COMP_B, value )` compiles to two `sts`-instructions.
+ *
+ * Use this class, if the number of the Timer/Counter is known at compile-time, especially in
+ * interrupt-service-routines. Use `TimerCounter16Bit`, if the Timer/Counter is chosen at runtime (for example when
+ * a pointer or reference to a Timer/Counter-object is passed to a function).
+ * ```C
+ * TimerCounter16< 1 > tc1;
+ * tc1.setMode( T16_FAST_PWM_ICRN );
+ * ```
+ *
+ * See the methods of `TimerCounter16Bit` for a description.
+ */
+template< uint8_t no >
+class TimerCounter16
+{
+public:
+
+    typedef Timer16Registers< no > Registers;
+
+    static void setMode( Timer16_mode mode )
+    {
+        Registers::tccrnb() = ( Registers::tccrnb() & ~( (1<<WGM13) | (1<<WGM12) ) )
+                              | ( ( ( ((uint8_t) mode) & 0x0C) >> 2 ) << WGM12 );
+        Registers::tccrna() = ( Registers::tccrna() & ~( (1<<WGM11) | (1<<WGM10) ) )
+                              | ( ( ((uint8_t) mode) & 0x03) << WGM10 );
+    }
+
+    static Timer16_mode getMode()
+    {
+        return (Timer16_mode) ( ( ( Registers::tccrna() >> WGM10 ) & 0x03 )
+                                | ( ((Registers::tccrnb()>>WGM12)<<2) & 0x0C ) );
+    }
+
+    static void selectClockSource( Timer16_ClockSource clkSource )
+    {
+        Registers::tccrnb() = ( Registers::tccrnb() & ~( (1<<CS12)|(1<<CS11)|(1<<CS10) ) )
+                              | ( ((uint8_t)clkSource) << CS10 );
+    }
+
+    static void setActualCountValue( uint16_t countValue )
+    { Registers::tcntn() = countValue; }
+
+    static uint16_t getActualCountValue()
+    { return Registers::tcntn(); }
+
+    static int8_t setTopValue( uint16_t topCountValue )
+    {
+        switch ( getMode() ) {
+
+            case T16_CTC_OCRNA:
+            case T16_PWM_PHI_F_CORRECT_OCRNA:
+            case T16_PWM_PHI_CORRECT_OCRNA:
+            case T16_FAST_PWM_OCRNA:
+                Registers::ocrna() = topCountValue;
+                return 0;
+
+            case T16_PWM_PHI_F_CORRECT_ICRN:
+            case T16_PWM_PHI_CORRECT_ICRN:
+            case T16_CTC_ICRN:
+            case T16_FAST_PWM_ICRN:
+                Registers::icrn() = topCountValue;
+                return 0;
+
+            default:
+                break;
+        }
+
+        return -1;
+    }
+
+    static uint16_t getTopValue()
+    {
+        switch ( getMode() ) {
+            case T16_CTC_OCRNA:
+            case T16_PWM_PHI_F_CORRECT_OCRNA:
+            case T16_PWM_PHI_CORRECT_OCRNA:
+            case T16_FAST_PWM_OCRNA:
+                return Registers::ocrna();
+
+            case T16_PWM_PHI_F_CORRECT_ICRN:
+            case T16_PWM_PHI_CORRECT_ICRN:
+            case T16_CTC_ICRN:
+            case T16_FAST_PWM_ICRN:
+                return Registers::icrn();
+
+            case T16_PWM_PHI_CORRECT_0XFF:
+            case T16_FAST_PWM_0xFF:
+                return 0x00FF;
+
+            case T16_PWM_PHI_CORRECT_0X1FF:
+            case T16_FAST_PWM_0X1FF:
+                return 0x01FF;
+
+            case T16_PWM_PHI_CORRECT_0X3FF:
+            case T16_FAST_PWM_0X3FF:
+                return 0x03FF;
+
+            default: //the other valid mode (normal mode) has 0xFFFF as its top-value
+                break;
+        }
+        return 0xFFFF;
+    }
+
+    static int8_t setFrequency( uint32_t hz, Timer16_mode mode, Timer16_Frequency* result = NULL )
+    {
+        Timer16_Frequency f;
+        if ( hz == 0 || timer16CalculateFrequency( _t16SubCyclesFromHz( hz ), mode, result ? result : &f,
+                                                   result != NULL ) != 0 )
+        {
+            return -1;
+        }
+        setFrequency( result ? *result : f );
+        return 0;
+    }
+
+    static int8_t setPeriodMicros( uint32_t us, Timer16_mode mode, Timer16_Frequency* result = NULL )
+    {
+        Timer16_Frequency f;
+        if ( timer16CalculateFrequency( _t16SubCyclesFromMicros( us ), mode, result ? result : &f,
+                                        result != NULL ) != 0 )
+        {
+            return -1;
+        }
+        setFrequency( result ? *result : f );
+        return 0;
+    }
+
+    static void setFrequency( const Timer16_Frequency& frequency )
+    {
+        if ( frequency.clockSource != T16_CLK_OFF )
+        {
+            setMode( frequency.mode );
+            setTopValue( frequency.top );
+            selectClockSource( frequency.clockSource );
+        }
+    }
+
+    static inline void setCompareMatchValue( Timer16_CompChannel channel, uint16_t compareMatchvalue )
+        __attribute__((always_inline))
+    {
+        switch (channel) {
+            case T16_COMP_A:
+                Registers::ocrna() = compareMatchvalue;
+                return;
+
+            case T16_COMP_B:
+                Registers::ocrnb() = compareMatchvalue;
+                return;
+
+            #ifdef OCR1C
+            case T16_COMP_C:
+                Registers::ocrnc() = compareMatchvalue;
+                return;
+            #endif
+
+            default:
+                break;
+        }
+    }
+
+    static inline uint16_t getCompareMatchValue( Timer16_CompChannel channel ) __attribute__((always_inline))
+    {
+        switch (channel) {
+            case T16_COMP_A:
+                return Registers::ocrna();
+
+            case T16_COMP_B:
+                return Registers::ocrnb();
+
+            #ifdef OCR1C
+            case T16_COMP_C:
+                return Registers::ocrnc();
+            #endif
+
+            default:
+                break;
+        }
+        return 0xFFFF; //should never get here
+    }
+
+    static void setPwmPinMode( Timer16_CompChannel channel, Timer16_PwmPinMode pwmPinMode )
+    {
+        uint8_t bitOffset = 0;    //position of the two COMnX[1..0] Bits in the TCCRnA-Register
+
+        switch (channel) {
+            case T16_COMP_A:
+                bitOffset = COM1A0;
+                break;
+
+            case T16_COMP_B:
+                bitOffset = COM1B0;
+                break;
+
+            #ifdef OCR1C
+            case T16_COMP_C:
+                bitOffset = COM1C0;
+                break;
+            #endif
+
+            default:
+                break; //should never get here
+        }
+
+        switch (pwmPinMode)
+        {
+            case T16_PIN_OFF:
+                Registers::tccrna() &= ~(0x03<<bitOffset);
+                return;
+
+            case T16_PIN_TOGGLE_ON_MATCH:
+                Registers::tccrna() = ( Registers::tccrna() & ~(0x03<<bitOffset) ) | (0x01<<bitOffset);
+                return;
+
+            case T16_PIN_CLEAR_ON_MATCH:
+            case T16_PIN_PWM_NORMAL:
+                Registers::tccrna() = ( Registers::tccrna() & ~(0x03<<bitOffset) ) | (0x02<<bitOffset);
+                return;
+
+            case T16_PIN_SET_ON_MATCH:
+            case T16_PIN_PWM_INVERTED:
+                Registers::tccrna() |= (0x03<<bitOffset);
+                return;
+
+            default:
+                break;
+        }
+    }
+
+    static void forceOutputCompareMatch( Timer16_CompChannel channels )
+    {
+        uint8_t tccrncValue = 0;
+
+        if (channels & T16_COMP_A)    tccrncValue |= (1<<FOC1A);
+        if (channels & T16_COMP_B)    tccrncValue |= (1<<FOC1B);
+        #ifdef OCR1C
+        if (channels & T16_COMP_C)    tccrncValue |= (1<<FOC1C);
+        #endif
+
+        Registers::tccrnc() = tccrncValue;
+    }
+
+    static void enableInterrupts( Timer16_Interrupts interruptEnableFlags )
+    { Registers::timsk() |= ((uint8_t)interruptEnableFlags); }
+
+    static void disableInterrupts( Timer16_Interrupts interruptEnableFlags )
+    { Registers::timsk() &= ~((uint8_t)interruptEnableFlags); }
+
+    //Writing a one clears an interrupt-flag, so no read-modify-write is used (it would clear all pending flags)
+    static void clearPendingInterruptEvents( Timer16_Interrupts interruptEnableFlags )
+    { Registers::tifr() = ((uint8_t)interruptEnableFlags); }
+
+    static void setInputCaptureEdge( Timer16_CaptureEdge edge )
+    {
+        Registers::tccrnb() = ( Registers::tccrnb() & ~(1<<ICES1) ) | ( ((uint8_t)edge) << ICES1 );
+        Registers::tifr() = (1<<ICF1);
+    }
+
+    static void setInputCaptureNoiseCanceler( uint8_t on )
+    {
+        if ( on )   Registers::tccrnb() |= (1<<ICNC1);
+        else        Registers::tccrnb() &= ~(1<<ICNC1);
+    }
+
+    static uint16_t getInputCaptureValue()
+    { return Registers::icrn(); }
+};
+
+
 #endif /* TIMER_16_BIT_H_ */
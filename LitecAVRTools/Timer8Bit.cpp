@@ -0,0 +1,160 @@
+/*
+    Timer8Bit.cpp - A Module for 8-Bit-Timer/Counters of AVR-Microcontrollers.
+
+    This is part of the LitecAVRTools-Library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <avr/io.h>
+
+#include "Timer8Bit.h"
+
+
+void TimerCounter8Bit::setMode( Timer8_mode mode )
+{
+    //Set the Timer/Counter-mode with the WGMn[2..0]-Bits
+    //The three WGM-Bits are split: WGMn2 is in TCCRnB, and WGMn1 and WGMn0 are in TCCRnA
+    *m_tccrnb &= ~(1<<WGM02);
+    *m_tccrnb |= ( ( ( ((uint8_t) mode) & 0x04) >> 2 ) << WGM02 );
+    *m_tccrna &= ~( (1<<WGM01) | (1<<WGM00) );
+    *m_tccrna |=  ( ( ((uint8_t) mode) & 0x03) << WGM00);
+}
+
+
+int8_t TimerCounter8Bit::selectClockSource( Timer8_ClockSource clkSource )
+{
+    //Timer/Counter2 is the one with the ASSR-register, it has other prescalers than Timer/Counter0
+    uint8_t cs = _t8ClockSelectBits( clkSource, m_assr != NULL );
+
+    if ( cs == 0x0F )
+    {
+        return -1;
+    }
+
+    //Set the Timer/Counter-Clock-Source with the CSn[2..0]-Bits
+    *m_tccrnb &= ~( (1<<CS02)|(1<<CS01)|(1<<CS00) );
+    *m_tccrnb |= ( cs << CS00 );
+    return 0;
+}
+
+
+int8_t TimerCounter8Bit::setTopValue( uint8_t topCountValue )
+{
+    switch ( getMode() ) {
+
+        case T8_CTC_OCRNA:
+        case T8_PWM_PHI_CORRECT_OCRNA:
+        case T8_FAST_PWM_OCRNA:
+            *m_ocrna = topCountValue;
+            return 0;
+
+        default:
+            break;
+    }
+
+    return -1;
+}
+
+
+uint8_t TimerCounter8Bit::getTopValue()
+{
+    switch ( getMode() ) {
+        case T8_CTC_OCRNA:
+        case T8_PWM_PHI_CORRECT_OCRNA:
+        case T8_FAST_PWM_OCRNA:
+            return *m_ocrna;
+
+        default: //the other valid modes have 0xFF as their top-value
+            break;
+    }
+    return 0xFF;
+}
+
+
+void TimerCounter8Bit::setPwmPinMode( Timer8_CompChannel channel, Timer8_PwmPinMode pwmPinMode )
+{
+    //position of the two COMnX[1..0] Bits in the TCCRnA-Register
+    uint8_t bitOffset = ( channel == T8_COMP_A ) ? COM0A0 : COM0B0;
+
+    switch (pwmPinMode)
+    {
+
+        case T8_PIN_OFF:
+            *m_tccrna &= ~(0x03<<bitOffset);
+            return;
+
+        case T8_PIN_TOGGLE_ON_MATCH:
+            *m_tccrna &= ~(0x03<<bitOffset);
+            *m_tccrna |= (0x01<<bitOffset);
+            return;
+
+        case T8_PIN_CLEAR_ON_MATCH:
+        case T8_PIN_PWM_NORMAL:
+            *m_tccrna &= ~(0x03<<bitOffset);
+            *m_tccrna |= (0x02<<bitOffset);
+            return;
+
+        case T8_PIN_SET_ON_MATCH:
+        case T8_PIN_PWM_INVERTED:
+            *m_tccrna |= (0x03<<bitOffset);
+            return;
+
+        default:
+            break;
+    }
+}
+
+
+void TimerCounter8Bit::forceOutputCompareMatch( Timer8_CompChannel channels )
+{
+    //The FOCnx-bits are in TCCRnB (together with the clock-select-bits), they are always read as 0
+    uint8_t focBits = 0;
+
+    if (channels & T8_COMP_A)    focBits |= (1<<FOC0A);
+    if (channels & T8_COMP_B)    focBits |= (1<<FOC0B);
+
+    *m_tccrnb |= focBits;
+}
+
+
+int8_t TimerCounter8Bit::setAsynchronousClock( Timer8_AsyncClock clock )
+{
+    if ( m_assr == NULL )
+    {
+        return -1;
+    }
+
+    #ifdef ASSR
+    //EXCLK must be written before AS2
+    *m_assr = ( *m_assr & ~( (1<<EXCLK) | (1<<AS2) ) ) | ( ((uint8_t)clock) & (1<<EXCLK) );
+    *m_assr |= ((uint8_t)clock);
+    #endif
+    return 0;
+}
+
+
+uint8_t TimerCounter8Bit::isAsynchronousUpdatePending()
+{
+    #ifdef ASSR
+    if ( m_assr != NULL )
+    {
+        return *m_assr & _T8_ASYNC_BUSY_FLAGS;
+    }
+    #endif
+    return 0;
+}
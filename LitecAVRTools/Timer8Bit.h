@@ -0,0 +1,541 @@
+/*
+    Timer8Bit.h - A Module for 8-Bit-Timer/Counters of AVR-Microcontrollers.
+
+    This is part of the LitecAVRTools-Library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMER_8_BIT_H_
+#define TIMER_8_BIT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/io.h>
+
+#include "GpioPinMacros.h"    //only needed for sfr8Ptr
+
+
+//////////////////////////////////////////////////////////////////////////
+// Macros used as parameters for functions/methods
+//////////////////////////////////////////////////////////////////////////
+
+/*!
+ * Operating-modes for the 8-Bit-Timer/Counters (Timer/Counter0 and Timer/Counter2). These modes define, how the
+ * Timer/Counter counts its internal Count-Value (TCNTn-Register) up and down.
+ * The hex-value represents the WGMn[2..0]-Bits in the TCCRnA and TCCRnB-Registers
+ */
+enum Timer8_mode
+{
+    T8_NORMAL =                        0x00,
+    T8_PWM_PHI_CORRECT_0XFF =          0x01,
+    T8_CTC_OCRNA =                     0x02,
+    T8_FAST_PWM_0XFF =                 0x03,
+    //Timer Mode 0x04 is reserved
+    T8_PWM_PHI_CORRECT_OCRNA =         0x05,
+    //Timer Mode 0x06 is reserved
+    T8_FAST_PWM_OCRNA =                0x07
+};
+
+/*!
+ * Clock-select-Values for the 8-Bit-Timer/Counters. The two 8-bit-Timer/Counters have different prescalers:
+ *
+ * - Timer/Counter0: f_osc/1, f_osc/8, f_osc/64, f_osc/256, f_osc/1024, or falling or rising edges on the T0-pin.
+ * - Timer/Counter2: f_osc/1, f_osc/8, f_osc/32, f_osc/64, f_osc/128, f_osc/256, f_osc/1024. There is no T2-pin,
+ *   but Timer/Counter2 can be clocked asynchronously by a watch-crystal (see `setAsynchronousClock`). Then the
+ *   prescaler divides the crystal-frequency.
+ *
+ * `T8_CLK_OFF` means, that the timer is stopped (not counting).
+ *
+ * The low nibble of the hex-value represents the CS0[2..0]-Bits in the TCCR0B-Register, the high nibble the
+ * CS2[2..0]-Bits in the TCCR2B-Register. 0xF means, that the clock-source is not available for this Timer/Counter.
+ */
+enum Timer8_ClockSource
+{
+    T8_CLK_OFF =           0x00,
+    T8_PRESC_1 =           0x11,
+    T8_PRESC_8 =           0x22,
+    T8_PRESC_32 =          0x3F,    //only Timer/Counter2
+    T8_PRESC_64 =          0x43,
+    T8_PRESC_128 =         0x5F,    //only Timer/Counter2
+    T8_PRESC_256 =         0x64,
+    T8_PRESC_1024 =        0x75,
+    T8_FALLING =           0xF6,    //only Timer/Counter0
+    T8_RISING =            0xF7     //only Timer/Counter0
+};
+
+/*!
+ * The clock of Timer/Counter2 (see `setAsynchronousClock`): the CPU-clock (`T8_ASYNC_OFF`), a 32768-Hz-watch-crystal
+ * between the pins TOSC1 and TOSC2 (`T8_ASYNC_CRYSTAL`), or an external clock-signal on TOSC1
+ * (`T8_ASYNC_EXTERNAL_CLOCK`).
+ *
+ * The hex-value represents the EXCLK- and AS2-Bits in the ASSR-Register
+ */
+enum Timer8_AsyncClock
+{
+    T8_ASYNC_OFF =             0x00,
+    T8_ASYNC_CRYSTAL =         0x20,
+    T8_ASYNC_EXTERNAL_CLOCK =  0x60
+};
+
+/*!
+ * There are two Compare-Match-Registers (OCRnA and OCRnB) with the PWM-output-pins OCnA and OCnB.
+ *
+ * The constants of this enum can be or'ed when referring to both channels.
+ */
+enum Timer8_CompChannel
+{
+    T8_COMP_A =        0x01,
+    T8_COMP_B =        0x02
+};
+
+//To be able to bitwise or Timer8_CompChannel-Constants
+inline Timer8_CompChannel operator|(Timer8_CompChannel a, Timer8_CompChannel b)
+{ return static_cast<Timer8_CompChannel>( static_cast<uint8_t>(a) | static_cast<uint8_t>(b) ); }
+
+
+/*!
+ * The modes of the output-pins OCnA and OCnB. They are the same as for the 16-Bit-Timer/Counters (see
+ * `Timer16_PwmPinMode`). `T8_PIN_TOGGLE_ON_MATCH` can only be used for the OCnA-pin in PWM-modes.
+ */
+enum Timer8_PwmPinMode
+{
+    T8_PIN_OFF =               0,
+    T8_PIN_TOGGLE_ON_MATCH =   1,
+    T8_PIN_CLEAR_ON_MATCH =    2,
+    T8_PIN_SET_ON_MATCH =      3,
+    T8_PIN_PWM_NORMAL =        4,
+    T8_PIN_PWM_INVERTED =      5
+};
+
+/*!
+ * Each 8-Bit-Timer/Counter has three Interrupt-Event-Sources, which can individually be enabled or disabled. The
+ * interrupt-vectors are `TIMERn_OVF_vect`, `TIMERn_COMPA_vect` and `TIMERn_COMPB_vect`.
+ *
+ * The constants of this enum can be or'ed when enabling or disabling more than one interrupt.
+ */
+enum Timer8_Interrupts
+{
+    T8_INT_OVERFLOW =          0x01,
+    T8_INT_COMP_MATCH_A =      0x02,
+    T8_INT_COMP_MATCH_B =      0x04
+};
+
+//To be able to bitwise or Timer8_Interrupts-Constants
+inline Timer8_Interrupts operator|(Timer8_Interrupts a, Timer8_Interrupts b)
+{ return static_cast<Timer8_Interrupts>( static_cast<uint8_t>(a) | static_cast<uint8_t>(b) ); }
+
+
+//Only for internal use: the CSn[2..0]-Bits of a clock-source, or 0x0F if it is not available
+inline uint8_t _t8ClockSelectBits( Timer8_ClockSource clkSource, uint8_t isTimer2 )
+{ return isTimer2 ? ( ((uint8_t)clkSource) >> 4 ) : ( ((uint8_t)clkSource) & 0x0F ); }
+
+//Only for internal use: all bits of ASSR, that show a pending update of an asynchronous register
+#ifdef ASSR
+#define _T8_ASYNC_BUSY_FLAGS    ( (1<<TCN2UB) | (1<<OCR2AUB) | (1<<OCR2BUB) | (1<<TCR2AUB) | (1<<TCR2BUB) )
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+// C++ class API
+//////////////////////////////////////////////////////////////////////////
+
+class TimerCounter8Bit
+{
+public:
+
+    /*!
+     * Constructor. Use the `makeTimerCounter8BitObject`-macro to create an object of this class.
+     * For example: Create an Object for Timer/Counter 2
+     * ```C
+     * TimerCounter8Bit myTimer = makeTimerCounter8BitObject( 2 );
+     * ```
+     */
+    TimerCounter8Bit(sfr8Ptr tccrna, sfr8Ptr tccrnb, sfr8Ptr tcntn, sfr8Ptr ocrna, sfr8Ptr ocrnb, sfr8Ptr timsk,
+            sfr8Ptr tifr, sfr8Ptr assr )
+            : m_tccrna(tccrna)
+            , m_tccrnb(tccrnb)
+            , m_tcntn(tcntn)
+            , m_ocrna(ocrna)
+            , m_ocrnb(ocrnb)
+            , m_timsk(timsk)
+            , m_tifr(tifr)
+            , m_assr(assr)
+    { /*empy */ }
+
+
+    /*!
+     * Sets the Timer/Counter mode: Normal-mode, CTC-mode, Fast-PWM modes or phase-correct-PWM modes.
+     *
+     * \arg \c mode The Timer/Counter operating-mode. Pass one of the constants from enum `Timer8_mode`
+     */
+    void setMode( Timer8_mode mode );
+
+    /*!
+     * Returns the actual Timer/Counter operating mode. The return-value is one of constants from enum `Timer8_mode`.
+     */
+    Timer8_mode getMode()
+    { return (Timer8_mode) ( ( ( *m_tccrna >> WGM00 ) & 0x03 ) | ( ((*m_tccrnb>>WGM02)<<2) & 0x04 ) ); }
+
+    /*!
+     * Selects the clock-source. With `T8_CLK_OFF` the clock is turned off, and the count-value stays constant.
+     *
+     * \arg \c clkSource The clock-source for the Timer/Counter. Use one of the enum-constants
+     *
+     * \returns 0 on success, or -1, if the clock-source is not available for this Timer/Counter (then the
+     *      clock-source is not changed).
+     */
+    int8_t selectClockSource( Timer8_ClockSource clkSource );
+
+    /**
+     * This method changes the value of the actual count-value of the Timer/Counter (register TCNTn).
+     */
+    void setActualCountValue( uint8_t countValue )
+    { *m_tcntn = countValue; }
+
+    /**
+     * Returns the actual count-value of the Timer/Counter (content of register TCNTn).
+     */
+    uint8_t getActualCountValue()
+    { return *m_tcntn; }
+
+    /*!
+     * In the modes `T8_CTC_OCRNA`, `T8_PWM_PHI_CORRECT_OCRNA` and `T8_FAST_PWM_OCRNA` the TOP-value is stored in
+     * the OCRnA-register. This method writes `topCountValue` to OCRnA in these modes. The mode must have been set
+     * with `setMode` before.
+     *
+     * \returns 0 on success, or -1, if the timer-mode has the fixed TOP-value 0xFF.
+     */
+    int8_t setTopValue( uint8_t topCountValue );
+
+    /*!
+     * Returns the TOP-Value of the Timer/Counter: the value in the OCRnA-Register or 0xFF.
+     */
+    uint8_t getTopValue();
+
+    /*!
+     * Writes the value into the compare-match-register OCRnA or OCRnB. In the modes with OCRnA as TOP-value, this
+     * also changes the TOP-value for `T8_COMP_A`.
+     *
+     * \arg \c channel `T8_COMP_A` or `T8_COMP_B`.
+     *
+     * \arg \c compareMatchValue The value written to the compare-match-register.
+     */
+    void setCompareMatchValue( Timer8_CompChannel channel, uint8_t compareMatchValue )
+    {
+        if ( channel == T8_COMP_A )  *m_ocrna = compareMatchValue;
+        else                         *m_ocrnb = compareMatchValue;
+    }
+
+    /*!
+     * Returns the value of the given compare-match-register (OCRnA or OCRnB).
+     */
+    uint8_t getCompareMatchValue( Timer8_CompChannel channel )
+    { return channel == T8_COMP_A ? *m_ocrna : *m_ocrnb; }
+
+    /**
+     * Chooses how the PWM-output-Pins OCnA and OCnB behave. The pin must also be set as an output, for example
+     * using `setGpioPinModeOutput()`.
+     *
+     * \arg \c channel `T8_COMP_A` or `T8_COMP_B`.
+     *
+     * \arg \c pwmPinMode Use one of the enum-constants that begin with `T8_PIN_` for this Parameter.
+     *
+     * \see `Timer16_PwmPinMode`
+     */
+    void setPwmPinMode( Timer8_CompChannel channel, Timer8_PwmPinMode pwmPinMode );
+
+    /*!
+     * Forces a compare-match to initialize the OCnA- or OCnB-pin, before the mode is changed to a PWM-mode (see
+     * `TimerCounter16Bit::forceOutputCompareMatch`).
+     *
+     * \arg \c channels A bitwise 'or' of the enum-constants `T8_COMP_A` and `T8_COMP_B`.
+     */
+    void forceOutputCompareMatch( Timer8_CompChannel channels );
+
+    /*!
+     * Enable one or more of the Interrupts of this 8-Bit-Timer-Counter.
+     *
+     * \arg \c interruptEnableFlags A bitwise 'or' of the enum-constants that begin with `T8_INT_`.
+     */
+    void enableInterrupts( Timer8_Interrupts interruptEnableFlags )
+    { *m_timsk |= ((uint8_t)interruptEnableFlags); }
+
+    /*!
+     * Disable one or more of the Interrupts of this 8-Bit-Timer-Counter.
+     *
+     * \arg \c interruptEnableFlags A bitwise 'or' of the enum-constants that begin with `T8_INT_`.
+     */
+    void disableInterrupts( Timer8_Interrupts interruptEnableFlags )
+    { *m_timsk &= ~((uint8_t)interruptEnableFlags); }
+
+    /*!
+     * Clears pending interrupt-Events of the timer.
+     *
+     * \arg \c interruptEnableFlags A bitwise or of the enum-constants that begin with `T8_INT_`.
+     */
+    void clearPendingInterruptEvents( Timer8_Interrupts interruptEnableFlags )
+    { *m_tifr = ((uint8_t)interruptEnableFlags); }
+
+    /*!
+     * Only Timer/Counter2: Selects its clock. With `T8_ASYNC_CRYSTAL` Timer/Counter2 is clocked by a
+     * 32768-Hz-watch-crystal, and keeps counting in the power-save sleep-mode.
+     *
+     * Switching the clock may corrupt the contents of TCNT2, OCR2A, OCR2B, TCCR2A and TCCR2B. So disable the
+     * interrupts of Timer/Counter2 first, then switch the clock, set all registers again, call
+     * `waitForAsynchronousUpdate`, clear pending interrupt-events and enable the interrupts.
+     *
+     * \returns 0 on success, or -1 for Timer/Counter0.
+     */
+    int8_t setAsynchronousClock( Timer8_AsyncClock clock );
+
+    /*!
+     * Only Timer/Counter2: If it is clocked asynchronously, a write to TCNT2, OCR2A, OCR2B, TCCR2A or TCCR2B takes
+     * up to two cycles of the asynchronous clock. This method returns non-zero, while such a write is pending
+     * (always 0 for Timer/Counter0).
+     */
+    uint8_t isAsynchronousUpdatePending();
+
+    /*!
+     * Only Timer/Counter2: waits until all pending writes to the asynchronous registers are done (see
+     * `isAsynchronousUpdatePending`). Before entering a sleep-mode after such a write, this is necessary.
+     */
+    void waitForAsynchronousUpdate()
+    { while ( isAsynchronousUpdatePending() ) { } }
+
+
+private:
+
+    sfr8Ptr m_tccrna;
+    sfr8Ptr m_tccrnb;
+    sfr8Ptr m_tcntn;
+    sfr8Ptr m_ocrna;
+    sfr8Ptr m_ocrnb;
+    sfr8Ptr m_timsk;
+    sfr8Ptr m_tifr;
+    sfr8Ptr m_assr;   //NULL for Timer/Counter0
+};
+
+
+//Only for internal use: the ASSR-Register of the Timer/Counter, or NULL
+#define _t8AssrPtr0     NULL
+#define _t8AssrPtr2     &ASSR
+
+/*!
+ * Use this macro to initialize a `TimerCounter8Bit`-Object.
+ *
+ * \arg \c no is the Number of the 8-Bit-Timer/Counter: 0 or 2.
+ *
+ * \see the constructor of `TimerCounter8Bit`
+ */
+#define makeTimerCounter8BitObject( no )    TimerCounter8Bit( &TCCR##no##A, &TCCR##no##B, &TCNT##no, &OCR##no##A, \
+                                                              &OCR##no##B, &TIMSK##no, &TIFR##no, _t8AssrPtr##no )
+
+
+
+//////////////////////////////////////////////////////////////////////////
+// C++ template API (registers bound at compile-time)
+//////////////////////////////////////////////////////////////////////////
+
+/*!
+ * The registers of the 8-Bit-Timer/Counter number `no` (0 or 2). It is used by `TimerCounter8`. `isTimer2` is 1 for
+ * Timer/Counter2, which has other prescalers and the asynchronous clock.
+ */
+template< uint8_t no > struct Timer8Registers;
+
+#define _makeTimer8Registers( no, timer2 )                                          \
+    template<> struct Timer8Registers< no >                                         \
+    {                                                                               \
+        static const uint8_t isTimer2 = timer2;                                     \
+        static volatile uint8_t&  tccrna() { return TCCR##no##A; }                  \
+        static volatile uint8_t&  tccrnb() { return TCCR##no##B; }                  \
+        static volatile uint8_t&  tcntn()  { return TCNT##no; }                     \
+        static volatile uint8_t&  ocrna()  { return OCR##no##A; }                   \
+        static volatile uint8_t&  ocrnb()  { return OCR##no##B; }                   \
+        static volatile uint8_t&  timsk()  { return TIMSK##no; }                    \
+        static volatile uint8_t&  tifr()   { return TIFR##no; }                     \
+    }
+
+#ifdef TCCR0A
+_makeTimer8Registers( 0, 0 );
+#endif
+#ifdef TCCR2A
+_makeTimer8Registers( 2, 1 );
+#endif
+
+
+/*!
+ * The same API as `TimerCounter8Bit`, but the Timer/Counter is chosen at compile-time with the template-argument
+ * `no` (0 or 2). All methods are static and inline, and the registers are accessed directly with their addresses.
+ * With constant arguments the compiler evaluates the switch-statements and the choice of the clock-select-bits, so
+ * for example `setCompareMatchValue( T8_COMP_B, value )` compiles to one `sts`-instruction.
+ * ```C
+ * TimerCounter8< 2 > tc2;
+ * tc2.setMode( T8_FAST_PWM_0XFF );
+ * ```
+ *
+ * See the methods of `TimerCounter8Bit` for a description.
+ */
+template< uint8_t no >
+class TimerCounter8
+{
+public:
+
+    typedef Timer8Registers< no > Registers;
+
+    static void setMode( Timer8_mode mode )
+    {
+        Registers::tccrnb() = ( Registers::tccrnb() & ~(1<<WGM02) ) | ( ( ( ((uint8_t) mode) & 0x04) >> 2 ) << WGM02 );
+        Registers::tccrna() = ( Registers::tccrna() & ~( (1<<WGM01) | (1<<WGM00) ) )
+                              | ( ( ((uint8_t) mode) & 0x03) << WGM00 );
+    }
+
+    static Timer8_mode getMode()
+    {
+        return (Timer8_mode) ( ( ( Registers::tccrna() >> WGM00 ) & 0x03 )
+                               | ( ((Registers::tccrnb()>>WGM02)<<2) & 0x04 ) );
+    }
+
+    static int8_t selectClockSource( Timer8_ClockSource clkSource )
+    {
+        uint8_t cs = _t8ClockSelectBits( clkSource, Registers::isTimer2 );
+        if ( cs == 0x0F )
+        {
+            return -1;
+        }
+        Registers::tccrnb() = ( Registers::tccrnb() & ~( (1<<CS02)|(1<<CS01)|(1<<CS00) ) ) | ( cs << CS00 );
+        return 0;
+    }
+
+    static void setActualCountValue( uint8_t countValue )
+    { Registers::tcntn() = countValue; }
+
+    static uint8_t getActualCountValue()
+    { return Registers::tcntn(); }
+
+    static int8_t setTopValue( uint8_t topCountValue )
+    {
+        switch ( getMode() ) {
+            case T8_CTC_OCRNA:
+            case T8_PWM_PHI_CORRECT_OCRNA:
+            case T8_FAST_PWM_OCRNA:
+                Registers::ocrna() = topCountValue;
+                return 0;
+
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    static uint8_t getTopValue()
+    {
+        switch ( getMode() ) {
+            case T8_CTC_OCRNA:
+            case T8_PWM_PHI_CORRECT_OCRNA:
+            case T8_FAST_PWM_OCRNA:
+                return Registers::ocrna();
+
+            default:
+                break;
+        }
+        return 0xFF;
+    }
+
+    static inline void setCompareMatchValue( Timer8_CompChannel channel, uint8_t compareMatchValue )
+        __attribute__((always_inline))
+    {
+        if ( channel == T8_COMP_A )  Registers::ocrna() = compareMatchValue;
+        else                         Registers::ocrnb() = compareMatchValue;
+    }
+
+    static inline uint8_t getCompareMatchValue( Timer8_CompChannel channel ) __attribute__((always_inline))
+    { return channel == T8_COMP_A ? Registers::ocrna() : Registers::ocrnb(); }
+
+    static void setPwmPinMode( Timer8_CompChannel channel, Timer8_PwmPinMode pwmPinMode )
+    {
+        //position of the two COMnX[1..0] Bits in the TCCRnA-Register
+        uint8_t bitOffset = ( channel == T8_COMP_A ) ? COM0A0 : COM0B0;
+
+        switch (pwmPinMode)
+        {
+            case T8_PIN_OFF:
+                Registers::tccrna() &= ~(0x03<<bitOffset);
+                return;
+
+            case T8_PIN_TOGGLE_ON_MATCH:
+                Registers::tccrna() = ( Registers::tccrna() & ~(0x03<<bitOffset) ) | (0x01<<bitOffset);
+                return;
+
+            case T8_PIN_CLEAR_ON_MATCH:
+            case T8_PIN_PWM_NORMAL:
+                Registers::tccrna() = ( Registers::tccrna() & ~(0x03<<bitOffset) ) | (0x02<<bitOffset);
+                return;
+
+            case T8_PIN_SET_ON_MATCH:
+            case T8_PIN_PWM_INVERTED:
+                Registers::tccrna() |= (0x03<<bitOffset);
+                return;
+
+            default:
+                break;
+        }
+    }
+
+    //The FOCnx-bits are in TCCRnB, they are always read as 0
+    static void forceOutputCompareMatch( Timer8_CompChannel channels )
+    {
+        uint8_t focBits = 0;
+
+        if (channels & T8_COMP_A)    focBits |= (1<<FOC0A);
+        if (channels & T8_COMP_B)    focBits |= (1<<FOC0B);
+
+        Registers::tccrnb() |= focBits;
+    }
+
+    static void enableInterrupts( Timer8_Interrupts interruptEnableFlags )
+    { Registers::timsk() |= ((uint8_t)interruptEnableFlags); }
+
+    static void disableInterrupts( Timer8_Interrupts interruptEnableFlags )
+    { Registers::timsk() &= ~((uint8_t)interruptEnableFlags); }
+
+    //Writing a one clears an interrupt-flag, so no read-modify-write is used (it would clear all pending flags)
+    static void clearPendingInterruptEvents( Timer8_Interrupts interruptEnableFlags )
+    { Registers::tifr() = ((uint8_t)interruptEnableFlags); }
+
+    #ifdef ASSR
+    static int8_t setAsynchronousClock( Timer8_AsyncClock clock )
+    {
+        if ( ! Registers::isTimer2 )
+        {
+            return -1;
+        }
+        //EXCLK must be written before AS2
+        ASSR = ( ASSR & ~( (1<<EXCLK) | (1<<AS2) ) ) | ( ((uint8_t)clock) & (1<<EXCLK) );
+        ASSR |= ((uint8_t)clock);
+        return 0;
+    }
+
+    static uint8_t isAsynchronousUpdatePending()
+    { return Registers::isTimer2 ? ( ASSR & _T8_ASYNC_BUSY_FLAGS ) : 0; }
+
+    static void waitForAsynchronousUpdate()
+    { while ( isAsynchronousUpdatePending() ) { } }
+    #endif
+};
+
+
+#endif /* TIMER_8_BIT_H_ */
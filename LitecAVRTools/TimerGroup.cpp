@@ -0,0 +1,98 @@
+/*
+    TimerGroup.cpp - Starts several 16-bit-Timer/Counters in the same clock-
+    cycle, each with its own phase-offset.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "TimerGroup.h"
+
+#include <avr/io.h>
+#include <util/atomic.h>
+
+
+
+
+int8_t TimerGroup::add( TimerCounter16Bit& timer, Timer16_ClockSource clockSource, uint16_t countValue )
+{
+    // External clocks (T16_FALLING, T16_RISING) don't come from the prescaler, they can't be synchronized
+    if ( m_count >= TIMER_GROUP_MAX_TIMERS || clockSource == T16_CLK_OFF || clockSource > T16_PRESC_1024 )
+    {
+        return -1;
+    }
+
+    m_timers[ m_count ] = &timer;
+    m_clockSources[ m_count ] = clockSource;
+    m_countValues[ m_count ] = countValue;
+    m_count++;
+    return 0;
+}
+
+
+
+
+int8_t TimerGroup::setCountValue( uint8_t index, uint16_t countValue )
+{
+    if ( index >= m_count )
+    {
+        return -1;
+    }
+    m_countValues[ index ] = countValue;
+    return 0;
+}
+
+
+
+
+void TimerGroup::start()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        // Hold the prescaler in reset: all Timer/Counters clocked by it are halted. With TSM set, PSRSYNC stays set.
+        GTCCR = (1<<TSM) | (1<<PSRSYNC);
+
+        for ( uint8_t i = 0; i < m_count; i++ )
+        {
+            m_timers[ i ]->setActualCountValue( m_countValues[ i ] );
+            m_timers[ i ]->selectClockSource( m_clockSources[ i ] );
+        }
+
+        // Release the prescaler, all Timer/Counters get their first clock in the same cycle
+        GTCCR = 0;
+    }
+}
+
+
+
+
+void TimerGroup::stop()
+{
+    ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+    {
+        GTCCR = (1<<TSM) | (1<<PSRSYNC);
+
+        for ( uint8_t i = 0; i < m_count; i++ )
+        {
+            m_timers[ i ]->selectClockSource( T16_CLK_OFF );
+        }
+
+        GTCCR = 0;
+    }
+}
@@ -0,0 +1,145 @@
+/*
+    TimerGroup.h - Starts several 16-bit-Timer/Counters in the same clock-
+    cycle, each with its own phase-offset.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*!
+ * \file
+ *
+ * \brief Include this file to start several 16-bit-Timer/Counters synchronously, for example for phase-shifted
+ * PWM-signals of a 3-phase-inverter.
+ *
+ * To use this class, include TimerGroup.h in your source code and link against TimerGroup.cpp and Timer16Bit.cpp.
+ *
+ * Starting the Timer/Counters one after the other with `selectClockSource()` leaves them out of phase by the time
+ * between the calls. This class uses the synchronization-mode of the prescaler: with the bits TSM and PSRSYNC in
+ * GTCCR the prescaler is held in reset, and all Timer/Counters, that are clocked from it, are halted. Then the
+ * count-values and clock-sources are set, and clearing GTCCR releases all Timer/Counters in the same clock-cycle.
+ *
+ * Example:
+ * ```C
+ * TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+ * TimerCounter16Bit tc3 = makeTimerCounter16BitObject( 3 );
+ * TimerGroup group;
+ *
+ * // ... set the modes, TOP- and compare-match-values of both Timer/Counters
+ * group.add( tc1, T16_PRESC_1, 0 );
+ * group.add( tc3, T16_PRESC_1, 400 );  // 400 timer-ticks ahead of tc1
+ * group.start();
+ * ```
+ *
+ * \note Timer/Counter0 is clocked from the same prescaler, so it is halted too during `start()` and `stop()` (a
+ * few microseconds). The SystemClock-module (`millis()`, `micros()`) loses this time.
+ */
+
+
+
+#ifndef TimerGroup_h
+#define TimerGroup_h
+
+#include <stdint.h>
+
+#include "Timer16Bit.h"
+
+
+/*!
+ * The maximum number of Timer/Counters in a group (4 on the ATmega2560: Timer/Counter1, 3, 4 and 5).
+ */
+#ifndef TIMER_GROUP_MAX_TIMERS
+#define TIMER_GROUP_MAX_TIMERS      4
+#endif
+
+
+/*!
+ * \brief A group of 16-bit-Timer/Counters, that are started and stopped in the same clock-cycle.
+ */
+class TimerGroup
+{
+public:
+
+    /*!
+     * Constructor. The group is empty.
+     */
+    TimerGroup()
+        : m_count( 0 )
+    { /*empty*/ }
+
+
+    /*!
+     * \brief Adds a Timer/Counter to the group. It is not started yet.
+     *
+     * \arg \c timer The Timer/Counter. Its mode, TOP-value and compare-match-values must be set before `start()`.
+     *      The object must exist as long as the group.
+     * \arg \c clockSource The clock-source, that `start()` selects (`T16_PRESC_1` .. `T16_PRESC_1024`).
+     * \arg \c countValue The count-value, with which the Timer/Counter starts. Timer/Counters with the same
+     *      prescaler and TOP-value keep the difference of their count-values, this is their phase-offset in
+     *      timer-ticks. In dual-slope-modes (phase-correct) the Timer/Counters start counting up, so only phase-offsets
+     *      up to half a period can be set.
+     *
+     * \returns 0 on success, or -1 if the group is full or the clock-source is not a prescaler.
+     */
+    int8_t add( TimerCounter16Bit& timer, Timer16_ClockSource clockSource, uint16_t countValue );
+
+
+    /*!
+     * \brief Changes the count-value, with which a Timer/Counter starts at the next `start()`.
+     *
+     * \arg \c index The index of the Timer/Counter in the group (0 for the first one added).
+     *
+     * \returns 0 on success, or -1 if `index` is too large.
+     */
+    int8_t setCountValue( uint8_t index, uint16_t countValue );
+
+
+    /*!
+     * \brief Halts all Timer/Counters, sets their count-values and clock-sources, and releases them in the same
+     * clock-cycle.
+     *
+     * Running Timer/Counters of the group are stopped and started again with the phase-offsets. This takes a few
+     * microseconds, during which the prescaler (and Timer/Counter0) is halted.
+     */
+    void start();
+
+
+    /*!
+     * \brief Stops all Timer/Counters of the group in the same clock-cycle. Their count-values stay unchanged.
+     */
+    void stop();
+
+
+    /*!
+     * Returns the number of Timer/Counters in the group.
+     */
+    uint8_t getCount() const
+    { return m_count; }
+
+
+private:
+
+    TimerCounter16Bit* m_timers[ TIMER_GROUP_MAX_TIMERS ];
+    Timer16_ClockSource m_clockSources[ TIMER_GROUP_MAX_TIMERS ];
+    uint16_t m_countValues[ TIMER_GROUP_MAX_TIMERS ];
+    uint8_t m_count;
+};
+
+
+#endif
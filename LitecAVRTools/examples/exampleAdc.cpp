@@ -0,0 +1,135 @@
+/*
+    exampleAdc - Test-Module for Adc.h and Adc.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Samples the analog inputs ADC0 .. ADC5 (PC0 .. PC5 on the ATmega328p)
+    1000 times per second, and measures the sample-rate and the CPU-load.
+
+    Timer/Counter1 runs in CTC-mode with a period of 1 millisecond. Its
+    compare-match B starts the sequence of the six channels. For one second
+    the main program takes all results out of the ring-buffers, and counts
+    the iterations of its loop. The loop-iterations are compared with the
+    iterations of a second without the ADC, which gives the CPU-load of the
+    interrupt-service-routine and of reading the results.
+
+    Then the same is done in free-running mode with ADC0 only, this is the
+    highest sample-rate. The results are put out via USART0 (9600 baud).
+*/
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "SystemClock.h"
+#include "Usart.h"
+#include "Timer16Bit.h"
+#include "Adc.h"
+
+
+const uint8_t channels[] = { 0, 1, 2, 3, 4, 5 };
+const uint8_t kChannelCount = sizeof( channels );
+
+TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+
+
+// Counts the loop-iterations during one second. If the ADC is running, all results are taken out of the
+// ring-buffers, counted and added.
+uint32_t runOneSecond( uint32_t* samples, uint32_t* sums )
+{
+    uint32_t iterations = 0;
+    unsigned long start = millis();
+
+    while ( millis() - start < 1000 )
+    {
+        for ( uint8_t i = 0; i < kChannelCount; i++ )
+        {
+            uint16_t value;
+            if ( adcRead( i, &value ) )
+            {
+                samples[ i ]++;
+                sums[ i ] += value;
+            }
+        }
+        iterations++;
+    }
+
+    return iterations;
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+
+    adcInit( ADC_REF_AVCC );
+
+    // 1 kHz: prescaler 8, 2000 timer-ticks. The compare-match B at count 0 starts each sequence.
+    tc1.setMode( T16_CTC_OCRNA );
+    tc1.setCompareMatchValuesAB( 1999, 0 );
+    tc1.selectClockSource( T16_PRESC_8 );
+
+    sei();
+
+    while ( 1 )
+    {
+        uint32_t samples[ kChannelCount ] = { 0 };
+        uint32_t sums[ kChannelCount ] = { 0 };
+
+        // Without the ADC
+        adcStop();
+        uint32_t idleIterations = runOneSecond( samples, sums );
+
+        // Six channels, triggered by Timer/Counter1
+        adcSetSequence( channels, kChannelCount );
+        adcStart( ADC_TRIGGER_TIMER1_COMPB );
+        adcGetOverruns();
+        uint32_t iterations = runOneSecond( samples, sums );
+        adcStop();
+
+        usart0.usartPrintf( "6 channels at 1 kHz: CPU-load %lu per mille, %u overruns\r\n",
+                            1000 - iterations * 1000 / idleIterations, adcGetOverruns() );
+        for ( uint8_t i = 0; i < kChannelCount; i++ )
+        {
+            usart0.usartPrintf( "  ADC%u: %lu samples/s, mean %lu\r\n",
+                                channels[ i ], samples[ i ], samples[ i ] ? sums[ i ] / samples[ i ] : 0 );
+            samples[ i ] = 0;
+            sums[ i ] = 0;
+        }
+
+        // One channel in free-running mode
+        adcSetSequence( channels, 1 );
+        adcStart( ADC_TRIGGER_FREE_RUNNING );
+        adcGetOverruns();
+        iterations = runOneSecond( samples, sums );
+        adcStop();
+
+        usart0.usartPrintf( "free-running ADC0: %lu samples/s (max. %lu), CPU-load %lu per mille, %u overruns\r\n",
+                            samples[ 0 ], static_cast<uint32_t>( ADC_MAX_SAMPLE_RATE ),
+                            1000 - iterations * 1000 / idleIterations, adcGetOverruns() );
+
+        usart0.usartPrintf( "single conversion of ADC0: %d\r\n\r\n", adcConvert( 0 ) );
+        delay( 5000 );
+    }
+}
@@ -0,0 +1,82 @@
+/*
+    exampleCounter32 - Test-Module for Counter32.h and Counter32.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    An event-counter: The pulses of a signal (for example of an energy-meter
+    or a function-generator up to several MHz) are connected to the
+    clock-input T1 (PD5 on the ATmega328p, PD6 on the ATmega2560) and
+    counted on their rising edge.
+
+    Once per second, the total count and the number of pulses in the last
+    second are put out via USART0 (9600 baud). Each time another 1000000
+    pulses are counted, the LED on PB5 (Arduino Uno) is toggled by the
+    target-callback.
+*/
+
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "Counter32.h"
+
+
+const uint32_t kTargetStep = 1000000UL;
+uint32_t target = kTargetStep;
+
+
+void targetReached()
+{
+    toggleGpioPin( GpioPin( B, 5 ) );
+
+    // The next target. If the pulses are so fast, that it is already reached, skip it.
+    do
+    {
+        target += kTargetStep;
+    } while ( counter32SetTarget( target, targetReached ) );
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    setGpioPinModeOutput( GpioPin( B, 5 ) );
+
+    initSystemClock();
+    counter32Init( T16_RISING );
+    counter32SetTarget( target, targetReached );
+    sei();
+
+    uint32_t lastCount = 0;
+
+    while ( 1 )
+    {
+        delayMilliseconds( 1000 );
+
+        uint32_t count = counter32Read();
+        usart0.usartPrintf( "count: %lu   last second: %lu\r\n", count, count - lastCount );
+        lastCount = count;
+    }
+}
@@ -0,0 +1,95 @@
+/*
+    exampleDdsGenerator - Test-Module for DdsGenerator.h and DdsGenerator.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Compile all source-files with the option -DDDS_VOICES=4.
+
+    The PWM-signal appears on OC1A (PB1 on the ATmega328p). Connect a
+    low-pass-filter (for example 1 kOhm and 10 nF) and an amplifier with a
+    speaker, or an oscilloscope.
+
+    Three voices play the chord A-major (440 Hz, 554.37 Hz and 659.26 Hz
+    with sine-waves, the frequencies are calculated at compile-time). The
+    fourth voice is a quiet triangle-wave, whose frequency sweeps between
+    100 Hz and 2000 Hz. The frequency is changed every 5 milliseconds without
+    a jump in the signal. Every two seconds the waveform of the first voice
+    changes (sine, square, sawtooth).
+*/
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "DdsGenerator.h"
+
+#if DDS_VOICES != 4
+    #error "Compile with -DDDS_VOICES=4"
+#endif
+
+
+const int8_t* const waveforms[ 3 ] = { ddsSineTable, ddsSquareTable, ddsSawtoothTable };
+
+
+int main()
+{
+    initSystemClock();
+
+    ddsInit();
+    setGpioPinModeOutput( GpioPin( B, 1 ) );
+    sei();
+
+    ddsSetPhaseIncrement( 0, DDS_PHASE_INCREMENT( 440.0 ) );
+    ddsSetPhaseIncrement( 1, DDS_PHASE_INCREMENT( 554.37 ) );
+    ddsSetPhaseIncrement( 2, DDS_PHASE_INCREMENT( 659.26 ) );
+    ddsSetAmplitude( 0, 255 );
+    ddsSetAmplitude( 1, 255 );
+    ddsSetAmplitude( 2, 255 );
+
+    ddsSetWaveform( 3, ddsTriangleTable );
+    ddsSetAmplitude( 3, 96 );
+
+    uint16_t sweep = 100;
+    int8_t direction = 1;
+    uint8_t waveform = 0;
+    unsigned long lastSweep = millis();
+    unsigned long lastWaveform = millis();
+
+    while ( 1 )
+    {
+        if ( millis() - lastSweep >= 5 )
+        {
+            lastSweep += 5;
+            sweep += direction * 5;
+            if ( sweep <= 100 || sweep >= 2000 )
+            {
+                direction = -direction;
+            }
+            ddsSetFrequency( 3, sweep );
+        }
+
+        if ( millis() - lastWaveform >= 2000 )
+        {
+            lastWaveform += 2000;
+            waveform = ( waveform + 1 ) % 3;
+            ddsSetWaveform( 0, waveforms[ waveform ] );
+        }
+    }
+}
@@ -0,0 +1,124 @@
+/*
+    exampleEventTrace.cpp - Example/Test for the EventTrace-module consisting
+    of EventTrace.h and EventTrace.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Timer/Counter1 runs in normal mode with prescaler 1, so the timestamps of
+    the events count clock-cycles. Connect a push-button between PD2 and GND.
+
+    First the number of clock-cycles needed to write one event is measured
+    and put out as text via USART0 (115200 baud). Then the following events
+    are traced and transmitted as binary frames:
+    - ID 1: INT0-interrupt (button at PD2), payload: the state of PORTB
+    - ID 2: Timer1-overflow-interrupt (every 4.096 ms at 16 MHz), payload: an
+            overflow-counter
+    - ID 3: the main loop has toggled PB0, payload: 0 or 1
+
+    Save the received bytes to a file and decode it with
+    python3 tools/decodeEventTrace.py dump.bin --tick-us 0.0625
+*/
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "ExternalInterrupts.h"
+#include "Timer16Bit.h"
+#include "Usart.h"
+#include "EventTrace.h"
+
+#define buttonPin       GpioPin( D, 2 )
+#define ledPin          GpioPin( B, 0 )
+
+enum
+{
+    kEventInt0 = 1,
+    kEventTimer1Overflow = 2,
+    kEventLedToggled = 3
+};
+
+TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+
+volatile uint8_t overflowCount;
+
+
+ISR( INT0_vect )
+{
+    EVENT_TRACE_FROM_ISR( kEventInt0, PORTB );
+}
+
+
+ISR( TIMER1_OVF_vect )
+{
+    EVENT_TRACE_FROM_ISR( kEventTimer1Overflow, ++overflowCount );
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 115200 );
+
+    setGpioPinModeInputPullup( buttonPin );
+    setGpioPinModeOutput( ledPin );
+
+    tc1.setMode( T16_NORMAL );
+    tc1.selectClockSource( T16_PRESC_1 );
+
+    // Measure the clock-cycles for writing one event: the difference of two timestamps with and without an
+    // event in between.
+    eventTraceInit();
+    cli();
+    uint16_t t0 = TCNT1;
+    uint16_t t1 = TCNT1;
+    EVENT_TRACE_FROM_ISR( 0, 0 );
+    uint16_t t2 = TCNT1;
+    EVENT_TRACE( 0, 0 );
+    uint16_t t3 = TCNT1;
+    sei();
+
+    usart0.usartPrintf( "EVENT_TRACE_FROM_ISR: %u cycles, EVENT_TRACE: %u cycles\r\n",
+                        ( t2 - t1 ) - ( t1 - t0 ), ( t3 - t2 ) - ( t1 - t0 ) );
+
+    eventTraceInit();
+
+    setExtIntEventType( 0, EXTINT_FALLING_EDGE );
+    clearPendingExtIntEvent( 0 );
+    enableExtInt( 0 );
+    tc1.clearPendingInterruptEvents( T16_INT_OVERFLOW );
+    tc1.enableInterrupts( T16_INT_OVERFLOW );
+
+    uint8_t lastToggle = 0;
+    uint8_t led = 0;
+
+    while ( 1 )
+    {
+        // toggle the LED about every 20 Timer1-overflows
+        if ( static_cast<uint8_t>( overflowCount - lastToggle ) >= 20 )
+        {
+            lastToggle = overflowCount;
+            led = !led;
+            writeGpioPinDigital( ledPin, led );
+            EVENT_TRACE( kEventLedToggled, led );
+        }
+
+        eventTraceDrain( usart0 );
+    }
+}
@@ -0,0 +1,124 @@
+/*
+    exampleExtInt_Dispatch.cpp - Test-Module for ExternalInterrupts.h/.cpp
+    and ExternalInterruptsDispatch.cpp
+
+    This is part of the LitecAVRTools-Library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+Measures the time from an external Interrupt-Event to the first instruction
+of the handler, for a function registered with `attach()` (INT0) and for a
+handler bound at compile-time with `EXTINT_BIND_HANDLER` (INT1).
+
+For the ATmega328p. Compile all source-files with
+-DEXTINT_DISPATCH_MASK=0x01, so that ExternalInterruptsDispatch.cpp
+contains only the Interrupt-Service-Routine for INT0.
+
+Nothing has to be connected: the pins INT0 (PD2) and INT1 (PD3) are
+outputs, and the program toggles them by writing to PIND. External
+Interrupts are also triggered by outputs. Timer/Counter1 counts the
+clock-cycles. The main program reads TCNT1 and toggles the pin, the
+handler reads TCNT1 again. The difference is put out via USART0 (9600 baud).
+
+It contains a few clock-cycles for reading TCNT1, writing PIND and the
+synchronization of the pin (about 5), so the latencies are a little
+smaller. The difference between the two numbers is the cost of the
+table-dispatch.
+*/
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "ExternalInterrupts.h"
+
+
+volatile uint16_t handlerTime;
+volatile uint8_t handlerDone;
+
+
+//Registered with attach(): called through the table of function-pointers
+void onInt0( void* )
+{
+    handlerTime = TCNT1;
+    handlerDone = 1;
+}
+
+
+//Bound at compile-time: the code is put directly into the
+//Interrupt-Service-Routine
+static inline void onInt1()
+{
+    handlerTime = TCNT1;
+    handlerDone = 1;
+}
+
+EXTINT_BIND_HANDLER( 1, onInt1 )
+
+
+uint16_t measure( uint8_t pinMask )
+{
+    handlerDone = 0;
+
+    uint16_t start = TCNT1;
+    PIND = pinMask;             //toggles the pin: an Interrupt-Event
+
+    while ( ! handlerDone )
+    { }
+
+    return handlerTime - start;
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+
+    //Timer/Counter1 counts clock-cycles
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+
+    setGpioPinModeOutput( GpioPin( D, 2 ) );
+    setGpioPinModeOutput( GpioPin( D, 3 ) );
+
+    ExtInt extInt0 = ExtInt( 0, EXTINT_ANY_EDGE );
+    ExtInt extInt1 = ExtInt( 1, EXTINT_ANY_EDGE );
+    extInt0.attach( onInt0 );
+    extInt0.clearPendingEvent();
+    extInt1.clearPendingEvent();
+    extInt0.enable();
+    extInt1.enable();
+
+    sei();
+
+    while (1)
+    {
+        uint16_t dispatched = measure( _BV(PD2) );
+        uint16_t bound = measure( _BV(PD3) );
+
+        usart0.usartPrintf( "attach(): %u cycles   EXTINT_BIND_HANDLER: %u cycles\r\n", dispatched, bound );
+        delay( 1000 );
+    }
+}
@@ -0,0 +1,149 @@
+/*
+    exampleExtInt_Timestamp.cpp - Test-Module for ExternalInterrupts.h/.cpp
+    and ExternalInterruptsTimestamp.cpp
+
+    This is part of the LitecAVRTools-Library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+Compares the timestamps of ExternalInterruptsTimestamp.cpp with `micros()`
+read in a handler. For the ATmega328p. Compile all source-files with
+-DEXTINT_TIMESTAMP_MASK=0x01 -DEXTINT_DISPATCH_MASK=0x02, and link
+ExternalInterrupts.cpp, ExternalInterruptsDispatch.cpp,
+ExternalInterruptsTimestamp.cpp, Counter32.cpp, Timer16Bit.cpp,
+SystemClock.cpp and Usart.cpp.
+
+Connect OC1B (PB2) to INT0 (PD2) and to INT1 (PD3).
+
+Counter32 counts clock-cycles with Timer/Counter1. Its compare-match-unit B
+toggles OC1B at a known count-value, a random time after the main program
+has set it up, so the exact time of each edge is known. INT0 captures a
+timestamp, INT1 calls a function, that reads `micros()`. While waiting,
+the main program keeps the CPU busy, like a real application. After 500
+edges the smallest and largest error of both methods are put out in
+clock-cycles via USART0 (9600 baud).
+
+The difference between the largest and the smallest error is the jitter.
+If the smallest error of the timestamps is not 0, add it to
+EXTINT_TIMESTAMP_LATENCY. (micros() has a constant offset too, because
+INT1 is executed after INT0.)
+*/
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "Counter32.h"
+#include "ExternalInterrupts.h"
+
+
+volatile uint8_t int1Done;
+volatile unsigned long int1Micros;
+
+
+void onInt1( void* )
+{
+    int1Micros = micros();
+    int1Done = 1;
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+    counter32Init( T16_PRESC_1 );
+
+    //Counter32 uses only the compare-match-unit A of Timer/Counter1: toggle OC1B at compare-match B
+    TCCR1A |= _BV(COM1B0);
+    setGpioPinModeOutput( GpioPin( B, 2 ) );
+
+    ExtInt extInt0 = ExtInt( 0, EXTINT_ANY_EDGE );
+    ExtInt extInt1 = ExtInt( 1, EXTINT_ANY_EDGE );
+    extInt1.attach( onInt1 );
+    extInt0.clearPendingEvent();
+    extInt1.clearPendingEvent();
+    extInt0.enable();
+    extInt1.enable();
+
+    sei();
+
+    uint16_t random = 1;
+
+    while (1)
+    {
+        int32_t timestampMin = 0x7FFFFFFFL;
+        int32_t timestampMax = -0x7FFFFFFFL;
+        int32_t microsMin = 0x7FFFFFFFL;
+        int32_t microsMax = -0x7FFFFFFFL;
+
+        for ( uint16_t i = 0; i < 500; i++ )
+        {
+            ExtIntEvent event;
+            while ( getExtIntEvent( &event ) )
+            { }
+
+            random = random * 25173 + 13849;
+            uint16_t delayCycles = 500 + ( random & 0x3FF );
+
+            uint32_t edgeTime;
+            unsigned long startMicros;
+            ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+            {
+                startMicros = micros();
+                edgeTime = counter32Read() + delayCycles;
+                OCR1B = static_cast<uint16_t>( edgeTime );
+            }
+
+            int1Done = 0;
+            volatile uint16_t busy = 0;
+            while ( ! int1Done )
+            {
+                busy = busy * 3 + 1;
+            }
+
+            if ( ! getExtIntEvent( &event ) )
+            {
+                continue;
+            }
+
+            //Both errors relative to the same start, in clock-cycles
+            int32_t timestampError = static_cast<int32_t>( event.timestamp - edgeTime );
+            int32_t microsError = static_cast<int32_t>( ( int1Micros - startMicros ) * clockCyclesPerMicrosecond() )
+                                  - delayCycles;
+
+            if ( timestampError < timestampMin )    timestampMin = timestampError;
+            if ( timestampError > timestampMax )    timestampMax = timestampError;
+            if ( microsError < microsMin )          microsMin = microsError;
+            if ( microsError > microsMax )          microsMax = microsError;
+        }
+
+        usart0.usartPrintf( "timestamp: error %ld .. %ld cycles, jitter %ld cycles\r\n",
+                            timestampMin, timestampMax, timestampMax - timestampMin );
+        usart0.usartPrintf( "micros():  error %ld .. %ld cycles, jitter %ld cycles\r\n\r\n",
+                            microsMin, microsMax, microsMax - microsMin );
+        delay( 2000 );
+    }
+}
@@ -0,0 +1,83 @@
+/*
+    exampleHalfBridgePwm - Test-Module for HalfBridgePwm.h and
+    HalfBridgePwm.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    The same half-bridge as in exampleTimer16Bit_PWM.cpp: The "upper"
+    transistor is driven by pin OC1B (PB2 on the ATmega328p) and is on with
+    a low level, the "lower" transistor is driven by pin OC1A (PB1) and is
+    on with a high level. Connect a small DC-motor (or a LED with a
+    resistor) between the output of the half-bridge and GND.
+
+    A 20 kHz PWM-signal with a dead-time of 500 ns is generated. The
+    duty-cycle rises slowly from 10 % to 90 % and falls back, so the motor
+    speeds up and slows down. The compare-match-values are calculated by
+    the HalfBridgePwm-object, so the dead-time can't get lost by mistake.
+*/
+
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+#include "HalfBridgePwm.h"
+
+
+GpioPinObject upperTransistorOc1b  = makeGpioPinObject( GpioPin( B, 2 ) );
+GpioPinObject lowerTransistorOc1a  = makeGpioPinObject( GpioPin( B, 1 ) );
+TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+HalfBridgePwm bridge( tc1 );
+
+int main()
+{
+    initSystemClock();
+    sei();
+
+    //Turn both transistors off, then make the PWM-pins outputs
+    if ( bridge.init( 20000, 500 ) != 0 )
+    {
+        while(1)
+        { /*wrong settings: leave the transistors off*/ }
+    }
+    upperTransistorOc1b.setModeOutput();
+    lowerTransistorOc1a.setModeOutput();
+
+    const uint16_t minDuty = 6554;     //10 % of 65536
+    const uint16_t maxDuty = 58982;    //90 % of 65536
+    uint16_t duty = minDuty;
+    int16_t change = 64;
+
+    bridge.start( duty );
+
+    while(1)
+    {
+        delayMilliseconds( 2 );
+
+        duty += change;
+        if ( duty >= maxDuty || duty <= minDuty )
+        {
+            change = -change;
+        }
+        bridge.setDuty( duty );
+    }
+}
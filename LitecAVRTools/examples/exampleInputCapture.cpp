@@ -0,0 +1,66 @@
+/*
+    exampleInputCapture - Test-Module for InputCapture.h and InputCapture.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    A tachometer: The signal of a hall-sensor (one pulse per revolution) is
+    connected to the input-capture-pin ICP1 (PB0 on the ATmega328p, PD4 on
+    the ATmega2560).
+
+    Once per second, frequency, revolutions per minute and duty-cycle are
+    put out via USART0 (9600 baud). If there was no pulse for two seconds,
+    the motor is considered standing.
+*/
+
+#include <avr/interrupt.h>
+
+#include "SystemClock.h"
+#include "Usart.h"
+#include "InputCapture.h"
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+    inputCaptureInit( IC_PULSE_WIDTH );
+    sei();
+
+    while ( 1 )
+    {
+        delayMilliseconds( 1000 );
+
+        InputCaptureMeasurement m;
+
+        if ( inputCaptureGetMeasurement( &m ) == 0 )
+        {
+            // 1 Hz = 60 rpm, the frequency is in 1/1000 Hz
+            usart0.usartPrintf( "f=%lu.%03lu Hz  %lu rpm  duty=%u.%u %%  (%u periods)\r\n",
+                                m.frequencyMilliHz / 1000, m.frequencyMilliHz % 1000,
+                                ( m.frequencyMilliHz * 6 + 50 ) / 100,
+                                m.dutyPerMille / 10, m.dutyPerMille % 10, m.periods );
+        }
+        else if ( inputCaptureTicksSinceLastEdge() > 2 * INPUT_CAPTURE_TICKS_PER_SECOND )
+        {
+            usart0.usartPrintf( "standing\r\n" );
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/*
+    exampleIsrProfiler.cpp - Example/Test for the IsrProfiler-module consisting
+    of IsrProfiler.h and IsrProfiler.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Compile all source-files with the options
+    -DISR_PROFILER_ENABLED=1 -DISR_PROFILER_SYSTEM_CLOCK_SLOT=0
+    so the profiler is turned on, and the overflow-interrupt of the system
+    clock is measured in slot 0.
+
+    Timer/Counter1 runs in normal mode with prescaler 1. It is the time-base
+    of the profiler, and its overflow-interrupt (slot 1) does some
+    calculations. Connect a push-button between PD2 and GND: the INT0-ISR
+    (slot 2) is measured, too.
+
+    Every two seconds a report is put out via USART0 (9600 baud).
+*/
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "ExternalInterrupts.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+#include "Usart.h"
+#include "IsrProfiler.h"
+
+#define buttonPin       GpioPin( D, 2 )
+
+enum
+{
+    kSlotSystemClock = 0,
+    kSlotTimer1Overflow = 1,
+    kSlotInt0 = 2
+};
+
+const char* const slotNames[ ISR_PROFILER_SLOTS ] = { "SystemClock", "TIMER1_OVF", "INT0" };
+
+TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+
+volatile uint16_t checksum;
+volatile uint8_t buttonPresses;
+
+
+ISR( TIMER1_OVF_vect )
+{
+    PROFILE_ISR_ENTER( kSlotTimer1Overflow );
+
+    // Some work with varying execution time
+    uint16_t c = checksum;
+    for ( uint8_t i = 0; i < ( c & 0x0F ); i++ )
+    {
+        c = ( c << 1 ) ^ ( ( c & 0x8000 ) ? 0x1021 : 0 );
+    }
+    checksum = c + 1;
+
+    PROFILE_ISR_EXIT( kSlotTimer1Overflow );
+}
+
+
+ISR( INT0_vect )
+{
+    PROFILE_ISR_ENTER( kSlotInt0 );
+    buttonPresses++;
+    PROFILE_ISR_EXIT( kSlotInt0 );
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+
+    tc1.setMode( T16_NORMAL );
+    tc1.selectClockSource( T16_PRESC_1 );
+    tc1.clearPendingInterruptEvents( T16_INT_OVERFLOW );
+    tc1.enableInterrupts( T16_INT_OVERFLOW );
+
+    setGpioPinModeInputPullup( buttonPin );
+    setExtIntEventType( 0, EXTINT_FALLING_EDGE );
+    clearPendingExtIntEvent( 0 );
+    enableExtInt( 0 );
+
+    sei();
+
+    isrProfilerInit();
+
+    unsigned long lastReport = millis();
+
+    while ( 1 )
+    {
+        if ( millis() - lastReport >= 2000 )
+        {
+            lastReport += 2000;
+            isrProfilerReport( usart0, slotNames );
+            isrProfilerReset();
+        }
+
+        // nothing else to do
+        isrProfilerIdle();
+    }
+}
@@ -0,0 +1,121 @@
+/*
+    examplePulseCounter - Test-Module for PulseCounter.h and PulseCounter.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Measures the highest pulse-rate, that the PulseCounter-module counts
+    without lost pulses. For the ATmega328p (Arduino Uno).
+
+    Timer/Counter2 generates the pulses: in CTC-mode it toggles OC2A (PB3)
+    at each compare-match, so the frequency is F_CPU / ( 2 * ( OCR2A + 1 ) ).
+    Connect PB3 to INT0 (PD2). Timer/Counter1 defines the gate-time (100
+    milliseconds), and the system clock runs on Timer/Counter0, so its
+    interrupt adds latency, as in a real application.
+
+    For each frequency, the counts of 10 complete gate-times are added and
+    compared with the expected count (a difference of one pulse is possible,
+    because the two timers are not synchronized, but a pulse lost in each
+    gate-interrupt gives a difference of 10). The results are put out
+    via USART0 (9600 baud).
+*/
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "Timer8Bit.h"
+#include "ExternalInterrupts.h"
+#include "PulseCounter.h"
+
+
+TimerCounter8Bit tc2 = makeTimerCounter8BitObject( 2 );
+
+
+// Waits for the end of the next gate-time and returns its count
+uint16_t waitForGate()
+{
+    uint16_t count;
+    while ( pulseCounterGetGateCount( &count ) == 0 )
+    {
+    }
+    return count;
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+
+    tc2.setMode( T8_CTC_OCRNA );
+    tc2.setPwmPinMode( T8_COMP_A, T8_PIN_TOGGLE_ON_MATCH );
+    setGpioPinModeOutput( GpioPin( B, 3 ) );
+
+    pulseCounterInit( EXTINT_RISING_EDGE );
+    sei();
+
+    while ( 1 )
+    {
+        uint32_t bestRate = 0;
+
+        // From 31250 to 1000000 pulses per second
+        for ( uint16_t top = 255; top >= 7; top -= ( top + 8 ) / 8 )
+        {
+            tc2.selectClockSource( T8_CLK_OFF );
+            tc2.setCompareMatchValue( T8_COMP_A, top );
+            tc2.setActualCountValue( 0 );
+            tc2.selectClockSource( T8_PRESC_1 );
+
+            // The first gate-time may have started before the new frequency
+            waitForGate();
+            uint32_t count = 0;
+            for ( uint8_t i = 0; i < 10; i++ )
+            {
+                count += waitForGate();
+            }
+
+            uint32_t rate = F_CPU / ( 2 * ( top + 1UL ) );
+            uint32_t expected = rate * PULSE_COUNTER_GATE_MS / 100;
+            int32_t difference = static_cast<int32_t>( count ) - static_cast<int32_t>( expected );
+
+            usart0.usartPrintf( "%7lu pulses/s: %lu of %lu pulses, %lu mHz\r\n",
+                                rate, count, expected, pulseCounterGetFrequencyMilliHz() );
+
+            if ( difference >= -1 && difference <= 1 )
+            {
+                bestRate = rate;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        tc2.selectClockSource( T8_CLK_OFF );
+        usart0.usartPrintf( "highest rate without lost pulses: %lu pulses/s\r\n\r\n", bestRate );
+        delay( 5000 );
+    }
+}
@@ -0,0 +1,114 @@
+/*
+    examplePwmAudio - Test-Module for PwmAudio.h and PwmAudio.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    The same half-bridge as in exampleTimer16Bit_PWM.cpp: The "upper"
+    transistor is driven by pin OC1B (PB2 on the ATmega328p), the "lower"
+    transistor by pin OC1A (PB1). Connect an 8-Ohm-speaker in series with
+    a 220 Micro-Farad electrolytic capacitor between the output of the
+    half-bridge and GND.
+
+    First the word "hello" is played from flash-memory, then the same word
+    compressed with IMA-ADPCM (soundfileAdpcm.h was created with
+    `tools/adpcmEncode.py soundfile.h --end-marker`, it needs half the
+    flash-memory). Then a 500 Hz square-wave is generated in the main loop
+    and played for one second through the two RAM-buffers. This is repeated every three seconds.
+
+    Unlike exampleTimer16Bit_PWM.cpp, there is no interrupt every PWM-period:
+    Timer/Counter2 generates the 8000 interrupts per second for the samples.
+
+    The samples in soundfile.h were made for the compare-match-values of
+    exampleTimer16Bit_PWM.cpp, centered around 100 of 200. PwmAudio uses the
+    full range 0..255 with the middle at 128, so "hello" is played a bit
+    quieter and with a small DC-offset, which is blocked by the capacitor.
+*/
+
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "PwmAudio.h"
+
+#include "soundfile.h"
+#include "soundfileAdpcm.h"
+
+
+GpioPinObject upperTransistorOc1b  = makeGpioPinObject( GpioPin( B, 2 ) );
+GpioPinObject lowerTransistorOc1a  = makeGpioPinObject( GpioPin( B, 1 ) );
+
+int main()
+{
+    initSystemClock();
+
+    //Turn both transistors off, then make the PWM-pins outputs
+    pwmAudioInit();
+    upperTransistorOc1b.setModeOutput();
+    lowerTransistorOc1a.setModeOutput();
+
+    pwmAudioStart();
+    sei(); //globally enable interrupts
+
+    while(1)
+    {
+        //The last byte of soundData is the end-marker 0xFF
+        pwmAudioPlayProgmem( soundData, sizeof( soundData ) - 1, 0 );
+        while ( pwmAudioIsPlaying() )
+        { /*wait*/ }
+        delayMilliseconds( 500 );
+
+        pwmAudioPlayAdpcmProgmem( soundDataAdpcm, soundDataAdpcmSamples, 0 );
+        while ( pwmAudioIsPlaying() )
+        { /*wait*/ }
+
+        //500 Hz square-wave: 8 samples high, 8 samples low
+        pwmAudioPlayBuffers();
+        uint16_t samplesToPlay = PWM_AUDIO_SAMPLE_RATE;
+        uint8_t phase = 0;
+        while ( samplesToPlay > 0 )
+        {
+            uint8_t* buffer = pwmAudioGetFreeBuffer();
+            if ( buffer == NULL )
+            {
+                continue; //both buffers are still waiting to be played
+            }
+
+            uint8_t length = PWM_AUDIO_BUFFER_SIZE;
+            if ( samplesToPlay < length )
+            {
+                length = samplesToPlay;
+            }
+            for ( uint8_t i = 0; i < length; i++ )
+            {
+                buffer[ i ] = ( phase & 0x08 ) ? 160 : 96;
+                phase++;
+            }
+            pwmAudioSubmitBuffer( length );
+            samplesToPlay -= length;
+        }
+        delayMilliseconds( 20 ); //let the last buffers play
+        pwmAudioSilence();
+
+        delayMilliseconds( 2000 );
+    }
+}
@@ -0,0 +1,139 @@
+/*
+    exampleQuadratureEncoder - Test-Module for QuadratureEncoder.h and
+    QuadratureEncoder.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Measures the highest edge-rate, that the QuadratureEncoder-module
+    decodes without lost counts. For the ATmega328p (Arduino Uno).
+
+    Timer/Counter1 generates the quadrature-signals: in CTC-mode it toggles
+    OC1A (PB1) at TOP and OC1B (PB2) at TOP / 2, so B leads A by 90 degrees.
+    Connect PB1 to INT0 (PD2, signal A) and PB2 to INT1 (PD3, signal B).
+
+    For each rate, Timer/Counter1 runs for 1000 of its periods (2000 edges).
+    The main program counts the edges by polling the compare-match-flags,
+    then stops the Timer/Counter. The position must be minus the number of
+    edges (B leads A), and there must be no invalid transitions. The results
+    are put out via USART0 (9600 baud).
+*/
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "Timer16Bit.h"
+#include "QuadratureEncoder.h"
+
+
+TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+
+
+// Generates the signals with the given TOP-value. Returns the number of edges.
+int32_t generateEdges( uint16_t top, uint16_t periods )
+{
+    tc1.selectClockSource( T16_CLK_OFF );
+    tc1.setActualCountValue( 0 );
+    tc1.setCompareMatchValuesAB( top, top / 2 );
+    tc1.clearPendingInterruptEvents( T16_INT_COMP_MATCH_A | T16_INT_COMP_MATCH_B );
+
+    quadratureEncoderInit();
+
+    uint16_t edgesA = 0;
+    uint16_t edgesB = 0;
+
+    tc1.selectClockSource( T16_PRESC_1 );
+
+    while ( edgesA < periods )
+    {
+        uint8_t flags = TIFR1;
+        if ( flags & _BV(OCF1A) )
+        {
+            TIFR1 = _BV(OCF1A);
+            edgesA++;
+        }
+        if ( flags & _BV(OCF1B) )
+        {
+            TIFR1 = _BV(OCF1B);
+            edgesB++;
+        }
+    }
+
+    tc1.selectClockSource( T16_CLK_OFF );
+
+    // Edges after the last poll
+    uint8_t flags = TIFR1;
+    if ( flags & _BV(OCF1A) )   edgesA++;
+    if ( flags & _BV(OCF1B) )   edgesB++;
+
+    return static_cast<int32_t>( edgesA ) + edgesB;
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+
+    tc1.setMode( T16_CTC_OCRNA );
+    tc1.setPwmPinMode( T16_COMP_A, T16_PIN_TOGGLE_ON_MATCH );
+    tc1.setPwmPinMode( T16_COMP_B, T16_PIN_TOGGLE_ON_MATCH );
+    setGpioPinModeOutput( GpioPin( B, 1 ) );
+    setGpioPinModeOutput( GpioPin( B, 2 ) );
+
+    sei();
+
+    while ( 1 )
+    {
+        uint32_t bestRate = 0;
+
+        // From 20000 to about 500000 edges per second
+        for ( uint16_t top = 1599; top >= 63; top -= top / 8 )
+        {
+            int32_t edges = generateEdges( top, 1000 );
+            delay( 1 );
+
+            int32_t position = quadratureEncoderGetPosition();
+            uint8_t errors = quadratureEncoderGetErrors();
+            uint32_t rate = 2 * F_CPU / ( top + 1UL );
+
+            usart0.usartPrintf( "%6lu edges/s: position %ld of %ld, %u invalid transitions\r\n",
+                                rate, position, -edges, errors );
+
+            if ( position == -edges && errors == 0 )
+            {
+                bestRate = rate;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        usart0.usartPrintf( "highest rate without lost counts: %lu edges/s\r\n\r\n", bestRate );
+        delay( 5000 );
+    }
+}
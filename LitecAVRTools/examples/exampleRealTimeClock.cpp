@@ -0,0 +1,79 @@
+/*
+    exampleRealTimeClock.cpp - Example/Test for the RealTimeClock-module
+    consisting of RealTimeClock.h and RealTimeClock.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    A simple data-logger for the ATmega2560: A 32.768 kHz watch crystal is
+    connected to TOSC1 (PG4) and TOSC2 (PG3).
+
+    Every 10 seconds the CPU wakes up, reads the pin PB0 and puts out date,
+    time, millis() and the pin-state via USART0 (9600 baud). Between the
+    samples, the CPU sleeps in power-save-mode. millis() is disciplined
+    against the real-time-clock, so it includes the time slept.
+*/
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "RealTimeClock.h"
+
+#define samplePin       GpioPin( B, 0 )
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    setGpioPinModeInputPullup( samplePin );
+
+    initSystemClock();
+    rtcInit();
+    sei();
+
+    RtcDateTime start = { 2018, 6, 1, 12, 0, 0, 0 };
+    rtcSetDateTime( &start );
+
+    // The crystal of this board is 12.5 ppm too slow
+    rtcSetTrim( 12500 );
+
+    rtcDisciplineMillis();
+
+    uint32_t nextSample = rtcGetSeconds();
+
+    while ( 1 )
+    {
+        RtcDateTime now;
+        rtcGetDateTime( &now );
+
+        usart0.usartPrintf( "%04u-%02u-%02u %02u:%02u:%02u millis=%lu PB0=%u\r\n",
+                            now.year, now.month, now.day, now.hour, now.minute, now.second,
+                            millis(), readGpioPinDigital( samplePin ) );
+
+        // Wait until the last byte is transmitted, the USART stops in power-save-mode
+        delayMilliseconds( 10 );
+
+        nextSample += 10;
+        rtcSleepUntil( nextSample );
+        rtcDisciplineMillis();
+    }
+}
@@ -0,0 +1,118 @@
+/*
+    exampleSoftPwm - Test-Module for SoftPwm.h and SoftPwm.cpp, and for
+    measuring the load of its interrupt-service-routine.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    For the ATmega2560. Compile all source-files with the options
+    -DSOFT_PWM_TIMER=3 -DSOFT_PWM_CHANNELS=32 -DSOFT_PWM_PORTS=4
+    -DISR_PROFILER_ENABLED=1 -DISR_PROFILER_SOFT_PWM_SLOT=0
+    (or with SOFT_PWM_CHANNELS 8 or 16).
+
+    SoftPwm uses Timer/Counter3. Timer/Counter1 runs in normal mode with
+    prescaler 1, it is the time-base of the IsrProfiler-module, which
+    measures the compare-match-interrupt of SoftPwm in slot 0.
+
+    The channels are on the ports A, C, L and K (8 pins each). Connect
+    hobby-servos (or LEDs with resistors) to some of the pins. All servos
+    move slowly between 1 ms and 2 ms. The pulse-widths are different for
+    each channel, so there is one interrupt for every channel (the
+    worst case).
+
+    Every two seconds the profile is put out via USART0 (9600 baud).
+*/
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Timer16Bit.h"
+#include "Usart.h"
+#include "IsrProfiler.h"
+#include "SoftPwm.h"
+
+const char* const slotNames[ ISR_PROFILER_SLOTS ] = { "SoftPwm" };
+
+TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+
+
+void attachChannels()
+{
+    for ( uint8_t i = 0; i < 8; i++ )
+    {
+        softPwmAttachPin( i, &DDRA, &PORTA, &PINA, i );
+        softPwmAttachPin( i + 8, &DDRC, &PORTC, &PINC, i );
+        softPwmAttachPin( i + 16, &DDRL, &PORTL, &PINL, i );
+        softPwmAttachPin( i + 24, &DDRK, &PORTK, &PINK, i );
+    }
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+
+    tc1.setMode( T16_NORMAL );
+    tc1.selectClockSource( T16_PRESC_1 );
+
+    softPwmInit();
+    attachChannels();  //channels above SOFT_PWM_CHANNELS are rejected
+
+    sei();
+
+    isrProfilerInit();
+
+    unsigned long lastReport = millis();
+    unsigned long lastMove = millis();
+    uint16_t position = 0;
+    int8_t direction = 1;
+
+    while ( 1 )
+    {
+        if ( millis() - lastMove >= 20 )
+        {
+            lastMove += 20;
+
+            // 1000 .. 2000 us, each channel 10 us later than the one before
+            position += direction;
+            if ( position == 0 || position >= 900 )
+            {
+                direction = -direction;
+            }
+            for ( uint8_t c = 0; c < SOFT_PWM_CHANNELS; c++ )
+            {
+                softPwmSetMicros( c, 1000 + position + 10 * c );
+            }
+            softPwmUpdate();
+        }
+
+        if ( millis() - lastReport >= 2000 )
+        {
+            lastReport += 2000;
+            isrProfilerReport( usart0, slotNames );
+            isrProfilerReset();
+        }
+
+        isrProfilerIdle();
+    }
+}
@@ -0,0 +1,85 @@
+/*
+    exampleStepperMotor - Test-Module for StepperMotor.h and StepperMotor.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Connect the STEP-input of a stepper-motor-driver (A4988, DRV8825, ...)
+    to PD2 and the DIR-input to PD3. StepperMotor uses Timer/Counter1.
+
+    The motor moves 32000 steps forward (with 1/16 microsteps 10 turns of a
+    motor with 200 steps per turn) with up to 30000 steps per second, and
+    back again. A shorter move of 2000 steps doesn't reach the speed (a
+    triangular speed-profile). A long move is stopped after one second with
+    stepperStop(): the motor decelerates to a stop.
+
+    The position is put out via USART0 (9600 baud) after each move. With an
+    oscilloscope or a logic-analyzer on PD2 the step-frequency can be
+    checked.
+*/
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "StepperMotor.h"
+
+
+void waitForStop( Usart& usart )
+{
+    while ( stepperIsRunning() )
+    { }
+    usart.usartPrintf( "position %ld\r\n", stepperGetPosition() );
+    delay( 500 );
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+    stepperInit( GpioPin( D, 2 ), GpioPin( D, 3 ) );
+
+    sei();
+
+    while ( 1 )
+    {
+        // Trapezoid: 1 s acceleration, 0.07 s with 30000 steps per second, 1 s deceleration
+        stepperMove( 32000, 30000, 30000, 30000 );
+        waitForStop( usart0 );
+        stepperMove( -32000, 30000, 30000, 30000 );
+        waitForStop( usart0 );
+
+        // Triangle: accelerates to about 7700 steps per second, then decelerates
+        stepperMove( 2000, 30000, 30000, 30000 );
+        waitForStop( usart0 );
+        stepperMove( -2000, 30000, 30000, 30000 );
+        waitForStop( usart0 );
+
+        // Stopped during the move
+        stepperMove( 1000000, 20000, 10000, 10000 );
+        delay( 1000 );
+        stepperStop();
+        waitForStop( usart0 );
+        stepperSetPosition( 0 );
+    }
+}
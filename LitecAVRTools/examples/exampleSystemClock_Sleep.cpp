@@ -0,0 +1,78 @@
+/*
+    exampleSystemClock_Sleep.cpp - Example/Test for the sleeping delay-functions
+    of the SystemClock-module consisting of SystemClock.h and SystemClock.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    The three delay-functions delayMilliseconds(), delayMillisecondsIdle() and
+    delayMillisecondsIdlePeripheralsOff() are called one after the other, each
+    with a delay of 1000 ms. The measured delay-times are put out via USART0.
+
+    Pin PB0 is high, while one of the delay-functions is running. Connect a
+    LED, an oscilloscope or an amperemeter in the supply-line to see the
+    different current-consumption during the three delays.
+*/
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "Usart.h"
+#include "SystemClock.h"
+
+#define measurePin      GpioPin( B, 0 )
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    setGpioPinModeOutput( measurePin );
+    setGpioPinLow( measurePin );
+
+    initTimer0AsSystemClock();
+    sei();
+
+    while(1)
+    {
+        unsigned long start;
+        unsigned long busy, idle, peripheralsOff;
+
+        setGpioPinHigh( measurePin );
+        start = micros();
+        delayMilliseconds( 1000 );
+        busy = micros() - start;
+
+        start = micros();
+        delayMillisecondsIdle( 1000 );
+        idle = micros() - start;
+
+        start = micros();
+        delayMillisecondsIdlePeripheralsOff( 1000 );
+        peripheralsOff = micros() - start;
+        setGpioPinLow( measurePin );
+
+        usart0.usartPrintf( "busy: %lu us, idle: %lu us, peripherals off: %lu us\r\n",
+                            busy, idle, peripheralsOff );
+
+        delayMilliseconds( 1000 );
+    }
+
+    return 0;
+}
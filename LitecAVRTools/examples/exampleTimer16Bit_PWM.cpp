@@ -45,11 +45,18 @@
     that after turning off one transistor, the other transistor is turned on
     after a short dead-time. (If both transistors are turned on at the same
     time, this results in a short-circuit connecting VCC and GND via the two
-    transistors. This must never occur!)
+    transistors. This must never occur!) The class HalfBridgePwm
+    (HalfBridgePwm.h) calculates both values from one duty-cycle, see
+    exampleHalfBridgePwm.cpp.
 
     The duty-cycle of the PWM-signals are changed every 5th PWM-period (this
     means that they are updated 8000 times a second). The contents of a
     wav-file saying the word "hello" are put out.
+
+    The Timer/Counter-object is a `TimerCounter16< 1 >`, so the registers are
+    known at compile-time. The two calls of `setCompareMatchValue` in the ISR
+    compile to four `sts`-instructions. With a `TimerCounter16Bit`-object each
+    call is a function-call through the pointers stored in the object.
 */
 
 #include <stdint.h>
@@ -65,7 +72,7 @@
 
 GpioPinObject upperTransistorOc1b  = makeGpioPinObject( GpioPin( B, 2 ) );
 GpioPinObject lowerTransistorOc1a  = makeGpioPinObject( GpioPin( B, 1 ) );
-TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+TimerCounter16< 1 > tc1;
 
 int main()
 {
@@ -0,0 +1,79 @@
+/*
+    exampleTimer8Bit_PWM - Test-Module for Timer8Bit.h and Timer8Bit.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Two LEDs (with resistors) are dimmed with hardware-PWM-signals of
+    Timer/Counter2 in fast-PWM-mode. They are connected to the pins OC2A and
+    OC2B (PB3 and PD3 on the ATmega328p). The PWM-frequency is
+    16 MHz / 64 / 256 = 977 Hz. One LED fades in while the other one fades
+    out.
+
+    Timer/Counter0 is used by the SystemClock-module (delay()), and
+    Timer/Counter1 stays free for other work. The Timer/Counter-object is a
+    `TimerCounter8< 2 >`: each `setCompareMatchValue` compiles to one
+    `sts`-instruction. The same can be done with a `TimerCounter8Bit`-object,
+    created with `makeTimerCounter8BitObject( 2 )`.
+*/
+
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Timer8Bit.h"
+
+
+TimerCounter8< 2 > tc2;
+
+
+int main()
+{
+    initSystemClock();
+    sei();
+
+    tc2.setMode( T8_FAST_PWM_0XFF );
+    tc2.setCompareMatchValue( T8_COMP_A, 0 );
+    tc2.setCompareMatchValue( T8_COMP_B, 255 );
+    tc2.setPwmPinMode( T8_COMP_A, T8_PIN_PWM_NORMAL );
+    tc2.setPwmPinMode( T8_COMP_B, T8_PIN_PWM_NORMAL );
+    tc2.selectClockSource( T8_PRESC_64 );
+
+    //The PWM-pins must be outputs
+    setGpioPinModeOutput( GpioPin( B, 3 ) );
+    setGpioPinModeOutput( GpioPin( D, 3 ) );
+
+    uint8_t duty = 0;
+    int8_t step = 1;
+
+    while ( 1 )
+    {
+        tc2.setCompareMatchValue( T8_COMP_A, duty );
+        tc2.setCompareMatchValue( T8_COMP_B, 255 - duty );
+
+        if ( ( duty == 255 && step > 0 ) || ( duty == 0 && step < 0 ) )
+        {
+            step = -step;
+        }
+        duty += step;
+        delay( 4 );
+    }
+}
@@ -0,0 +1,107 @@
+/*
+    exampleTimerGroup - Test-Module for TimerGroup.h and TimerGroup.cpp
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    This example needs an ATmega2560 (Arduino Mega).
+
+    Three 20 kHz PWM-signals with a duty-cycle of 50 % are generated by
+    Timer/Counter1, 3 and 4 on the pins OC1A (PB5, Arduino pin 11),
+    OC3A (PE3, pin 5) and OC4A (PH3, pin 6). They are shifted by 120 degrees
+    (267 and 533 of 800 timer-ticks), like the signals of a 3-phase-inverter.
+    Check the phase-shift with an oscilloscope or a logic-analyzer.
+
+    After the start the count-values of the three Timer/Counters are read
+    directly one after the other, and their differences are put out via
+    USART0 (9600 baud). Each read takes a few clock-cycles, so the
+    differences are about 267 + 4 and 533 + 8. They stay the same after
+    each restart of the group.
+*/
+
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "GpioPinMacros.h"
+#include "SystemClock.h"
+#include "Usart.h"
+#include "Timer16Bit.h"
+#include "TimerGroup.h"
+
+
+TimerCounter16Bit tc1 = makeTimerCounter16BitObject( 1 );
+TimerCounter16Bit tc3 = makeTimerCounter16BitObject( 3 );
+TimerCounter16Bit tc4 = makeTimerCounter16BitObject( 4 );
+TimerGroup group;
+
+
+void initPwm( TimerCounter16Bit& tc )
+{
+    // In normal mode OCRnA is not double-buffered, so the value is used from the first period on
+    tc.setCompareMatchValue( T16_COMP_A, 400 );             // 50 %
+    tc.setMode( T16_FAST_PWM_ICRN );
+    tc.setTopValue( 799 );                                  // 16 MHz / 800 = 20 kHz
+    tc.setPwmPinMode( T16_COMP_A, T16_PIN_PWM_NORMAL );
+}
+
+
+int main()
+{
+    Usart usart0 = makeUsartObject( 0 );
+    usart0.init( 9600 );
+
+    initSystemClock();
+
+    initPwm( tc1 );
+    initPwm( tc3 );
+    initPwm( tc4 );
+    setGpioPinModeOutput( GpioPin( B, 5 ) );
+    setGpioPinModeOutput( GpioPin( E, 3 ) );
+    setGpioPinModeOutput( GpioPin( H, 3 ) );
+
+    group.add( tc1, T16_PRESC_1, 0 );
+    group.add( tc3, T16_PRESC_1, 267 );
+    group.add( tc4, T16_PRESC_1, 533 );
+
+    sei();
+
+    while ( 1 )
+    {
+        group.start();
+
+        uint16_t count1, count3, count4;
+        ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+        {
+            count1 = TCNT1;
+            count3 = TCNT3;
+            count4 = TCNT4;
+        }
+
+        // Differences modulo the period of 800 timer-ticks
+        usart0.usartPrintf( "TCNT3 - TCNT1: %u   TCNT4 - TCNT1: %u\r\n",
+                            ( count3 + 800 - count1 ) % 800, ( count4 + 800 - count1 ) % 800 );
+
+        delay( 1000 );
+        group.stop();
+        delay( 100 );
+    }
+}
@@ -0,0 +1,256 @@
+// Generated by adpcmEncode.py from soundfile.h: IMA-ADPCM, 4 bits per sample, 8000 Hz
+
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+const uint16_t soundDataAdpcmSamples = 5888;
+
+const uint8_t soundDataAdpcm[] PROGMEM =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0x89, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80,
+    0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x08, 0x80, 0x08, 0x80, 0x80,
+    0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x80, 0x80, 0x80, 0x08, 0x08, 0x08,
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xA7, 0x08, 0xF8, 0xFF, 0x8B, 0x17, 0x00, 0x88, 0x00, 0x9F, 0x08,
+    0x86, 0x80, 0x00, 0x88, 0x00, 0x88, 0x80, 0x27, 0x80, 0x8F, 0x80, 0x80,
+    0x60, 0x80, 0xD0, 0x80, 0x08, 0x80, 0x78, 0x08, 0x08, 0x08, 0xD8, 0x08,
+    0x08, 0x80, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0xF0, 0xEF, 0x08, 0x08, 0x08, 0x80, 0x08, 0x47, 0x08, 0x80, 0x08, 0x08,
+    0xF0, 0x0C, 0x08, 0x07, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x88, 0x00,
+    0x88, 0x00, 0x88, 0x00, 0x08, 0x08, 0x08, 0x88, 0x80, 0x80, 0x90, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x2F, 0x70, 0x0B, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x09, 0x00, 0xA7,
+    0x08, 0x08, 0x3F, 0x80, 0x80, 0x08, 0x08, 0x08, 0x09, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x2F, 0x00, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x70, 0xF7, 0x81, 0x80, 0x80, 0xB7, 0x80, 0xF0, 0x73,
+    0xC0, 0x08, 0x80, 0x3D, 0x80, 0x80, 0x3D, 0x00, 0x88, 0x00, 0xF8, 0x83,
+    0x00, 0x68, 0x8B, 0x0C, 0x03, 0x58, 0xC0, 0x3B, 0xC0, 0x03, 0x58, 0x3B,
+    0x8B, 0x40, 0xD0, 0x80, 0x80, 0x80, 0x86, 0x0B, 0x8C, 0x84, 0x80, 0x40,
+    0xC0, 0x08, 0x08, 0x08, 0xB6, 0x08, 0x08, 0xB5, 0x08, 0x88, 0x00, 0x88,
+    0x00, 0x88, 0xAF, 0x06, 0x08, 0x68, 0x8B, 0x4B, 0x08, 0x08, 0x3D, 0x80,
+    0x80, 0x86, 0x0B, 0x3C, 0x08, 0xB4, 0x08, 0x08, 0xF8, 0x03, 0xC3, 0x80,
+    0x80, 0x0D, 0x43, 0xCB, 0x70, 0xB8, 0x80, 0x85, 0x2B, 0x48, 0xAB, 0x82,
+    0x03, 0x3C, 0x8B, 0x8B, 0x85, 0x80, 0x0C, 0x08, 0x08, 0xB5, 0x08, 0x08,
+    0x86, 0x84, 0x24, 0x0B, 0x0C, 0x08, 0x08, 0x08, 0x8E, 0xCB, 0xB8, 0x08,
+    0x68, 0x08, 0x08, 0x44, 0x73, 0x83, 0xA9, 0x08, 0x32, 0x4B, 0xCF, 0xCD,
+    0x01, 0x11, 0x39, 0x81, 0xAC, 0x32, 0x33, 0x37, 0xA9, 0x3A, 0x91, 0x88,
+    0xF9, 0xDF, 0x31, 0x80, 0x10, 0xC8, 0x9A, 0x03, 0x33, 0x35, 0xA8, 0x9A,
+    0x21, 0x98, 0xE2, 0xEF, 0x10, 0x12, 0x19, 0x81, 0xDA, 0x08, 0x29, 0x44,
+    0x92, 0x89, 0x88, 0x19, 0x82, 0xF1, 0xAF, 0x21, 0x82, 0x20, 0x01, 0xDC,
+    0x98, 0x10, 0x63, 0x81, 0x98, 0x88, 0x00, 0x18, 0xB9, 0xDF, 0x30, 0x93,
+    0x10, 0x02, 0xDC, 0x8A, 0x81, 0x34, 0x04, 0x89, 0x09, 0x80, 0x80, 0xF8,
+    0x8F, 0x30, 0x92, 0x81, 0x94, 0xAB, 0x0C, 0x98, 0x25, 0x05, 0x09, 0x1A,
+    0x90, 0x91, 0xD0, 0x8F, 0x38, 0x82, 0x81, 0x03, 0xDB, 0x8C, 0x80, 0x14,
+    0x14, 0x08, 0x89, 0x80, 0x81, 0xFA, 0x8F, 0x20, 0x82, 0x81, 0x12, 0xBA,
+    0xCD, 0x81, 0x14, 0x12, 0x28, 0x09, 0x88, 0x81, 0xFB, 0x8F, 0x38, 0x01,
+    0x00, 0x22, 0xB9, 0xCE, 0x00, 0x22, 0x10, 0x22, 0x81, 0x88, 0x02, 0xFE,
+    0x9C, 0x30, 0x11, 0x18, 0x32, 0xB1, 0xBF, 0x0A, 0x03, 0x02, 0x34, 0x02,
+    0x08, 0x00, 0xFB, 0xCF, 0x20, 0x10, 0x18, 0x13, 0xA2, 0xCD, 0x89, 0x12,
+    0x08, 0x43, 0x13, 0x90, 0x81, 0xFE, 0x9B, 0x11, 0x02, 0x10, 0x24, 0xC2,
+    0xCB, 0x09, 0x01, 0x00, 0x34, 0x24, 0x29, 0x98, 0xEF, 0x9A, 0x02, 0x81,
+    0x31, 0x42, 0x98, 0xAD, 0x19, 0x08, 0x10, 0x25, 0x13, 0x01, 0xF8, 0xBD,
+    0x09, 0x20, 0x18, 0x51, 0x22, 0xBA, 0x9B, 0x90, 0xB0, 0x53, 0x35, 0x11,
+    0x92, 0xED, 0xAB, 0x88, 0x93, 0x02, 0x35, 0x82, 0xBB, 0x0A, 0x98, 0x0A,
+    0x65, 0x23, 0x11, 0xE0, 0xCC, 0x99, 0x10, 0x18, 0x40, 0x33, 0xA9, 0x8C,
+    0x91, 0xC8, 0x20, 0x27, 0x12, 0x91, 0xCC, 0xAC, 0x89, 0x81, 0x11, 0x16,
+    0x82, 0xA9, 0x88, 0x90, 0x89, 0x44, 0x25, 0x12, 0xFA, 0xBB, 0x09, 0x09,
+    0x19, 0x63, 0x02, 0xA0, 0x09, 0x80, 0x9B, 0x32, 0x67, 0x01, 0xA0, 0xCD,
+    0x99, 0x80, 0x08, 0x50, 0x31, 0x09, 0x1B, 0x18, 0x9A, 0x49, 0x64, 0x21,
+    0x90, 0xBE, 0x9B, 0xA0, 0xB1, 0x32, 0x26, 0x80, 0x09, 0x00, 0xA8, 0x2A,
+    0x74, 0x23, 0x81, 0xAF, 0x9C, 0x90, 0xA0, 0x01, 0x25, 0x80, 0x88, 0x11,
+    0xB0, 0x89, 0x55, 0x42, 0x80, 0xCC, 0x9C, 0x98, 0x90, 0x00, 0x25, 0x92,
+    0x98, 0x12, 0x90, 0x9A, 0x55, 0x14, 0x92, 0xBD, 0x8D, 0x89, 0xA8, 0x01,
+    0x15, 0x92, 0x80, 0x12, 0xA8, 0x0A, 0x64, 0x33, 0x92, 0xBF, 0x8C, 0x99,
+    0xA0, 0x00, 0x15, 0x82, 0x00, 0x12, 0xB0, 0x89, 0x56, 0x22, 0xA1, 0xBF,
+    0x8B, 0x98, 0xA8, 0x11, 0x25, 0x00, 0x20, 0x22, 0xAB, 0x2A, 0x67, 0x11,
+    0xA0, 0xAF, 0x0A, 0xA8, 0xA0, 0x31, 0x32, 0x39, 0x30, 0x03, 0xBA, 0x78,
+    0x35, 0x22, 0xFA, 0xAD, 0x08, 0x89, 0x19, 0x10, 0x14, 0x08, 0x50, 0x80,
+    0x0C, 0x51, 0x23, 0x91, 0xFC, 0xAB, 0x00, 0x18, 0x31, 0x02, 0xC8, 0x91,
+    0x01, 0x91, 0x78, 0x44, 0x21, 0xC0, 0xCF, 0x89, 0x01, 0x11, 0x22, 0xA0,
+    0xAA, 0x80, 0x00, 0x58, 0x53, 0x14, 0xA2, 0xFC, 0x9D, 0x20, 0x10, 0x21,
+    0xA2, 0xBA, 0x19, 0x29, 0x11, 0x15, 0x06, 0x02, 0xCC, 0x9F, 0x18, 0x02,
+    0x21, 0x82, 0x9D, 0x1A, 0x80, 0x02, 0x04, 0x22, 0x21, 0xFA, 0xAF, 0x18,
+    0x12, 0x30, 0x01, 0xAD, 0x0A, 0x01, 0x31, 0x31, 0x38, 0x03, 0xF1, 0xDF,
+    0x08, 0x12, 0x20, 0x82, 0xDB, 0x09, 0x01, 0x40, 0x21, 0x19, 0x10, 0xF1,
+    0xBD, 0x18, 0x23, 0x20, 0x93, 0xFC, 0x08, 0x10, 0x20, 0x12, 0x88, 0x02,
+    0xF0, 0xBD, 0x20, 0x03, 0x11, 0x93, 0xBF, 0x29, 0x02, 0x40, 0x11, 0x0A,
+    0x21, 0xF8, 0xAE, 0x21, 0x01, 0x21, 0xB1, 0x9F, 0x28, 0x10, 0x31, 0x00,
+    0x1A, 0x11, 0xFC, 0x8D, 0x22, 0x00, 0x21, 0xD8, 0x8C, 0x20, 0x01, 0x32,
+    0xA0, 0x18, 0x82, 0xFF, 0x19, 0x21, 0x00, 0x11, 0xCC, 0x0A, 0x13, 0x20,
+    0x13, 0xA8, 0x20, 0xE0, 0xBF, 0x30, 0x12, 0x10, 0xA2, 0xCF, 0x10, 0x02,
+    0x21, 0x01, 0x8A, 0x11, 0xFB, 0x8E, 0x22, 0x00, 0x11, 0xF8, 0x8A, 0x31,
+    0x18, 0x03, 0xC1, 0x01, 0xA1, 0xBF, 0x39, 0x04, 0x00, 0x92, 0xBE, 0x18,
+    0x13, 0x31, 0x82, 0x0B, 0x21, 0xFC, 0x8E, 0x22, 0x81, 0x11, 0xE9, 0x0B,
+    0x31, 0x01, 0x22, 0xC0, 0x10, 0xB0, 0xDF, 0x30, 0x02, 0x18, 0xB1, 0xAF,
+    0x21, 0x82, 0x12, 0x91, 0x2A, 0x18, 0xDF, 0x2A, 0x23, 0x18, 0x01, 0xDE,
+    0x18, 0x12, 0x10, 0x02, 0x8B, 0x01, 0xF9, 0x0D, 0x32, 0x80, 0x20, 0xFB,
+    0x2B, 0x31, 0x28, 0x11, 0xA9, 0x01, 0xF8, 0x8E, 0x22, 0x92, 0x01, 0xD8,
+    0x8D, 0x32, 0x00, 0x11, 0xA0, 0x19, 0xD0, 0x9F, 0x22, 0x93, 0x00, 0xE0,
+    0x9A, 0x32, 0x11, 0x20, 0x98, 0x80, 0xF8, 0xAD, 0x33, 0x83, 0x00, 0xF0,
+    0x8C, 0x31, 0x01, 0x02, 0x90, 0x09, 0xF8, 0xAC, 0x15, 0x82, 0x18, 0xE9,
+    0x99, 0x14, 0x00, 0x20, 0x89, 0x88, 0xF8, 0x0B, 0x43, 0x81, 0x80, 0xEA,
+    0x09, 0x32, 0x10, 0x01, 0x08, 0x8A, 0xDF, 0x29, 0x43, 0x08, 0x88, 0xBD,
+    0x28, 0x14, 0x00, 0x92, 0x90, 0xA8, 0xDF, 0x30, 0x13, 0x08, 0xD8, 0x9B,
+    0x22, 0x04, 0x11, 0x88, 0x88, 0xFC, 0x1B, 0x53, 0x00, 0x88, 0xCB, 0x3C,
+    0x51, 0x08, 0x00, 0x80, 0x9A, 0xAF, 0x21, 0x14, 0x08, 0xB9, 0xAB, 0x41,
+    0x13, 0x82, 0x01, 0xA8, 0xFF, 0x3A, 0x32, 0x08, 0x80, 0xBE, 0x39, 0x33,
+    0x18, 0x00, 0x88, 0xFB, 0x9D, 0x33, 0x03, 0x98, 0xE8, 0x99, 0x23, 0x03,
+    0x00, 0x82, 0xFA, 0x9F, 0x22, 0x02, 0x00, 0xD8, 0xAB, 0x53, 0x82, 0x09,
+    0x11, 0xD8, 0xAD, 0x40, 0x12, 0x88, 0xA0, 0xBB, 0x51, 0x12, 0xA0, 0x13,
+    0xE8, 0xAF, 0x21, 0x04, 0x08, 0xB0, 0xCB, 0x32, 0x85, 0x88, 0x20, 0xC0,
+    0xAE, 0x30, 0x13, 0x89, 0xA1, 0xE9, 0x20, 0x13, 0xA0, 0x22, 0xF8, 0x9E,
+    0x21, 0x03, 0x08, 0xA8, 0xAD, 0x42, 0x03, 0x0B, 0x21, 0xF1, 0x8F, 0x21,
+    0x01, 0x89, 0x80, 0x9A, 0x40, 0x12, 0x8A, 0x21, 0xFA, 0x0F, 0x31, 0x80,
+    0x08, 0x99, 0x1C, 0x42, 0xB2, 0x88, 0x22, 0xDE, 0x1A, 0x24, 0xA0, 0x88,
+    0xA1, 0x88, 0x24, 0x90, 0x88, 0xC2, 0xAF, 0x30, 0x14, 0x98, 0x8A, 0x8A,
+    0x32, 0x24, 0x0B, 0x38, 0xF9, 0x9F, 0x41, 0x81, 0x89, 0x08, 0x88, 0x20,
+    0x01, 0x80, 0xA1, 0xDF, 0x18, 0x14, 0x91, 0x99, 0x8A, 0x31, 0x05, 0x89,
+    0x38, 0xF0, 0x8F, 0x30, 0x02, 0x8A, 0x08, 0x08, 0x28, 0x11, 0x90, 0x98,
+    0xEF, 0x18, 0x14, 0x80, 0x9A, 0x1B, 0x43, 0x92, 0x09, 0x58, 0xF9, 0x8C,
+    0x41, 0x01, 0x99, 0x80, 0x08, 0x20, 0x81, 0xA2, 0xB0, 0xCF, 0x19, 0x16,
+    0x80, 0x89, 0x0B, 0x22, 0x94, 0x88, 0x30, 0xFB, 0x9E, 0x42, 0x01, 0xA9,
+    0x90, 0x02, 0x01, 0x08, 0x01, 0xF1, 0x8E, 0x49, 0x02, 0xA0, 0x98, 0x28,
+    0x30, 0x80, 0x90, 0x02, 0xEF, 0x8A, 0x24, 0x82, 0xA9, 0x80, 0x11, 0x92,
+    0x01, 0x11, 0xFA, 0x9F, 0x38, 0x23, 0xA0, 0xAB, 0x48, 0x32, 0xA0, 0x08,
+    0x22, 0xFF, 0x9A, 0x43, 0x01, 0xA8, 0x98, 0x03, 0x81, 0x18, 0x02, 0xF1,
+    0x9F, 0x29, 0x33, 0x91, 0x9C, 0x29, 0x33, 0x98, 0x19, 0x32, 0xFC, 0x9F,
+    0x21, 0x13, 0x99, 0x0A, 0x11, 0x82, 0x89, 0x22, 0xA3, 0xFF, 0x8A, 0x33,
+    0x02, 0xA9, 0x8A, 0x12, 0x05, 0x09, 0x39, 0xA2, 0xFF, 0x89, 0x33, 0x02,
+    0xAB, 0x2A, 0x33, 0xA0, 0x2B, 0x63, 0xA8, 0xEF, 0x18, 0x22, 0x92, 0x9B,
+    0x29, 0x22, 0xA1, 0x08, 0x62, 0x98, 0xDF, 0x09, 0x24, 0x81, 0x9A, 0x19,
+    0x12, 0xA0, 0x80, 0x43, 0xA0, 0xDF, 0x89, 0x33, 0x03, 0xAA, 0x9B, 0x14,
+    0x02, 0x29, 0x39, 0x02, 0xF9, 0xCF, 0x48, 0x21, 0xA0, 0xA9, 0x11, 0x21,
+    0x09, 0x08, 0x13, 0xC1, 0xDF, 0x1A, 0x33, 0x03, 0xAC, 0x2C, 0x30, 0x82,
+    0x09, 0x5A, 0x21, 0xF8, 0xBC, 0x38, 0x43, 0x90, 0xAA, 0x10, 0x22, 0x89,
+    0x00, 0x14, 0x83, 0xFC, 0xAD, 0x21, 0x23, 0x90, 0xBA, 0x88, 0x15, 0x01,
+    0x08, 0x30, 0x14, 0xFB, 0xAE, 0x28, 0x33, 0xA1, 0xBB, 0x29, 0x33, 0x81,
+    0x80, 0x60, 0x52, 0xC0, 0xCE, 0x09, 0x32, 0x02, 0xBA, 0x89, 0x32, 0x01,
+    0x89, 0x41, 0x17, 0x02, 0xEC, 0xAB, 0x28, 0x23, 0x91, 0xAA, 0x19, 0x22,
+    0x82, 0x22, 0x35, 0x62, 0x02, 0xFC, 0xAD, 0x18, 0x22, 0x81, 0x9A, 0x28,
+    0x21, 0x90, 0x08, 0x26, 0x43, 0x00, 0xFA, 0xAD, 0x8A, 0x21, 0x13, 0x88,
+    0x09, 0x11, 0x02, 0x08, 0x68, 0x32, 0x06, 0xA1, 0xBF, 0xBC, 0x08, 0x32,
+    0x22, 0x00, 0x29, 0x29, 0x8A, 0x20, 0x60, 0x61, 0x21, 0x98, 0xFC, 0xAC,
+    0x0A, 0x22, 0x33, 0x10, 0x09, 0x08, 0x98, 0xAA, 0x22, 0x47, 0x13, 0x91,
+    0xF9, 0xCC, 0xAA, 0x10, 0x43, 0x03, 0x91, 0x90, 0x98, 0xA9, 0x89, 0x35,
+    0x36, 0x12, 0x89, 0xBD, 0xBF, 0x9A, 0x38, 0x44, 0x11, 0x08, 0x99, 0x88,
+    0x0B, 0x19, 0x34, 0x26, 0x82, 0x90, 0xFA, 0xBC, 0xAB, 0x20, 0x53, 0x04,
+    0x00, 0x09, 0x99, 0x99, 0x0A, 0x42, 0x44, 0x13, 0x91, 0xAA, 0xCF, 0xAC,
+    0x8A, 0x42, 0x33, 0x12, 0xA9, 0x99, 0x98, 0xBA, 0x80, 0x37, 0x25, 0x11,
+    0xA0, 0xC9, 0xDD, 0x9B, 0x1A, 0x32, 0x26, 0x81, 0x98, 0x99, 0x98, 0xA8,
+    0x20, 0x36, 0x43, 0x01, 0x08, 0xDB, 0xEB, 0xAC, 0x8A, 0x51, 0x23, 0x11,
+    0x89, 0x99, 0x98, 0x8A, 0x8A, 0x73, 0x16, 0x02, 0x08, 0xA9, 0xF9, 0xBB,
+    0xAB, 0x58, 0x33, 0x04, 0x90, 0x09, 0x89, 0xAA, 0x8A, 0x30, 0x47, 0x14,
+    0x81, 0xA9, 0x89, 0xFA, 0xCA, 0x8B, 0x40, 0x42, 0x82, 0x09, 0x89, 0x89,
+    0xB0, 0xB0, 0x43, 0x63, 0x14, 0x82, 0x0A, 0x0B, 0xBB, 0xDF, 0x8C, 0x29,
+    0x32, 0x13, 0x80, 0x0A, 0x80, 0xB8, 0xC8, 0x80, 0x44, 0x36, 0x82, 0x80,
+    0xB0, 0x8B, 0xFB, 0xCD, 0x99, 0x31, 0x23, 0x12, 0x0A, 0x08, 0x08, 0x0D,
+    0x8B, 0x58, 0x33, 0x27, 0x28, 0x8A, 0xB0, 0xC0, 0xBB, 0xCF, 0x99, 0x21,
+    0x24, 0x01, 0x08, 0x88, 0x00, 0xC8, 0xC8, 0x30, 0x34, 0x34, 0x03, 0x88,
+    0xD0, 0xC8, 0xC0, 0x9E, 0x9C, 0x28, 0x12, 0x83, 0x03, 0x08, 0x08, 0x08,
+    0x8F, 0x00, 0x53, 0x33, 0x84, 0x80, 0x0C, 0xC8, 0xF0, 0xCA, 0x99, 0x01,
+    0x22, 0x83, 0x03, 0x08, 0x80, 0xE8, 0xC8, 0x84, 0x33, 0x34, 0x83, 0xD0,
+    0xB0, 0x08, 0x0D, 0xDC, 0x98, 0x28, 0x30, 0x08, 0x08, 0x88, 0xB7, 0x80,
+    0x80, 0x80, 0x86, 0x30, 0x04, 0x03, 0xC8, 0x08, 0x08, 0x8E, 0xCB, 0xB8,
+    0x08, 0x68, 0x08, 0x08, 0x08, 0x68, 0xC0, 0x80, 0x80, 0x40, 0x80, 0x05,
+    0x03, 0x08, 0xE8, 0xC0, 0x80, 0x84, 0x8B, 0xC0, 0x48, 0x80, 0x80, 0xE0,
+    0x80, 0x08, 0x04, 0xC8, 0x08, 0x40, 0x80, 0x80, 0x80, 0x70, 0x00, 0x08,
+    0x88, 0x8E, 0x80, 0x80, 0x00, 0x3F, 0x6C, 0x3D, 0x1A, 0x80, 0xA0, 0x82,
+    0x6D, 0x3B, 0x09, 0xB1, 0xA3, 0x20, 0x3A, 0x0C, 0xC3, 0xB3, 0x80, 0x80,
+    0x80, 0x08, 0x80, 0x08, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x08,
+    0x08, 0x78, 0x0B, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xF0, 0xFF, 0x05, 0x08, 0xAF, 0x08, 0x08, 0x08, 0x78, 0x07, 0x80, 0x08,
+    0x0C, 0xC8, 0x03, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0xB7, 0x08, 0x80, 0x08, 0x08, 0x08, 0x08, 0x08, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
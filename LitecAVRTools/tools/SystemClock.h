@@ -0,0 +1,38 @@
+/*
+    SystemClock.h - Minimal replacement of the SystemClock-module for host-
+    tests of header-only modules (see testDeadline.cpp).
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Uses the include-guard of the real SystemClock.h, so this file must be included before the tested header.
+// millis() and micros() must be defined by the test.
+
+#ifndef SystemClock_h
+#define SystemClock_h
+
+#ifndef F_CPU
+#define F_CPU       16000000UL
+#endif
+
+unsigned long millis();
+unsigned long micros();
+
+#endif
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+#
+#   adpcmEncode.py - Compresses 8-bit audio-samples with the IMA-ADPCM-
+#   algorithm to 4 bits per sample, and writes a header-file for the
+#   AdpcmDecoder- and PwmAudio-modules.
+#
+#   This is part of the LitecAVRTools library.
+#
+#   Copyright (c) 2018 Wolfgang Zukrigl
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation, either version 3 of the License, or
+#   (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Encodes audio into 4-bit IMA-ADPCM for AdpcmDecoder.h.
+
+The input is either a WAV-file (mono or stereo, 8 or 16 bits; only the first
+channel is used) or a C-header with an array of unsigned 8-bit samples, like
+examples/soundfile.h:
+
+    python3 adpcmEncode.py hello.wav -o hello.h --name helloAdpcm --rate 8000
+    python3 adpcmEncode.py soundfile.h -o soundfileAdpcm.h --end-marker
+
+A WAV-file with another sample-rate than --rate is resampled (linear
+interpolation). --end-marker drops a last value 0xFF of a C-array.
+
+The output contains the array <name> (two samples per byte, the first one in
+the lower nibble) and the constant <name>Samples. Play it with
+pwmAudioPlayAdpcmProgmem( <name>, <name>Samples, loop ).
+
+The encoder runs the same decoder as AdpcmDecoder.h (unsigned 16-bit
+predictor, start-values 32768 and step-index 0). For each sample it chooses
+the code with the smallest error.
+"""
+
+import argparse
+import re
+import sys
+import wave
+
+STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+]
+
+INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def decodeNibble(predictor, stepIndex, code):
+    """The same algorithm as adpcmDecodeNibble() in AdpcmDecoder.h."""
+    step = STEP_TABLE[stepIndex]
+    diff = step >> 3
+    if code & 4:
+        diff += step
+    if code & 2:
+        diff += step >> 1
+    if code & 1:
+        diff += step >> 2
+    if code & 8:
+        predictor = max(predictor - diff, 0)
+    else:
+        predictor = min(predictor + diff, 0xFFFF)
+    stepIndex = min(max(stepIndex + INDEX_TABLE[code & 7], 0), 88)
+    return predictor, stepIndex
+
+
+def encode(samples):
+    """Returns the list of 4-bit codes for the unsigned 8-bit samples."""
+    predictor, stepIndex = 32768, 0
+    codes = []
+    for sample in samples:
+        target = (sample << 8) + 128
+        best = None
+        for code in range(16):
+            p, i = decodeNibble(predictor, stepIndex, code)
+            error = abs(p - target)
+            if best is None or error < best[0]:
+                best = (error, code, p, i)
+        _, code, predictor, stepIndex = best
+        codes.append(code)
+    return codes
+
+
+def decode(codes):
+    predictor, stepIndex = 32768, 0
+    samples = []
+    for code in codes:
+        predictor, stepIndex = decodeNibble(predictor, stepIndex, code)
+        samples.append(predictor >> 8)
+    return samples
+
+
+def readWav(fileName, rate):
+    with wave.open(fileName, 'rb') as w:
+        channels = w.getnchannels()
+        width = w.getsampwidth()
+        inRate = w.getframerate()
+        frames = w.readframes(w.getnframes())
+    if width not in (1, 2):
+        sys.exit('only 8- and 16-bit WAV-files are supported')
+    samples = []
+    for i in range(0, len(frames), channels * width):
+        if width == 1:
+            samples.append(frames[i])
+        else:
+            value = int.from_bytes(frames[i:i + 2], 'little', signed=True)
+            samples.append(min(max((value + 32768 + 128) >> 8, 0), 255))
+    if inRate != rate and samples:
+        count = len(samples) * rate // inRate
+        resampled = []
+        for n in range(count):
+            position = n * inRate / rate
+            k = int(position)
+            fraction = position - k
+            following = samples[min(k + 1, len(samples) - 1)]
+            resampled.append(int(round(samples[k] * (1 - fraction) + following * fraction)))
+        samples = resampled
+    return samples
+
+
+def readHeader(fileName, endMarker):
+    with open(fileName) as f:
+        text = f.read()
+    text = re.sub(r'//[^\n]*|/\*.*?\*/', '', text, flags=re.S)
+    match = re.search(r'\{(.*?)\}', text, flags=re.S)
+    if match is None:
+        sys.exit('no array found in ' + fileName)
+    samples = [int(v, 0) for v in re.findall(r'0[xX][0-9a-fA-F]+|\d+', match.group(1))]
+    if endMarker and samples and samples[-1] == 0xFF:
+        samples.pop()
+    if any(v > 255 for v in samples):
+        sys.exit('the array must contain 8-bit values')
+    return samples
+
+
+def writeHeader(f, name, codes, source, rate):
+    count = len(codes)
+    if len(codes) % 2:
+        codes = codes + [0]
+    data = [codes[i] | (codes[i + 1] << 4) for i in range(0, len(codes), 2)]
+    f.write('// Generated by adpcmEncode.py from %s: IMA-ADPCM, 4 bits per sample, %d Hz\n\n' % (source, rate))
+    f.write('#include <avr/pgmspace.h>\n#include <stdint.h>\n\n')
+    f.write('const uint16_t %sSamples = %d;\n\n' % (name, count))
+    f.write('const uint8_t %s[] PROGMEM =\n{\n' % name)
+    for i in range(0, len(data), 12):
+        f.write('    ' + ', '.join('0x%02X' % b for b in data[i:i + 12]) + ',\n')
+    f.write('};\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('input', help='WAV-file or C-header with 8-bit samples')
+    parser.add_argument('-o', '--output', default='-', help="header-file to write ('-' for stdout)")
+    parser.add_argument('--name', default='soundDataAdpcm', help='name of the array (default soundDataAdpcm)')
+    parser.add_argument('--rate', type=int, default=8000, help='sample-rate in Hz (default 8000)')
+    parser.add_argument('--end-marker', action='store_true', help='drop a last value 0xFF of a C-array')
+    args = parser.parse_args()
+
+    if args.input.lower().endswith('.wav'):
+        samples = readWav(args.input, args.rate)
+    else:
+        samples = readHeader(args.input, args.end_marker)
+    if len(samples) > 65535:
+        sys.exit('at most 65535 samples are supported')
+
+    codes = encode(samples)
+
+    decoded = decode(codes)
+    squares = sum((a - b) ** 2 for a, b in zip(samples, decoded))
+    rms = (squares / len(samples)) ** 0.5 if samples else 0.0
+    print('%d samples, %d bytes (%d bytes as 8-bit samples), rms-error %.2f LSB'
+          % (len(samples), (len(samples) + 1) // 2, len(samples), rms), file=sys.stderr)
+
+    if args.output == '-':
+        writeHeader(sys.stdout, args.name, codes, args.input, args.rate)
+    else:
+        with open(args.output, 'w') as f:
+            writeHeader(f, args.name, codes, args.input.split('/')[-1], args.rate)
+
+
+if __name__ == '__main__':
+    main()
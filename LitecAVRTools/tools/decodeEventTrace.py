@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+#
+#   decodeEventTrace.py - Turns the frames transmitted by eventTraceDrain()
+#   (EventTrace-module) into a readable timeline.
+#
+#   This is part of the LitecAVRTools library.
+#
+#   Copyright (c) 2018 Wolfgang Zukrigl
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation, either version 3 of the License, or
+#   (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Decodes a dump of the EventTrace-module.
+
+Record the bytes received from the USART into a file (for example with a
+terminal-program that can log binary data), then run:
+
+    python3 decodeEventTrace.py dump.bin --tick-us 0.0625 --names names.txt
+
+--tick-us is the duration of one timestamp-tick in microseconds (for Timer1
+with prescaler 1 at 16 MHz this is 0.0625). The optional names-file contains
+one line per event-ID: "<id> <name>", for example "3 INT0".
+
+The 16-bit timestamps are extended to a continuous time, assuming that two
+consecutive events are less than 65536 ticks apart. Bytes that don't form a
+valid frame (wrong sync-byte or checksum) are skipped.
+"""
+
+import argparse
+import sys
+
+SYNC_BYTE = 0x7E
+FRAME_LENGTH = 6
+ID_DROPPED = 0xFF
+
+
+def readNames(fileName):
+    names = {}
+    if fileName is None:
+        return names
+    with open(fileName) as f:
+        for line in f:
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            eventId, name = line.split(None, 1)
+            names[int(eventId, 0)] = name
+    return names
+
+
+def frames(data):
+    """Yields (timestamp, id, payload) for every valid frame in data."""
+    i = 0
+    while i + FRAME_LENGTH <= len(data):
+        if data[i] != SYNC_BYTE:
+            i += 1
+            continue
+        tsLow, tsHigh, eventId, payload, checksum = data[i + 1:i + FRAME_LENGTH]
+        if (~(tsLow + tsHigh + eventId + payload)) & 0xFF != checksum:
+            i += 1
+            continue
+        yield tsLow | (tsHigh << 8), eventId, payload
+        i += FRAME_LENGTH
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dump', help="file with the received bytes ('-' for stdin)")
+    parser.add_argument('--tick-us', type=float, default=None,
+                        help='microseconds per timestamp-tick (default: print ticks)')
+    parser.add_argument('--names', default=None, help='file with event-names')
+    args = parser.parse_args()
+
+    if args.dump == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.dump, 'rb') as f:
+            data = f.read()
+
+    names = readNames(args.names)
+    unit = 'us' if args.tick_us is not None else 'ticks'
+    scale = args.tick_us if args.tick_us is not None else 1
+
+    print('%14s %12s  %-16s %s' % ('time/' + unit, 'delta/' + unit, 'event', 'payload'))
+
+    time = None
+    lastTimestamp = 0
+    for timestamp, eventId, payload in frames(data):
+        if time is None:
+            time = 0
+            delta = 0
+        else:
+            delta = (timestamp - lastTimestamp) & 0xFFFF
+            time += delta
+        lastTimestamp = timestamp
+
+        if eventId == ID_DROPPED:
+            more = '+' if payload == 0xFF else ''
+            print('%14s %12s  *** %d%s events lost (trace-buffer full) ***' % ('', '', payload, more))
+            continue
+
+        name = names.get(eventId, 'id %d' % eventId)
+        print('%14.3f %12.3f  %-16s 0x%02X (%d)' % (time * scale, delta * scale, name, payload, payload))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,42 @@
+/*
+    avr/interrupt.h - Interrupt-macros for the host-tests in tools/.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// An ISR is an ordinary function, the test calls it to simulate the interrupt. sei() and cli() only change the
+// I-bit in SREG.
+
+#ifndef _AVR_INTERRUPT_H_
+#define _AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define ISR( vector, ... )          extern "C" void vector( void ); extern "C" void vector( void )
+#define EMPTY_INTERRUPT( vector )   extern "C" void vector( void ) {}
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+#define ISR_NAKED
+#define reti()
+
+#define sei()                       ( SREG |= 0x80 )
+#define cli()                       ( SREG &= ~0x80 )
+
+#endif
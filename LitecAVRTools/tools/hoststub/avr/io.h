@@ -0,0 +1,401 @@
+/*
+    avr/io.h - Registers of the ATmega328P for the host-tests in tools/.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Every register is a global variable, which the test can read and write. The peripherals don't do anything by
+// themselves: a test simulates the hardware by setting counters and flags, and calls the interrupt-vectors as
+// functions. hoststub/registers.cpp defines the variables (it includes this file with HOST_DEFINE_REGISTERS).
+//
+// If HOST_TCNT1_HOOK is defined as the name of a function `volatile uint16_t& f()`, every access to TCNT1 calls
+// it. So a test can simulate a counter, that keeps counting between two reads.
+
+#ifndef _AVR_IO_H_
+#define _AVR_IO_H_
+
+#include <stdint.h>
+
+#define __AVR_ATmega328P__
+
+#define _BV( bit )                  ( 1 << (bit) )
+#define _SFR_IO_ADDR( sfr )         ( static_cast<uint16_t>( reinterpret_cast<uintptr_t>( &(sfr) ) ) )
+#define _SFR_MEM_ADDR( sfr )        ( static_cast<uint16_t>( reinterpret_cast<uintptr_t>( &(sfr) ) ) )
+#define RAMEND                      0x8FF
+
+// SystemClock.h uses this builtin of avr-gcc in delayMicroseconds()
+#define __builtin_avr_delay_cycles( cycles )    ( (void)(cycles) )
+
+#ifdef HOST_DEFINE_REGISTERS
+#define HOST_REGISTER( type, name )     volatile type host##name
+#else
+#define HOST_REGISTER( type, name )     extern volatile type host##name
+#endif
+
+// Timer/Counter0
+HOST_REGISTER( uint8_t, TCCR0A );
+HOST_REGISTER( uint8_t, TCCR0B );
+HOST_REGISTER( uint8_t, TCNT0 );
+HOST_REGISTER( uint8_t, OCR0A );
+HOST_REGISTER( uint8_t, OCR0B );
+HOST_REGISTER( uint8_t, TIMSK0 );
+HOST_REGISTER( uint8_t, TIFR0 );
+
+// Timer/Counter1
+HOST_REGISTER( uint8_t, TCCR1A );
+HOST_REGISTER( uint8_t, TCCR1B );
+HOST_REGISTER( uint8_t, TCCR1C );
+HOST_REGISTER( uint8_t, TIMSK1 );
+HOST_REGISTER( uint8_t, TIFR1 );
+
+// Timer/Counter2
+HOST_REGISTER( uint8_t, TCCR2A );
+HOST_REGISTER( uint8_t, TCCR2B );
+HOST_REGISTER( uint8_t, TCNT2 );
+HOST_REGISTER( uint8_t, OCR2A );
+HOST_REGISTER( uint8_t, OCR2B );
+HOST_REGISTER( uint8_t, TIMSK2 );
+HOST_REGISTER( uint8_t, TIFR2 );
+HOST_REGISTER( uint8_t, ASSR );
+HOST_REGISTER( uint8_t, GTCCR );
+
+// External interrupts
+HOST_REGISTER( uint8_t, EICRA );
+HOST_REGISTER( uint8_t, EIMSK );
+HOST_REGISTER( uint8_t, EIFR );
+HOST_REGISTER( uint8_t, PCICR );
+HOST_REGISTER( uint8_t, PCIFR );
+HOST_REGISTER( uint8_t, PCMSK0 );
+HOST_REGISTER( uint8_t, PCMSK1 );
+HOST_REGISTER( uint8_t, PCMSK2 );
+
+// ADC and analog comparator
+HOST_REGISTER( uint8_t, ADCSRA );
+HOST_REGISTER( uint8_t, ADCSRB );
+HOST_REGISTER( uint8_t, ADMUX );
+HOST_REGISTER( uint8_t, ADCL );
+HOST_REGISTER( uint8_t, ADCH );
+HOST_REGISTER( uint8_t, DIDR0 );
+HOST_REGISTER( uint8_t, ACSR );
+
+// USART0
+HOST_REGISTER( uint8_t, UCSR0A );
+HOST_REGISTER( uint8_t, UCSR0B );
+HOST_REGISTER( uint8_t, UCSR0C );
+HOST_REGISTER( uint8_t, UDR0 );
+
+// CPU
+HOST_REGISTER( uint8_t, SREG );
+HOST_REGISTER( uint8_t, SMCR );
+HOST_REGISTER( uint8_t, MCUCR );
+HOST_REGISTER( uint8_t, PRR );
+HOST_REGISTER( uint8_t, GPIOR0 );
+HOST_REGISTER( uint8_t, GPIOR1 );
+HOST_REGISTER( uint8_t, GPIOR2 );
+HOST_REGISTER( uint8_t, CLKPR );
+
+// Ports
+HOST_REGISTER( uint8_t, DDRB );
+HOST_REGISTER( uint8_t, PORTB );
+HOST_REGISTER( uint8_t, PINB );
+HOST_REGISTER( uint8_t, DDRC );
+HOST_REGISTER( uint8_t, PORTC );
+HOST_REGISTER( uint8_t, PINC );
+HOST_REGISTER( uint8_t, DDRD );
+HOST_REGISTER( uint8_t, PORTD );
+HOST_REGISTER( uint8_t, PIND );
+
+// 16-bit-registers
+HOST_REGISTER( uint16_t, TCNT1 );
+HOST_REGISTER( uint16_t, OCR1A );
+HOST_REGISTER( uint16_t, OCR1B );
+HOST_REGISTER( uint16_t, ICR1 );
+HOST_REGISTER( uint16_t, ADC );
+HOST_REGISTER( uint16_t, ADCW );
+HOST_REGISTER( uint16_t, UBRR0 );
+
+#undef HOST_REGISTER
+
+#define TCCR0A                      hostTCCR0A
+#define TCCR0B                      hostTCCR0B
+#define TCNT0                       hostTCNT0
+#define OCR0A                       hostOCR0A
+#define OCR0B                       hostOCR0B
+#define TIMSK0                      hostTIMSK0
+#define TIFR0                       hostTIFR0
+
+#define TCCR1A                      hostTCCR1A
+#define TCCR1B                      hostTCCR1B
+#define TCCR1C                      hostTCCR1C
+#define TIMSK1                      hostTIMSK1
+#define TIFR1                       hostTIFR1
+
+#define TCCR2A                      hostTCCR2A
+#define TCCR2B                      hostTCCR2B
+#define TCNT2                       hostTCNT2
+#define OCR2A                       hostOCR2A
+#define OCR2B                       hostOCR2B
+#define TIMSK2                      hostTIMSK2
+#define TIFR2                       hostTIFR2
+#define ASSR                        hostASSR
+#define GTCCR                       hostGTCCR
+
+#define EICRA                       hostEICRA
+#define EIMSK                       hostEIMSK
+#define EIFR                        hostEIFR
+#define PCICR                       hostPCICR
+#define PCIFR                       hostPCIFR
+#define PCMSK0                      hostPCMSK0
+#define PCMSK1                      hostPCMSK1
+#define PCMSK2                      hostPCMSK2
+
+#define ADCSRA                      hostADCSRA
+#define ADCSRB                      hostADCSRB
+#define ADMUX                       hostADMUX
+#define ADCL                        hostADCL
+#define ADCH                        hostADCH
+#define DIDR0                       hostDIDR0
+#define ACSR                        hostACSR
+
+#define UCSR0A                      hostUCSR0A
+#define UCSR0B                      hostUCSR0B
+#define UCSR0C                      hostUCSR0C
+#define UDR0                        hostUDR0
+
+#define SREG                        hostSREG
+#define SMCR                        hostSMCR
+#define MCUCR                       hostMCUCR
+#define PRR                         hostPRR
+#define GPIOR0                      hostGPIOR0
+#define GPIOR1                      hostGPIOR1
+#define GPIOR2                      hostGPIOR2
+#define CLKPR                       hostCLKPR
+
+#define DDRB                        hostDDRB
+#define PORTB                       hostPORTB
+#define PINB                        hostPINB
+#define DDRC                        hostDDRC
+#define PORTC                       hostPORTC
+#define PINC                        hostPINC
+#define DDRD                        hostDDRD
+#define PORTD                       hostPORTD
+#define PIND                        hostPIND
+
+#ifdef HOST_TCNT1_HOOK
+volatile uint16_t& HOST_TCNT1_HOOK();
+#define TCNT1                       HOST_TCNT1_HOOK()
+#else
+#define TCNT1                       hostTCNT1
+#endif
+#define OCR1A                       hostOCR1A
+#define OCR1B                       hostOCR1B
+#define ICR1                        hostICR1
+#define ADC                         hostADC
+#define ADCW                        hostADCW
+#define UBRR0                       hostUBRR0
+
+// Bits
+
+// TCCR0A/TCCR0B/TIMSK0/TIFR0
+#define WGM00                       0
+#define WGM01                       1
+#define COM0B0                      4
+#define COM0B1                      5
+#define COM0A0                      6
+#define COM0A1                      7
+#define CS00                        0
+#define CS01                        1
+#define CS02                        2
+#define WGM02                       3
+#define FOC0B                       6
+#define FOC0A                       7
+#define TOIE0                       0
+#define OCIE0A                      1
+#define OCIE0B                      2
+#define TOV0                        0
+#define OCF0A                       1
+#define OCF0B                       2
+
+// TCCR1A/TCCR1B/TCCR1C/TIMSK1/TIFR1
+#define WGM10                       0
+#define WGM11                       1
+#define COM1B0                      4
+#define COM1B1                      5
+#define COM1A0                      6
+#define COM1A1                      7
+#define CS10                        0
+#define CS11                        1
+#define CS12                        2
+#define WGM12                       3
+#define WGM13                       4
+#define ICES1                       6
+#define ICNC1                       7
+#define FOC1B                       6
+#define FOC1A                       7
+#define TOIE1                       0
+#define OCIE1A                      1
+#define OCIE1B                      2
+#define ICIE1                       5
+#define TOV1                        0
+#define OCF1A                       1
+#define OCF1B                       2
+#define ICF1                        5
+
+// TCCR2A/TCCR2B/TIMSK2/TIFR2/ASSR/GTCCR
+#define WGM20                       0
+#define WGM21                       1
+#define COM2B0                      4
+#define COM2B1                      5
+#define COM2A0                      6
+#define COM2A1                      7
+#define CS20                        0
+#define CS21                        1
+#define CS22                        2
+#define WGM22                       3
+#define FOC2B                       6
+#define FOC2A                       7
+#define TOIE2                       0
+#define OCIE2A                      1
+#define OCIE2B                      2
+#define TOV2                        0
+#define OCF2A                       1
+#define OCF2B                       2
+#define TCR2BUB                     0
+#define TCR2AUB                     1
+#define OCR2BUB                     2
+#define OCR2AUB                     3
+#define TCN2UB                      4
+#define AS2                         5
+#define EXCLK                       6
+#define PSRSYNC                     0
+#define PSR10                       0
+#define PSRASY                      1
+#define PSR2                        1
+#define TSM                         7
+
+// EICRA/EIMSK/EIFR/PCICR
+#define ISC00                       0
+#define ISC01                       1
+#define ISC10                       2
+#define ISC11                       3
+#define INT0                        0
+#define INT1                        1
+#define INTF0                       0
+#define INTF1                       1
+#define PCIE0                       0
+#define PCIE1                       1
+#define PCIE2                       2
+
+// ADCSRA/ADCSRB/ADMUX/ACSR
+#define ADPS0                       0
+#define ADPS1                       1
+#define ADPS2                       2
+#define ADIE                        3
+#define ADIF                        4
+#define ADATE                       5
+#define ADSC                        6
+#define ADEN                        7
+#define ADTS0                       0
+#define ADTS1                       1
+#define ADTS2                       2
+#define ACME                        6
+#define MUX0                        0
+#define MUX1                        1
+#define MUX2                        2
+#define MUX3                        3
+#define ADLAR                       5
+#define REFS0                       6
+#define REFS1                       7
+#define ACIS0                       0
+#define ACIS1                       1
+#define ACIC                        2
+#define ACIE                        3
+#define ACI                         4
+#define ACO                         5
+#define ACBG                        6
+#define ACD                         7
+
+// UCSR0A/UCSR0B/UCSR0C
+#define MPCM0                       0
+#define U2X0                        1
+#define UPE0                        2
+#define DOR0                        3
+#define FE0                         4
+#define UDRE0                       5
+#define TXC0                        6
+#define RXC0                        7
+#define TXB80                       0
+#define RXB80                       1
+#define UCSZ02                      2
+#define TXEN0                       3
+#define RXEN0                       4
+#define UDRIE0                      5
+#define TXCIE0                      6
+#define RXCIE0                      7
+#define UCPOL0                      0
+#define UCSZ00                      1
+#define UCSZ01                      2
+#define USBS0                       3
+#define UPM00                       4
+#define UPM01                       5
+#define UMSEL00                     6
+#define UMSEL01                     7
+
+// SMCR/PRR
+#define SE                          0
+#define SM0                         1
+#define SM1                         2
+#define SM2                         3
+#define PRADC                       0
+#define PRUSART0                    1
+#define PRSPI                       2
+#define PRTIM1                      3
+#define PRTIM0                      5
+#define PRTIM2                      6
+#define PRTWI                       7
+
+// Interrupt-vectors: an ISR is an extern "C"-function, which the test calls directly
+#define INT0_vect                   __vector_1
+#define INT1_vect                   __vector_2
+#define PCINT0_vect                 __vector_3
+#define PCINT1_vect                 __vector_4
+#define PCINT2_vect                 __vector_5
+#define WDT_vect                    __vector_6
+#define TIMER2_COMPA_vect           __vector_7
+#define TIMER2_COMPB_vect           __vector_8
+#define TIMER2_OVF_vect             __vector_9
+#define TIMER1_CAPT_vect            __vector_10
+#define TIMER1_COMPA_vect           __vector_11
+#define TIMER1_COMPB_vect           __vector_12
+#define TIMER1_OVF_vect             __vector_13
+#define TIMER0_COMPA_vect           __vector_14
+#define TIMER0_COMPB_vect           __vector_15
+#define TIMER0_OVF_vect             __vector_16
+#define SPI_STC_vect                __vector_17
+#define USART_RX_vect               __vector_18
+#define USART_UDRE_vect             __vector_19
+#define USART_TX_vect               __vector_20
+#define ADC_vect                    __vector_21
+#define EE_READY_vect               __vector_22
+#define ANALOG_COMP_vect            __vector_23
+#define TWI_vect                    __vector_24
+#define SPM_READY_vect              __vector_25
+
+#endif
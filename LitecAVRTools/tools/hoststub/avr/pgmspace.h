@@ -0,0 +1,38 @@
+/*
+    avr/pgmspace.h - Program-memory-macros for the host-tests in tools/.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// The host has only one address-space, so PROGMEM-data is read like any other data.
+
+#ifndef _AVR_PGMSPACE_H_
+#define _AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR( s )                   (s)
+#define pgm_read_byte( address )    ( *reinterpret_cast<const uint8_t*>( address ) )
+#define pgm_read_word( address )    ( *reinterpret_cast<const uint16_t*>( address ) )
+#define pgm_read_dword( address )   ( *reinterpret_cast<const uint32_t*>( address ) )
+#define pgm_read_ptr( address )     ( *reinterpret_cast<void* const*>( address ) )
+
+#endif
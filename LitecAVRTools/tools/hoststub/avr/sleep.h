@@ -0,0 +1,43 @@
+/*
+    avr/sleep.h - Sleep-macros for the host-tests in tools/.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _AVR_SLEEP_H_
+#define _AVR_SLEEP_H_
+
+#include <avr/io.h>
+
+#define SLEEP_MODE_IDLE             0
+#define SLEEP_MODE_ADC              _BV(SM0)
+#define SLEEP_MODE_PWR_DOWN         _BV(SM1)
+#define SLEEP_MODE_PWR_SAVE         ( _BV(SM0) | _BV(SM1) )
+#define SLEEP_MODE_STANDBY          ( _BV(SM1) | _BV(SM2) )
+#define SLEEP_MODE_EXT_STANDBY      ( _BV(SM0) | _BV(SM1) | _BV(SM2) )
+
+#define set_sleep_mode( mode )      ( SMCR = ( SMCR & ~( _BV(SM0) | _BV(SM1) | _BV(SM2) ) ) | (mode) )
+#define sleep_enable()              ( SMCR |= _BV(SE) )
+#define sleep_disable()             ( SMCR &= ~_BV(SE) )
+#define sleep_cpu()
+#define sleep_mode()                do { sleep_enable(); sleep_cpu(); sleep_disable(); } while ( 0 )
+#define sleep_bod_disable()
+
+#endif
@@ -0,0 +1,37 @@
+/*
+    util/atomic.h - ATOMIC_BLOCK for the host-tests in tools/.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// The tests run in one thread, so the block is only executed once.
+
+#ifndef _UTIL_ATOMIC_H_
+#define _UTIL_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+#define NONATOMIC_RESTORESTATE
+#define NONATOMIC_FORCEOFF
+
+#define ATOMIC_BLOCK( type )        for ( uint8_t _hostOnce = 1; _hostOnce; _hostOnce = 0 )
+#define NONATOMIC_BLOCK( type )     for ( uint8_t _hostOnce = 1; _hostOnce; _hostOnce = 0 )
+
+#endif
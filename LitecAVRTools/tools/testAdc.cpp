@@ -0,0 +1,346 @@
+/*
+    testAdc.cpp - Host-test of the Adc-module: checks the sequence of the
+    channels, the trigger-flags and the ring-buffers.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -Ihoststub -o testAdc testAdc.cpp ../Adc.cpp
+//         hoststub/registers.cpp && ./testAdc
+//
+// The test writes the result to ADC, clears ADSC like the hardware at the end of a conversion, and calls the
+// interrupt-service-routine. The flags are cleared by writing 1 on the AVR, the stub keeps the written value: the
+// test checks it and clears the flag. The ring-buffers are compared with a model. The exit-code is 0, if all
+// checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "../Adc.h"
+
+
+
+extern "C" void ADC_vect();
+
+static const uint8_t kCapacity = ADC_BUFFER_SIZE - 1;
+static const uint8_t kChannels[ 6 ] = { 0, 1, 2, 3, 4, 5 };
+
+static uint32_t randomState = 1;
+
+
+static uint32_t nextRandom()
+{
+    // xorshift32, so the test is the same on every host
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+
+// The end of a conversion
+static void conversionComplete( uint16_t value )
+{
+    ADC = value;
+    ADCSRA &= ~_BV(ADSC);
+    ADC_vect();
+}
+
+
+// One sequence of count conversions, started by compare-match B of Timer/Counter1. If triggerDuring isn't 0,
+// the next trigger-event comes before the last conversion. Returns the number of errors in the registers.
+static unsigned long runSequence( uint8_t count, uint16_t base, uint8_t triggerDuring = 0 )
+{
+    unsigned long failures = 0;
+
+    TIFR1 = _BV(OCF1B);
+    for ( uint8_t i = 0; i < count; i++ )
+    {
+        failures += ( ( ADMUX & 0x1F ) != kChannels[ i ] );
+        if ( triggerDuring && i == count - 1 )
+        {
+            TIFR1 = _BV(OCF1B);
+        }
+        conversionComplete( base + i );
+
+        // The flag is cleared after the first conversion (the stub keeps the written 1), and after a trigger-event
+        // during the sequence
+        if ( i == 0 || ( triggerDuring && i == count - 1 ) )
+        {
+            failures += ( TIFR1 != _BV(OCF1B) );
+            TIFR1 = 0;
+        }
+
+        // The next channel is started by the interrupt-service-routine, the next sequence by the trigger-event
+        failures += ( ( ( ADCSRA & _BV(ADSC) ) != 0 ) != ( i < count - 1 ) );
+    }
+    failures += ( ( ADMUX & 0x1F ) != kChannels[ 0 ] );
+
+    return failures;
+}
+
+
+static void drain()
+{
+    uint16_t value;
+
+    for ( uint8_t i = 0; i < ADC_SEQUENCE_MAX; i++ )
+    {
+        while ( adcRead( i, &value ) )
+        {
+        }
+    }
+    adcGetOverruns();
+}
+
+
+
+// Checks of the parameters and the registers after adcInit(), adcSetSequence() and adcStart()
+static unsigned long testSetup()
+{
+    unsigned long failures = 0;
+
+    adcInit( ADC_REF_AVCC );
+    failures += ( ADMUX != ADC_REF_AVCC || ADCSRA != ( _BV(ADEN) | _BV(ADIF) | 0x07 ) );
+    failures += ( adcStart( ADC_TRIGGER_TIMER1_COMPB ) != -1 );
+
+    // Invalid channels and counts
+    const uint8_t invalid[ 3 ] = { 9, 13, 16 };
+    for ( uint8_t i = 0; i < 3; i++ )
+    {
+        failures += ( adcSetSequence( &invalid[ i ], 1 ) != -1 );
+    }
+    failures += ( adcSetSequence( kChannels, 0 ) != -1 );
+    uint8_t tooMany[ ADC_SEQUENCE_MAX + 1 ] = { 0 };
+    failures += ( adcSetSequence( tooMany, ADC_SEQUENCE_MAX + 1 ) != -1 );
+    failures += ( DIDR0 != 0 );
+
+    // ADC6, ADC7 and the internal channels have no digital input-buffer
+    const uint8_t noBuffer[ 5 ] = { 6, 7, ADC_CHANNEL_TEMPERATURE, ADC_CHANNEL_BANDGAP, ADC_CHANNEL_GND };
+    failures += ( adcSetSequence( noBuffer, 5 ) != 0 || DIDR0 != 0 );
+
+    failures += ( adcSetSequence( kChannels, 6 ) != 0 || DIDR0 != 0x3F );
+    TIMSK1 = 0;
+    TIFR1 = 0;
+    failures += ( adcStart( ADC_TRIGGER_TIMER1_COMPB ) != 0 );
+    failures += ( ( ADCSRB & 0x07 ) != ADC_TRIGGER_TIMER1_COMPB || ADMUX != ADC_REF_AVCC );
+    failures += ( ADCSRA != ( _BV(ADEN) | _BV(ADIF) | _BV(ADATE) | _BV(ADIE) | 0x07 ) );
+
+    // The old trigger-event was cleared
+    failures += ( TIFR1 != _BV(OCF1B) );
+    TIFR1 = 0;
+
+    // Not while the sequence is running
+    failures += ( adcSetSequence( kChannels, 2 ) != -1 );
+    failures += ( adcConvert( 1 ) != -1 );
+    failures += ( adcStart( ADC_TRIGGER_FREE_RUNNING ) != -1 );
+
+    adcStop();
+    failures += ( ADCSRA != ( _BV(ADEN) | _BV(ADIF) | 0x07 ) );
+
+    // A new reference is used for the sequence, that is already set
+    adcInit( ADC_REF_INTERNAL_1V1 );
+    failures += ( adcStart( ADC_TRIGGER_TIMER0_OVF ) != 0 );
+    failures += ( ADMUX != ADC_REF_INTERNAL_1V1 || ( ADCSRB & 0x07 ) != ADC_TRIGGER_TIMER0_OVF );
+    adcStop();
+    adcInit( ADC_REF_AVCC );
+
+    return failures;
+}
+
+
+
+// The channels of a sequence, the trigger-flags and the overruns by a trigger-event during the sequence
+static unsigned long testSequence()
+{
+    unsigned long failures = 0;
+    uint16_t value;
+
+    adcInit( ADC_REF_AVCC );
+    adcSetSequence( kChannels, 6 );
+    TIMSK1 = 0;
+    adcStart( ADC_TRIGGER_TIMER1_COMPB );
+    drain();
+
+    failures += runSequence( 6, 100 );
+    for ( uint8_t i = 0; i < 6; i++ )
+    {
+        failures += ( adcAvailable( i ) != 1 );
+        failures += ( adcRead( i, &value ) != 1 || value != 100 + i );
+        failures += ( adcRead( i, &value ) != 0 || adcAvailable( i ) != 0 );
+    }
+    failures += ( adcRead( ADC_SEQUENCE_MAX, &value ) != 0 || adcAvailable( ADC_SEQUENCE_MAX ) != 0 );
+    failures += ( adcGetOverruns() != 0 );
+
+    // A trigger-event during the sequence is lost
+    failures += runSequence( 6, 200, 1 );
+    failures += ( adcGetOverruns() != 1 || adcGetOverruns() != 0 );
+    drain();
+
+    // With the interrupt of the trigger-event enabled, its interrupt-service-routine clears the flag
+    adcStop();
+    TIMSK1 = _BV(OCIE1B);
+    TIFR1 = 0;
+    adcStart( ADC_TRIGGER_TIMER1_COMPB );
+    failures += ( TIFR1 != 0 );
+    TIFR1 = _BV(OCF1B);
+    conversionComplete( 1 );
+    failures += ( TIFR1 != _BV(OCF1B) );
+    TIMSK1 = 0;
+    TIFR1 = 0;
+
+    // ACI is cleared with read-modify-write, the settings of the comparator stay
+    adcStop();
+    ACSR = _BV(ACIS1) | _BV(ACIS0) | _BV(ACI);
+    adcStart( ADC_TRIGGER_ANALOG_COMPARATOR );
+    failures += ( ACSR != ( _BV(ACIS1) | _BV(ACIS0) | _BV(ACI) ) );
+    ACSR = 0;
+
+    // Free-running with one channel: the ADC starts the conversions itself
+    adcStop();
+    const uint8_t one[ 1 ] = { 3 };
+    failures += ( adcSetSequence( one, 1 ) != 0 );
+    failures += ( adcStart( ADC_TRIGGER_FREE_RUNNING ) != 0 );
+    failures += ( ( ADCSRA & _BV(ADSC) ) == 0 || ( ADCSRB & 0x07 ) != 0 || ( ADMUX & 0x1F ) != 3 );
+    for ( uint16_t i = 0; i < kCapacity; i++ )
+    {
+        ADC = 500 + i;
+        ADC_vect();
+        failures += ( ( ADMUX & 0x1F ) != 3 );
+    }
+    for ( uint16_t i = 0; i < kCapacity; i++ )
+    {
+        failures += ( adcRead( 0, &value ) != 1 || value != 500 + i );
+    }
+    failures += ( adcGetOverruns() != 0 );
+
+    adcStop();
+    return failures;
+}
+
+
+
+// Random sequences, conversions and reads, compared with a model of the ring-buffers
+static unsigned long testRingBuffers()
+{
+    unsigned long failures = 0;
+    uint16_t model[ ADC_SEQUENCE_MAX ][ ADC_BUFFER_SIZE ];
+    uint8_t modelFirst[ ADC_SEQUENCE_MAX ];
+    uint8_t modelCount[ ADC_SEQUENCE_MAX ];
+
+    for ( int run = 0; run < 2000; run++ )
+    {
+        uint8_t channels[ ADC_SEQUENCE_MAX ];
+        uint8_t count = 1 + nextRandom() % ADC_SEQUENCE_MAX;
+        for ( uint8_t i = 0; i < count; i++ )
+        {
+            channels[ i ] = nextRandom() % 6;
+            modelFirst[ i ] = 0;
+            modelCount[ i ] = 0;
+        }
+        adcStop();
+        failures += ( adcSetSequence( channels, count ) != 0 );
+        failures += ( adcStart( ADC_TRIGGER_TIMER1_OVF ) != 0 );
+        TIFR1 = 0;
+        adcGetOverruns();
+        unsigned long overruns = 0;
+
+        for ( int step = 0; step < 100; step++ )
+        {
+            // A few sequences
+            uint8_t sequences = nextRandom() % 4;
+            for ( uint8_t s = 0; s < sequences; s++ )
+            {
+                for ( uint8_t i = 0; i < count; i++ )
+                {
+                    failures += ( ( ADMUX & 0x1F ) != channels[ i ] );
+                    uint16_t value = nextRandom() & 0x03FF;
+                    conversionComplete( value );
+                    TIFR1 = 0;      // The flag, cleared after the first conversion
+                    if ( modelCount[ i ] < kCapacity )
+                    {
+                        model[ i ][ ( modelFirst[ i ] + modelCount[ i ] ) % ADC_BUFFER_SIZE ] = value;
+                        modelCount[ i ]++;
+                    }
+                    else
+                    {
+                        overruns++;
+                    }
+                }
+            }
+
+            // A few reads of each position
+            for ( uint8_t i = 0; i < count; i++ )
+            {
+                failures += ( adcAvailable( i ) != modelCount[ i ] );
+                uint8_t reads = nextRandom() % 4;
+                for ( uint8_t r = 0; r < reads; r++ )
+                {
+                    uint16_t value;
+                    uint8_t available = adcRead( i, &value );
+                    failures += ( available != ( modelCount[ i ] != 0 ) );
+                    if ( available && modelCount[ i ] != 0 )
+                    {
+                        failures += ( value != model[ i ][ modelFirst[ i ] ] );
+                        modelFirst[ i ] = ( modelFirst[ i ] + 1 ) % ADC_BUFFER_SIZE;
+                        modelCount[ i ]--;
+                    }
+                }
+            }
+
+            if ( nextRandom() % 8 == 0 )
+            {
+                failures += ( adcGetOverruns() != ( overruns > 255 ? 255 : overruns ) );
+                overruns = 0;
+            }
+        }
+    }
+
+    // The count of overruns saturates, and is cleared by reading it
+    adcGetOverruns();
+    for ( int i = 0; i < 300 * ADC_SEQUENCE_MAX; i++ )
+    {
+        conversionComplete( 0 );
+        TIFR1 = 0;
+    }
+    failures += ( adcGetOverruns() != 255 );
+    failures += ( adcGetOverruns() != 0 );
+
+    adcStop();
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresSetup = testSetup();
+    unsigned long failuresSequence = testSequence();
+    unsigned long failuresBuffers = testRingBuffers();
+
+    printf( "setup: %lu failures\nsequence: %lu failures\nring-buffers: %lu failures\n",
+            failuresSetup, failuresSequence, failuresBuffers );
+
+    return ( failuresSetup || failuresSequence || failuresBuffers ) ? 1 : 0;
+}
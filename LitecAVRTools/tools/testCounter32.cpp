@@ -0,0 +1,358 @@
+/*
+    testCounter32.cpp - Host-test of the Counter32-module: checks reading
+    with pending overflows and the arming of targets.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -DHOST_TCNT1_HOOK=simulatedTcnt1 -Ihoststub -o testCounter32
+//         testCounter32.cpp ../Counter32.cpp ../Timer16Bit.cpp hoststub/registers.cpp && ./testCounter32
+//
+// The test counts the events itself and sets TOV1 and OCF1A like the hardware. The interrupt-service-routines are
+// called after each count, or later to simulate a delayed interrupt. The flags are cleared by writing 1 on the AVR:
+// each call into the module runs with the unused bit 7 of TIFR1 set as a marker, if the marker is gone afterwards,
+// the written 1-bits clear the flags. For the race between reading the counter and arming the target, every access
+// to TCNT1 can advance the counter. The exit-code is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "../Counter32.h"
+
+
+
+extern "C" void TIMER1_OVF_vect();
+extern "C" void TIMER1_COMPA_vect();
+
+static const uint8_t kMarker = 0x80;
+
+static uint8_t flags;               // The interrupt-flags of the simulated hardware
+static uint8_t raisedInCall;        // The flags set during the actual call into the module
+static uint16_t countsPerAccess;    // Counts added by each access to TCNT1
+
+static unsigned long callbackCalls;
+static uint32_t callbackValue;
+
+static uint32_t randomState = 1;
+
+
+static uint32_t nextRandom()
+{
+    // xorshift32, so the test is the same on every host
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+
+static void raiseFlags( uint8_t bits )
+{
+    flags |= bits;
+    raisedInCall |= bits;
+    TIFR1 |= bits;
+}
+
+
+// One count of the hardware-counter
+static void tick()
+{
+    hostTCNT1++;
+    if ( hostTCNT1 == 0 )
+    {
+        raiseFlags( _BV(TOV1) );
+    }
+    if ( hostTCNT1 == OCR1A )
+    {
+        raiseFlags( _BV(OCF1A) );
+    }
+}
+
+
+volatile uint16_t& simulatedTcnt1()
+{
+    for ( uint16_t i = 0; i < countsPerAccess; i++ )
+    {
+        tick();
+    }
+    return hostTCNT1;
+}
+
+
+static void beginCall()
+{
+    raisedInCall = 0;
+    TIFR1 = flags | kMarker;
+}
+
+
+static void endCall()
+{
+    if ( ( TIFR1 & kMarker ) == 0 )
+    {
+        flags &= ~( TIFR1 & ~raisedInCall );
+    }
+    TIFR1 = flags;
+}
+
+
+template< typename T > static T endCall( T value )
+{
+    endCall();
+    return value;
+}
+
+// Runs a call into the module with the write-1-to-clear-semantics of TIFR1
+#define CALL( call )                ( beginCall(), endCall( call ) )
+#define CALL_VOID( call )           ( beginCall(), call, endCall() )
+
+
+// Executes the pending and enabled interrupts, the hardware clears the flag at the start of the routine
+static void service()
+{
+    if ( ( flags & _BV(OCF1A) ) && ( TIMSK1 & _BV(OCIE1A) ) )
+    {
+        flags &= ~_BV(OCF1A);
+        CALL_VOID( TIMER1_COMPA_vect() );
+    }
+    if ( ( flags & _BV(TOV1) ) && ( TIMSK1 & _BV(TOIE1) ) )
+    {
+        flags &= ~_BV(TOV1);
+        CALL_VOID( TIMER1_OVF_vect() );
+    }
+}
+
+
+// Counts without executing the interrupts
+static void count( uint32_t n )
+{
+    while ( n-- != 0 )
+    {
+        tick();
+    }
+    TIFR1 = flags;
+}
+
+
+// Counts and executes the interrupts after each count
+static void run( uint32_t n )
+{
+    while ( n-- != 0 )
+    {
+        tick();
+        service();
+    }
+}
+
+
+static void callback()
+{
+    callbackCalls++;
+    callbackValue = counter32Read();
+}
+
+
+static void start()
+{
+    flags = 0;
+    countsPerAccess = 0;
+    CALL( counter32Init( T16_RISING ) );
+    flags = 0;
+    TIFR1 = 0;
+}
+
+
+
+// Initialization, counting with executed and with pending overflow-interrupts, counter32Extend() and stop
+static unsigned long testCounting()
+{
+    unsigned long failures = 0;
+
+    failures += ( CALL( counter32Init( T16_CLK_OFF ) ) != -1 );
+    start();
+    failures += ( ( TCCR1B & 0x07 ) != T16_RISING || TIMSK1 != _BV(TOIE1) || counter32Read() != 0 );
+
+    run( 200000 );
+    failures += ( CALL( counter32Read() ) != 200000 );
+
+    // A pending overflow is counted, if the hardware-counter is below 0x8000
+    for ( int i = 0; i < 20000; i++ )
+    {
+        uint32_t value = nextRandom();
+        uint32_t n = nextRandom() % 0x8000;
+        CALL_VOID( counter32Write( value ) );
+        failures += ( ( flags & _BV(TOV1) ) != 0 );
+        count( n );
+        failures += ( CALL( counter32Read() ) != value + n );
+        service();
+        failures += ( CALL( counter32Read() ) != value + n );
+    }
+
+    // A value read before the overflow, and one read after it
+    CALL_VOID( counter32Write( 0x1234FFF0UL ) );
+    uint16_t before = counter32ReadLow();
+    count( 0x20 );
+    uint16_t after = counter32ReadLow();
+    failures += ( CALL( counter32Extend( before ) ) != 0x1234FFF0UL );
+    failures += ( CALL( counter32Extend( after ) ) != 0x12350010UL );
+    service();
+    failures += ( CALL( counter32Extend( after ) ) != 0x12350010UL );
+
+    // Stopping with a pending overflow
+    CALL_VOID( counter32Write( 0x0001FFF0UL ) );
+    count( 0x20 );
+    CALL_VOID( counter32Stop() );
+    failures += ( ( TCCR1B & 0x07 ) != 0 || TIMSK1 != 0 );
+    failures += ( CALL( counter32Read() ) != 0x00020010UL );
+
+    return failures;
+}
+
+
+
+// Targets in the actual, a later and a past overflow-period, at the overflow, and cancelled targets
+static unsigned long testTargets()
+{
+    unsigned long failures = 0;
+
+    start();
+    callbackCalls = 0;
+    CALL_VOID( counter32Write( 0x00030010UL ) );
+
+    // In a later overflow-period
+    failures += ( CALL( counter32SetTarget( 0x00050123UL, callback ) ) != 0 );
+    run( 0x00050122UL - 0x00030010UL );
+    failures += ( callbackCalls != 0 || counter32IsTargetReached() );
+    run( 1 );
+    failures += ( callbackCalls != 1 || callbackValue != 0x00050123UL || ! counter32IsTargetReached() );
+    run( 200000 );
+    failures += ( callbackCalls != 1 );
+
+    // In the past: reached without calling the callback
+    failures += ( CALL( counter32SetTarget( counter32Read() - 5, callback ) ) != 1 );
+    failures += ( callbackCalls != 1 || ! counter32IsTargetReached() );
+
+    // In the actual overflow-period
+    uint32_t now = counter32Read();
+    failures += ( CALL( counter32SetTarget( now + 10, callback ) ) != 0 );
+    run( 9 );
+    failures += ( callbackCalls != 1 );
+    run( 1 );
+    failures += ( callbackCalls != 2 || callbackValue != now + 10 );
+
+    // With the lower 16 bits 0: reached by the overflow-interrupt
+    now = counter32Read();
+    uint32_t target = ( now + 0x10000 ) & 0xFFFF0000UL;
+    CALL( counter32SetTarget( target, callback ) );
+    run( target - now - 1 );
+    failures += ( callbackCalls != 2 );
+    run( 1 );
+    failures += ( callbackCalls != 3 || callbackValue != target );
+
+    // The overflow-interrupt is executed after the target of its overflow-period
+    now = counter32Read();
+    target = ( ( now + 0x10000 ) & 0xFFFF0000UL ) + 3;
+    CALL( counter32SetTarget( target, callback ) );
+    run( target - now - 4 );
+    count( 10 );
+    service();
+    failures += ( callbackCalls != 4 || ! counter32IsTargetReached() );
+
+    // Cancelled, and cancelled by counter32Write()
+    now = counter32Read();
+    CALL( counter32SetTarget( now + 100, callback ) );
+    CALL_VOID( counter32CancelTarget() );
+    run( 200 );
+    failures += ( callbackCalls != 4 || counter32IsTargetReached() );
+    CALL( counter32SetTarget( now + 1000, callback ) );
+    CALL_VOID( counter32Write( now ) );
+    run( 2000 );
+    failures += ( callbackCalls != 4 || counter32IsTargetReached() );
+
+    // Random counter-values and targets up to 3 overflow-periods ahead: reached exactly once, at the target
+    for ( int i = 0; i < 2000; i++ )
+    {
+        now = nextRandom();
+        target = now + 1 + nextRandom() % 0x30000;
+        CALL_VOID( counter32Write( now ) );
+        callbackCalls = 0;
+        failures += ( CALL( counter32SetTarget( target, callback ) ) != 0 );
+        run( target - now - 1 );
+        failures += ( callbackCalls != 0 );
+        run( 1 );
+        failures += ( callbackCalls != 1 || callbackValue != target );
+    }
+
+    return failures;
+}
+
+
+
+// The counter passes the target and the end of the overflow-period, while counter32SetTarget() arms the target
+static unsigned long testWrapWhileArming()
+{
+    unsigned long failures = 0;
+
+    start();
+    CALL_VOID( counter32Write( 0x0003FFFCUL ) );
+    callbackCalls = 0;
+    countsPerAccess = 2;
+    failures += ( CALL( counter32SetTarget( 0x0003FFFFUL, callback ) ) != 1 );
+    countsPerAccess = 0;
+    failures += ( ! counter32IsTargetReached() || ( TIMSK1 & _BV(OCIE1A) ) != 0 );
+    run( 0x20000 );
+    failures += ( callbackCalls != 0 );
+
+    // Targets close to the end of the period, with 1 .. 4 counts per access: either reached at once, or by the
+    // compare-match-interrupt later
+    for ( uint16_t speed = 1; speed <= 4; speed++ )
+    {
+        for ( uint16_t distance = 1; distance < 40; distance++ )
+        {
+            CALL_VOID( counter32Write( 0x0005FFF0UL ) );
+            callbackCalls = 0;
+            countsPerAccess = speed;
+            uint8_t reached = CALL( counter32SetTarget( 0x0005FFF0UL + distance, callback ) );
+            countsPerAccess = 0;
+            run( 0x20000 );
+            failures += ( ! counter32IsTargetReached() || callbackCalls != ( reached ? 0 : 1U ) );
+        }
+    }
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresCounting = testCounting();
+    unsigned long failuresTargets = testTargets();
+    unsigned long failuresWrap = testWrapWhileArming();
+
+    printf( "counting: %lu failures\ntargets: %lu failures\nwrap while arming: %lu failures\n",
+            failuresCounting, failuresTargets, failuresWrap );
+
+    return ( failuresCounting || failuresTargets || failuresWrap ) ? 1 : 0;
+}
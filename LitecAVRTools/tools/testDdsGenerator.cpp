@@ -0,0 +1,200 @@
+/*
+    testDdsGenerator.cpp - Host-test of the DdsGenerator-module: checks the
+    phase-increments, the wave-tables and the output-range.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -Ihoststub -o testDdsGenerator testDdsGenerator.cpp
+//         ../DdsGenerator.cpp ../Timer16Bit.cpp hoststub/registers.cpp && ./testDdsGenerator
+//
+// The overflow-interrupt-service-routine is called once per sample, the output is the value written to OCR1A. The
+// phase-increment of ddsSetFrequency() is measured by starting just below a step of the sine-table. The exit-code
+// is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "../DdsGenerator.h"
+
+
+
+extern "C" void TIMER1_OVF_vect();
+
+static const uint16_t kTop = F_CPU / DDS_SAMPLE_RATE - 1;
+static const uint16_t kMiddle = ( kTop + 1 ) / 2;
+
+
+
+// The registers of the timer, and the output in the middle of the range after ddsInit() and ddsStop()
+static unsigned long testInitAndStop()
+{
+    unsigned long failures = 0;
+
+    ddsInit();
+    failures += ( ICR1 != kTop || OCR1A != kMiddle );
+    failures += ( TCCR1A != ( _BV(COM1A1) | _BV(WGM11) ) || TCCR1B != ( _BV(WGM13) | _BV(WGM12) | _BV(CS10) ) );
+    failures += ( ( TIMSK1 & _BV(TOIE1) ) == 0 );
+
+    // The amplitude is 0, the frequency is 0
+    for ( int i = 0; i < 1000; i++ )
+    {
+        TIMER1_OVF_vect();
+        failures += ( OCR1A != kMiddle );
+    }
+    ddsSetAmplitude( 0, 255 );
+    for ( int i = 0; i < 1000; i++ )
+    {
+        TIMER1_OVF_vect();
+        failures += ( OCR1A != kMiddle );
+    }
+
+    ddsStop();
+    failures += ( ( TIMSK1 & _BV(TOIE1) ) != 0 || ( TCCR1B & 0x07 ) != 0 );
+
+    return failures;
+}
+
+
+
+// ddsSetFrequency() must give the truncated phase-increment hz * 2^32 / DDS_SAMPLE_RATE, at most 1 less
+static unsigned long testFrequencies()
+{
+    unsigned long failures = 0;
+
+    ddsInit();
+    ddsSetAmplitude( 0, 255 );
+
+    for ( uint32_t hz = 0; hz <= DDS_SAMPLE_RATE / 2 + 100; hz++ )
+    {
+        uint32_t clamped = ( hz > DDS_SAMPLE_RATE / 2 ) ? DDS_SAMPLE_RATE / 2 : hz;
+        uint32_t exact = static_cast<uint32_t>( ( static_cast<uint64_t>( clamped ) << 32 ) / DDS_SAMPLE_RATE );
+        ddsSetFrequency( 0, static_cast<uint16_t>( hz ) );
+
+        // The sine-table steps from 0 to 3 at the phase 2^24. The step is reached, if the increment is >= exact + d.
+        int count = 0;
+        for ( int32_t d = -3; d <= 3; d++ )
+        {
+            ddsSetPhase( 0, 0x01000000UL - ( exact + d ) );
+            TIMER1_OVF_vect();
+            count += ( OCR1A != kMiddle );
+        }
+        failures += ( count != 3 && count != 4 );
+    }
+
+    // Frequencies above DDS_SAMPLE_RATE / 2 are limited to half a period per sample: from the positive to the
+    // negative peak
+    ddsSetFrequency( 0, 40000 );
+    ddsSetPhase( 0, 0x40000000UL );
+    TIMER1_OVF_vect();
+    failures += ( OCR1A != kMiddle - 254 );
+
+    // The macro for constant frequencies
+    failures += ( DDS_PHASE_INCREMENT( 1000 ) != 137438953UL );
+    failures += ( DDS_PHASE_INCREMENT( 440.5 ) != 60541859UL );
+
+    ddsStop();
+    return failures;
+}
+
+
+
+// Exact values of the square-table, zero-crossings of the sine-table and the scaling with the amplitude
+static unsigned long testWaveforms()
+{
+    unsigned long failures = 0;
+
+    ddsInit();
+    ddsSetWaveform( 0, ddsSquareTable );
+    ddsSetAmplitude( 0, 255 );
+
+    // One table-entry per sample: 127 * 255 / 256 = 126 (-127 for the negative half) times 2 output-ticks
+    ddsSetPhaseIncrement( 0, 0x01000000UL );
+    for ( uint16_t k = 1; k <= 1024; k++ )
+    {
+        TIMER1_OVF_vect();
+        failures += ( OCR1A != ( ( k % 256 < 128 ) ? kMiddle + 252 : kMiddle - 254 ) );
+    }
+
+    // The phase of the sine-table: a quarter period is the maximum
+    ddsSetWaveform( 0, ddsSineTable );
+    ddsSetPhaseIncrement( 0, 0 );
+    ddsSetPhase( 0, 0x40000000UL );
+    TIMER1_OVF_vect();
+    failures += ( OCR1A != kMiddle + 252 );
+
+    // A second of 1000 Hz, changed to 1001 Hz after half a second: 1000 rising zero-crossings
+    ddsSetPhase( 0, 0 );
+    ddsSetFrequency( 0, 1000 );
+    uint16_t previous = kMiddle;
+    uint16_t minimum = 0xFFFF;
+    uint16_t maximum = 0;
+    unsigned long crossings = 0;
+    for ( uint32_t n = 0; n < DDS_SAMPLE_RATE; n++ )
+    {
+        if ( n == DDS_SAMPLE_RATE / 2 )
+        {
+            ddsSetFrequency( 0, 1001 );
+        }
+        TIMER1_OVF_vect();
+        uint16_t o = OCR1A;
+        crossings += ( previous < kMiddle && o >= kMiddle );
+        failures += ( o > kTop || ( o > previous ? o - previous : previous - o ) > 60 );
+        minimum = ( o < minimum ) ? o : minimum;
+        maximum = ( o > maximum ) ? o : maximum;
+        previous = o;
+    }
+    failures += ( crossings < 1000 || crossings > 1001 );
+    failures += ( minimum > 10 || maximum < kTop - 10 );
+
+    // Half the amplitude gives half the range
+    ddsSetAmplitude( 0, 128 );
+    minimum = 0xFFFF;
+    maximum = 0;
+    for ( int n = 0; n < 1000; n++ )
+    {
+        TIMER1_OVF_vect();
+        minimum = ( OCR1A < minimum ) ? OCR1A : minimum;
+        maximum = ( OCR1A > maximum ) ? OCR1A : maximum;
+    }
+    failures += ( minimum < kMiddle - 130 || minimum > kMiddle - 120 );
+    failures += ( maximum < kMiddle + 120 || maximum > kMiddle + 130 );
+
+    ddsStop();
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresInit = testInitAndStop();
+    unsigned long failuresFrequencies = testFrequencies();
+    unsigned long failuresWaveforms = testWaveforms();
+
+    printf( "init and stop: %lu failures\nfrequencies: %lu failures\nwaveforms: %lu failures\n",
+            failuresInit, failuresFrequencies, failuresWaveforms );
+
+    return ( failuresInit || failuresFrequencies || failuresWaveforms ) ? 1 : 0;
+}
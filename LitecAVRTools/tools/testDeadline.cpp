@@ -0,0 +1,184 @@
+/*
+    testDeadline.cpp - Host-test of the Deadline-module: checks all
+    comparisons across the overflow of the tick-counter.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with:
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -o testDeadline testDeadline.cpp && ./testDeadline
+//
+// A clock with a settable tick-count replaces millis(). For 16-bit ticks, every pair of start-time and elapsed
+// time is checked for six intervals; for 32-bit ticks, windows around 0 and 2^31 are checked. The exit-code is 0,
+// if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "SystemClock.h"        // The stub in this directory, must be included before Deadline.h
+#include "../Deadline.h"
+
+
+
+unsigned long millis() { return 0; }
+unsigned long micros() { return 0; }
+
+static uint16_t fakeTicks16;
+static uint32_t fakeTicks32;
+
+struct FakeClock16
+{
+    typedef uint16_t Tick;
+    static Tick now() { return fakeTicks16; }
+    static constexpr unsigned long ticksPerSecond() { return 1000; }
+};
+
+struct FakeClock32
+{
+    typedef uint32_t Tick;
+    static Tick now() { return fakeTicks32; }
+    static constexpr unsigned long ticksPerSecond() { return 1000; }
+};
+
+
+static_assert( cyclesFromMicroseconds( 1000 ) == F_CPU / 1000, "cyclesFromMicroseconds" );
+static_assert( Deadline< MicrosClock >::fromMilliseconds( 3 ) == 3000, "fromMilliseconds" );
+static_assert( Deadline< Millis16Clock >::fromMicroseconds( 1499 ) == 1, "fromMicroseconds" );
+
+
+
+static unsigned long test16Bit()
+{
+    static const uint16_t intervals[] = { 0, 1, 1000, 32767, 32768, 65535 };
+    unsigned long failures = 0;
+
+    for ( uint16_t interval : intervals )
+    {
+        for ( uint32_t start = 0; start < 0x10000UL; start++ )
+        {
+            fakeTicks16 = static_cast<uint16_t>( start );
+            Deadline< FakeClock16 > deadline( interval );
+
+            for ( uint32_t elapsed = 0; elapsed < 0x10000UL; elapsed++ )
+            {
+                fakeTicks16 = static_cast<uint16_t>( start + elapsed );
+                uint32_t remaining = ( elapsed >= interval ) ? 0 : interval - elapsed;
+
+                if ( deadline.elapsed() != elapsed || deadline.expired() != ( elapsed >= interval )
+                     || deadline.remaining() != remaining )
+                {
+                    failures++;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+
+
+static unsigned long test32Bit()
+{
+    static const uint32_t intervals[] = { 0, 1, 60000UL, 0x7FFFFFFFUL, 0x80000000UL, 0xFFFFFFFFUL };
+    static const uint32_t windows[] = { 0xFFFF0000UL, 0x7FFF8000UL };
+    unsigned long failures = 0;
+
+    for ( uint32_t interval : intervals )
+    {
+        for ( uint32_t window : windows )
+        {
+            // The start-times cross the overflow (at 0) or the sign-change (at 2^31)
+            for ( uint32_t offset = 0; offset < 0x20000UL; offset++ )
+            {
+                uint32_t start = window + offset;
+                fakeTicks32 = start;
+                Deadline< FakeClock32 > deadline( interval );
+
+                const uint64_t elapsedValues[] = { 0, 1, offset, 0x80000000ULL, uint64_t( interval ) - 1,
+                                                   interval, uint64_t( interval ) + 1, 0xFFFFFFFFULL };
+                for ( uint64_t elapsed : elapsedValues )
+                {
+                    if ( elapsed > 0xFFFFFFFFULL )
+                    {
+                        continue;
+                    }
+                    fakeTicks32 = static_cast<uint32_t>( start + elapsed );
+                    uint64_t remaining = ( elapsed >= interval ) ? 0 : interval - elapsed;
+
+                    if ( deadline.elapsed() != elapsed || deadline.expired() != ( elapsed >= interval )
+                         || deadline.remaining() != remaining )
+                    {
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+
+
+// periodic() must not drift and must catch up missed periods, also across the overflow.
+static unsigned long testPeriodic()
+{
+    unsigned long failures = 0;
+
+    fakeTicks16 = 65000;
+    Deadline< FakeClock16 > every100( 100 );
+    unsigned long count = 0;
+    for ( uint32_t t = 0; t < 100000UL; t++ )
+    {
+        fakeTicks16 = static_cast<uint16_t>( 65000 + t );
+        while ( every100.periodic() )
+        {
+            count++;
+        }
+    }
+    failures += ( count != 999 );
+
+    // Called 350 ticks late: three missed periods are reported at once
+    fakeTicks16 = 65500;
+    Deadline< FakeClock16 > late( 100 );
+    fakeTicks16 = static_cast<uint16_t>( 65500 + 350 );
+    count = 0;
+    while ( late.periodic() )
+    {
+        count++;
+    }
+    failures += ( count != 3 || late.remaining() != 50 );
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failures16 = test16Bit();
+    unsigned long failures32 = test32Bit();
+    unsigned long failuresPeriodic = testPeriodic();
+
+    printf( "16-bit: %lu failures\n32-bit: %lu failures\nperiodic: %lu failures\n",
+            failures16, failures32, failuresPeriodic );
+
+    return ( failures16 || failures32 || failuresPeriodic ) ? 1 : 0;
+}
@@ -0,0 +1,220 @@
+/*
+    testExternalInterruptsTimestamp.cpp - Host-test of the timestamp-queue
+    of the ExternalInterrupts-module: checks the timestamps, the order of
+    the events and the count of lost events.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -DEXTINT_TIMESTAMP_MASK=0x01 -Ihoststub
+//         -o testExternalInterruptsTimestamp testExternalInterruptsTimestamp.cpp ../ExternalInterruptsTimestamp.cpp
+//         ../ExternalInterruptsDispatch.cpp ../ExternalInterrupts.cpp ../Counter32.cpp ../Timer16Bit.cpp
+//         hoststub/registers.cpp && ./testExternalInterruptsTimestamp
+//
+// INT0 (PD2) has the timestamp-interrupt-service-routine, INT1 (PD3) is dispatched to a callback. The test sets
+// the counter of the Counter32-module and PIND before each call of the routine, and keeps a model of the queue.
+// The exit-code is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "../ExternalInterrupts.h"
+#include "../Counter32.h"
+
+
+
+extern "C" void INT0_vect();
+extern "C" void INT1_vect();
+
+static const uint8_t kCapacity = EXTINT_TIMESTAMP_QUEUE_SIZE - 1;
+
+static unsigned long callbackCalls;
+
+static uint32_t randomState = 1;
+
+
+static uint32_t nextRandom()
+{
+    // xorshift32, so the test is the same on every host
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+
+static void callback( void* context )
+{
+    callbackCalls += ( context == &callbackCalls );
+}
+
+
+// An edge on INT0 at the given counter-value, plus the latency of the interrupt-service-routine
+static void edge( uint32_t value, uint8_t level )
+{
+    counter32Write( value + EXTINT_TIMESTAMP_LATENCY );
+    TIFR1 = 0;
+    PIND = level ? 0xFF : 0x00;
+    INT0_vect();
+}
+
+
+static void start()
+{
+    counter32Init( T16_PRESC_1 );
+    TIFR1 = 0;
+
+    ExtIntEvent event;
+    while ( getExtIntEvent( &event ) )
+    {
+    }
+    getLostExtIntEvents();
+}
+
+
+
+// Timestamps and levels, with an overflow of the counter, that is not counted yet, and the dispatched INT1
+static unsigned long testEvents()
+{
+    unsigned long failures = 0;
+    ExtIntEvent event;
+
+    start();
+    failures += ( getExtIntEvent( &event ) != 0 );
+
+    TCNT1 = 1000;
+    PIND = 0x04;
+    INT0_vect();
+
+    // The overflow-interrupt of the Counter32-module is pending
+    counter32Write( 0x0002FFF0UL );
+    TCNT1 = 0x0005;
+    TIFR1 = _BV(TOV1);
+    PIND = 0xFB;
+    INT0_vect();
+    TIFR1 = 0;
+
+    // Read before the overflow
+    TCNT1 = 0xFFF8;
+    TIFR1 = _BV(TOV1);
+    PIND = 0x04;
+    INT0_vect();
+    TIFR1 = 0;
+
+    failures += ( getExtIntEvent( &event ) != 1 );
+    failures += ( event.timestamp != 1000 - EXTINT_TIMESTAMP_LATENCY || event.extIntNumber != 0 || event.level != 1 );
+    failures += ( getExtIntEvent( &event ) != 1 );
+    failures += ( event.timestamp != 0x00030005UL - EXTINT_TIMESTAMP_LATENCY || event.level != 0 );
+    failures += ( getExtIntEvent( &event ) != 1 );
+    failures += ( event.timestamp != 0x0002FFF8UL - EXTINT_TIMESTAMP_LATENCY || event.level != 1 );
+    failures += ( getExtIntEvent( &event ) != 0 );
+
+    // INT1 is not in EXTINT_TIMESTAMP_MASK: its callback is called, no event is queued
+    failures += ( attachExtInt( 0, callback, &callbackCalls ) != -1 );
+    failures += ( attachExtInt( 1, callback, &callbackCalls ) != 0 );
+    INT1_vect();
+    failures += ( callbackCalls != 1 || getExtIntEvent( &event ) != 0 );
+
+    return failures;
+}
+
+
+
+// Random bursts of events and random reads: the order, the contents and the lost events
+static unsigned long testQueue()
+{
+    unsigned long failures = 0;
+    uint32_t modelTimestamps[ EXTINT_TIMESTAMP_QUEUE_SIZE ];
+    uint8_t modelLevels[ EXTINT_TIMESTAMP_QUEUE_SIZE ];
+    uint8_t modelCount = 0;
+    uint8_t modelFirst = 0;
+    unsigned long modelLost = 0;
+
+    start();
+    for ( int run = 0; run < 200000; run++ )
+    {
+        uint8_t edges = nextRandom() % ( kCapacity + 4 );
+        for ( uint8_t i = 0; i < edges; i++ )
+        {
+            uint32_t value = nextRandom();
+            uint8_t level = nextRandom() & 0x01;
+            edge( value, level );
+            if ( modelCount < kCapacity )
+            {
+                uint8_t index = ( modelFirst + modelCount ) % EXTINT_TIMESTAMP_QUEUE_SIZE;
+                modelTimestamps[ index ] = value;
+                modelLevels[ index ] = level;
+                modelCount++;
+            }
+            else
+            {
+                modelLost++;
+            }
+        }
+
+        uint8_t reads = nextRandom() % ( kCapacity + 4 );
+        for ( uint8_t i = 0; i < reads; i++ )
+        {
+            ExtIntEvent event;
+            uint8_t available = getExtIntEvent( &event );
+            failures += ( available != ( modelCount != 0 ) );
+            if ( available && modelCount != 0 )
+            {
+                failures += ( event.timestamp != modelTimestamps[ modelFirst ] );
+                failures += ( event.level != modelLevels[ modelFirst ] || event.extIntNumber != 0 );
+                modelFirst = ( modelFirst + 1 ) % EXTINT_TIMESTAMP_QUEUE_SIZE;
+                modelCount--;
+            }
+        }
+
+        if ( nextRandom() % 16 == 0 )
+        {
+            failures += ( getLostExtIntEvents() != ( modelLost > 255 ? 255 : modelLost ) );
+            modelLost = 0;
+        }
+    }
+
+    // The count of lost events saturates, and is cleared by reading it
+    getLostExtIntEvents();
+    for ( int i = 0; i < 300; i++ )
+    {
+        edge( 0, 0 );
+    }
+    failures += ( getLostExtIntEvents() != 255 );
+    failures += ( getLostExtIntEvents() != 0 );
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresEvents = testEvents();
+    unsigned long failuresQueue = testQueue();
+
+    printf( "events: %lu failures\nqueue: %lu failures\n", failuresEvents, failuresQueue );
+
+    return ( failuresEvents || failuresQueue ) ? 1 : 0;
+}
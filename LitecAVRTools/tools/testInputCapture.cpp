@@ -0,0 +1,217 @@
+/*
+    testInputCapture.cpp - Host-test of the InputCapture-module: checks the
+    32-bit timestamps around timer-overflows and the measurements.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -Ihoststub -o testInputCapture testInputCapture.cpp
+//         ../InputCapture.cpp ../Timer16Bit.cpp hoststub/registers.cpp && ./testInputCapture
+//
+// hoststub/ replaces the AVR-headers: the registers are variables, and the interrupt-service-routines are functions.
+// F_CPU is unsigned int, which has 32 bits like unsigned long on the AVR.
+//
+// Timer1 is simulated with a 64-bit time in ticks. Each edge is captured after a random interrupt-latency, and an
+// overflow that happens during this latency is left pending (TOV1 set), like on the target. The exit-code is 0,
+// if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <avr/io.h>
+
+#include "../InputCapture.h"
+
+
+
+extern "C" void TIMER1_CAPT_vect();
+extern "C" void TIMER1_OVF_vect();
+
+unsigned long millis() { return 0; }
+unsigned long micros() { return 0; }
+
+static uint64_t nextOverflow;
+static uint32_t randomState = 1;
+
+
+static uint32_t nextRandom()
+{
+    // xorshift32, so the test is the same on every host
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+
+static void start( InputCaptureMode mode )
+{
+    inputCaptureInit( mode );
+
+    // The flags are cleared by writing ones to them, which sets them in the stub
+    TIFR1 = 0;
+    nextOverflow = 0x10000;
+}
+
+
+// Executes the overflow-interrupts up to the time `t`
+static void runUntil( uint64_t t )
+{
+    while ( nextOverflow <= t )
+    {
+        TIFR1 &= ~_BV(TOV1);
+        TIMER1_OVF_vect();
+        nextOverflow += 0x10000;
+    }
+}
+
+
+// Captures an edge at time `edge`. Interrupts are disabled from `edge - before` until `edge + latency`. The
+// input-capture-interrupt has the higher priority, so it is executed before the overflow-interrupt, if an overflow
+// happened in this time.
+static void capture( uint64_t edge, uint32_t before, uint32_t latency )
+{
+    runUntil( edge - before );
+    if ( nextOverflow <= edge + latency )
+    {
+        TIFR1 |= _BV(TOV1);
+    }
+    ICR1 = static_cast<uint16_t>( edge );
+    TIMER1_CAPT_vect();
+    TIFR1 &= ~_BV(ICF1);
+    runUntil( edge + latency );
+}
+
+
+
+// Rising edges with random distances and latencies: every timestamp must be exact.
+static unsigned long testTimestamps()
+{
+    unsigned long failures = 0;
+
+    for ( int run = 0; run < 2000; run++ )
+    {
+        start( IC_PERIOD );
+        uint64_t t = nextRandom() % 0x10000;
+        uint32_t latency = 0;
+
+        for ( int i = 0; i < 200; i++ )
+        {
+            // The next edge comes after the interrupt of the previous one, so ICR1 isn't overwritten
+            t += latency + 300 + nextRandom() % ( ( nextRandom() & 1 ) ? 200 : 200000 );
+            latency = nextRandom() % 300;
+            capture( t, nextRandom() % 300, latency );
+
+            InputCaptureEvent event;
+            if ( ! inputCaptureReadEvent( &event ) || event.timestamp != static_cast<uint32_t>( t ) || ! event.rising )
+            {
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+
+
+// A signal with constant period and high-time: frequency, period and duty-cycle of every measurement.
+static unsigned long testMeasurement( InputCaptureMode mode, uint32_t period, uint32_t high, int periods,
+                                      int periodsPerMeasurement )
+{
+    unsigned long failures = 0;
+    int measurements = 0;
+
+    start( mode );
+    for ( int i = 0; i < periods; i++ )
+    {
+        uint64_t rising = 777 + static_cast<uint64_t>( i ) * period;
+        capture( rising, nextRandom() % 40, nextRandom() % 40 );
+        if ( mode == IC_PULSE_WIDTH )
+        {
+            capture( rising + high, nextRandom() % 40, nextRandom() % 40 );
+        }
+
+        if ( i % periodsPerMeasurement == 0 )
+        {
+            InputCaptureMeasurement m;
+            if ( inputCaptureGetMeasurement( &m ) == 0 )
+            {
+                uint64_t frequency = ( 16000000000ULL + period / 2 ) / period;
+                uint16_t duty = ( mode == IC_PULSE_WIDTH ) ? ( 1000ULL * high + period / 2 ) / period : 0;
+                if ( m.periodTicks != period || m.frequencyMilliHz != frequency || m.dutyPerMille != duty )
+                {
+                    failures++;
+                }
+                measurements++;
+            }
+        }
+    }
+
+    // The first call only starts the measurement
+    failures += ( measurements < ( periods - 1 ) / periodsPerMeasurement );
+    failures += ( inputCaptureGetLostEvents() != 0 );
+    return failures;
+}
+
+
+
+// Edges, that don't fit into the ring buffer, are counted up to 255
+static unsigned long testLostEvents()
+{
+    unsigned long failures = 0;
+
+    start( IC_PERIOD );
+    for ( int i = 0; i < INPUT_CAPTURE_BUFFER_SIZE - 1 + 10; i++ )
+    {
+        capture( 1000 + i * 1000UL, 0, 0 );
+    }
+    failures += ( inputCaptureGetLostEvents() != 10 );
+    failures += ( inputCaptureGetLostEvents() != 0 );
+
+    for ( int i = 0; i < 300; i++ )
+    {
+        capture( 100000 + i * 1000UL, 0, 0 );
+    }
+    failures += ( inputCaptureGetLostEvents() != 255 );
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresTimestamps = testTimestamps();
+    unsigned long failuresMeasurement = testMeasurement( IC_FREQUENCY, 160, 40, 20000, 1000 )
+                                        + testMeasurement( IC_PERIOD, 16000, 0, 20000, 10 )
+                                        + testMeasurement( IC_PULSE_WIDTH, 16000, 4000, 20000, 7 )
+                                        + testMeasurement( IC_PULSE_WIDTH, 16001, 8000, 20000, 7 )
+                                        + testMeasurement( IC_PULSE_WIDTH, 1234567, 1000, 20, 3 )
+                                        + testMeasurement( IC_PULSE_WIDTH, 160000000UL, 20000000UL, 20, 3 );
+    unsigned long failuresLost = testLostEvents();
+
+    printf( "timestamps: %lu failures\nmeasurement: %lu failures\nlost events: %lu failures\n",
+            failuresTimestamps, failuresMeasurement, failuresLost );
+
+    return ( failuresTimestamps || failuresMeasurement || failuresLost ) ? 1 : 0;
+}
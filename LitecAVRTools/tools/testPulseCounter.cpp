@@ -0,0 +1,282 @@
+/*
+    testPulseCounter.cpp - Host-test of the PulseCounter-module: checks the
+    counts of the gate-times, the total and the frequency, in both modes.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -Ihoststub -o testPulseCounter testPulseCounter.cpp
+//         ../ExternalInterrupts.cpp ../Timer16Bit.cpp hoststub/registers.cpp && ./testPulseCounter
+//
+// and once more with -DPULSE_COUNTER_RECIPROCAL=1 for the reciprocal mode. PulseCounter.cpp is included, because
+// the counting interrupt-service-routine is written in assembler: it is left out, and the test increments the
+// counter in GPIOR1 and GPIOR2 like the routine does. The gate-timer is simulated with TCNT1, the test calls the
+// compare-match-interrupt-service-routine at the end of each gate-time. The exit-code is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "../ExternalInterrupts.h"
+#include "../GpioPinMacros.h"
+#include "../SystemClock.h"
+#include "../Timer16Bit.h"
+
+// Removes the assembler-statement of the counting interrupt-service-routine
+#define __asm__
+#define __volatile__( ... )
+
+#include "../PulseCounter.cpp"
+
+
+
+extern "C" void INT0_vect();
+extern "C" void TIMER1_COMPA_vect();
+
+// The gate-time of 100 milliseconds has 25000 ticks with prescaler 64
+static const uint16_t kGateTicks = 25000;
+static const uint32_t kTimerTicksPerSecond = F_CPU / 64;
+
+static uint32_t randomState = 1;
+
+
+static uint32_t nextRandom()
+{
+    // xorshift32, so the test is the same on every host
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+
+// A pulse on INT0
+static void pulse()
+{
+#if PULSE_COUNTER_RECIPROCAL
+    INT0_vect();
+#else
+    uint16_t raw = ( GPIOR1 | ( GPIOR2 << 8 ) ) + 1;
+    GPIOR1 = static_cast<uint8_t>( raw );
+    GPIOR2 = static_cast<uint8_t>( raw >> 8 );
+#endif
+}
+
+
+static void gateEnd()
+{
+    TCNT1 = 0;
+    TIMER1_COMPA_vect();
+}
+
+
+// Advances the gate-timer, with the interrupt-service-routine at the end of each gate-time
+static void advance( uint32_t ticks )
+{
+    while ( ticks != 0 )
+    {
+        uint32_t room = kGateTicks - TCNT1;
+        if ( ticks < room )
+        {
+            TCNT1 += ticks;
+            return;
+        }
+        ticks -= room;
+        gateEnd();
+    }
+}
+
+
+static void start()
+{
+    pulseCounterInit( EXTINT_RISING_EDGE );
+    TIFR1 = 0;
+}
+
+
+
+// Initialization and stop
+static unsigned long testInitAndStop()
+{
+    unsigned long failures = 0;
+
+    failures += ( pulseCounterInit( EXTINT_LOW_LEVEL_ACTIVE ) != -1 );
+    failures += ( pulseCounterInit( EXTINT_FALLING_EDGE ) != 0 );
+    failures += ( OCR1A != kGateTicks - 1 || TCCR1B != ( _BV(WGM12) | _BV(CS11) | _BV(CS10) ) );
+    failures += ( ( TIMSK1 & _BV(OCIE1A) ) == 0 || EICRA != 0x02 || ( EIMSK & 0x01 ) == 0 );
+    failures += ( pulseCounterGetTotal() != 0 );
+
+    pulseCounterStop();
+    failures += ( ( TCCR1B & 0x07 ) != 0 || ( TIMSK1 & _BV(OCIE1A) ) != 0 || ( EIMSK & 0x01 ) != 0 );
+
+    return failures;
+}
+
+
+
+// Random numbers of pulses per gate-time (the 16-bit-counter wraps around), the total, and clearing the total in
+// the middle of a gate-time
+static unsigned long testGateCounts()
+{
+    unsigned long failures = 0;
+    uint16_t count = 1;
+    uint32_t total = 0;
+
+    start();
+    failures += ( pulseCounterGetGateCount( &count ) != 0 || count != 0 );
+
+    for ( int gate = 0; gate < 300; gate++ )
+    {
+        uint16_t pulses = ( gate % 3 == 0 ) ? nextRandom() % 0x10000 : nextRandom() % 100;
+        uint16_t beforeClear = ( gate % 7 == 0 ) ? pulses / 2 : 0;
+
+        for ( uint16_t i = 0; i < pulses; i++ )
+        {
+            pulse();
+            if ( i + 1 == beforeClear )
+            {
+                pulseCounterClearTotal();
+                total = 0;
+                failures += ( pulseCounterGetTotal() != 0 );
+            }
+        }
+        total += pulses - beforeClear;
+        failures += ( pulseCounterGetTotal() != total );
+
+        // Not ready before the end of the gate-time. Then the count of the whole gate-time, also if the total was
+        // cleared in it.
+        failures += ( pulseCounterGetGateCount( &count ) != 0 );
+        advance( kGateTicks - TCNT1 );
+        failures += ( pulseCounterGetGateCount( &count ) != 1 || count != pulses );
+        failures += ( pulseCounterGetGateCount( &count ) != 0 || count != pulses );
+        failures += ( pulseCounterGetTotal() != total );
+
+#if ! PULSE_COUNTER_RECIPROCAL
+        // The count of the last gate-time, divided by 100 milliseconds
+        failures += ( pulseCounterGetFrequencyMilliHz() != pulses * 10000UL );
+#endif
+    }
+
+    return failures;
+}
+
+
+
+#if PULSE_COUNTER_RECIPROCAL
+
+// Pulses with constant periods, spread over several gate-times
+static unsigned long testReciprocal()
+{
+    unsigned long failures = 0;
+
+    start();
+    failures += ( pulseCounterGetFrequencyMilliHz() != 0 );
+
+    for ( int run = 0; run < 2000; run++ )
+    {
+        uint32_t period = 20 + nextRandom() % 300000;
+        uint32_t pulses = 1 + nextRandom() % 4;
+
+        // The first pulses after a timeout only give the time-base
+        advance( kTimerTicksPerSecond * PULSE_COUNTER_TIMEOUT_MS / 1000 );
+        failures += ( pulseCounterGetFrequencyMilliHz() != 0 );
+        for ( uint32_t i = 0; i < pulses; i++ )
+        {
+            advance( period );
+            pulse();
+        }
+        failures += ( pulseCounterGetFrequencyMilliHz() != 0 );
+
+        for ( uint32_t i = 0; i < pulses; i++ )
+        {
+            advance( period );
+            pulse();
+        }
+        advance( period / 2 );
+        uint32_t exact = static_cast<uint32_t>( ( kTimerTicksPerSecond * 1000ULL + period / 2 ) / period );
+        failures += ( pulseCounterGetFrequencyMilliHz() != exact );
+    }
+
+    // Without pulses the frequency decreases to one pulse in the time since the last pulse
+    advance( kTimerTicksPerSecond * PULSE_COUNTER_TIMEOUT_MS / 1000 );
+    failures += ( pulseCounterGetFrequencyMilliHz() != 0 );
+    advance( 1000 );
+    pulse();
+    advance( 1000 );
+    pulse();
+    failures += ( pulseCounterGetFrequencyMilliHz() != 0 );
+    advance( 250 );
+    pulse();
+    failures += ( pulseCounterGetFrequencyMilliHz() != 1000000UL );
+    advance( 199999 );
+    failures += ( pulseCounterGetFrequencyMilliHz() != kTimerTicksPerSecond * 1000ULL / 200000 );
+    advance( kTimerTicksPerSecond * PULSE_COUNTER_TIMEOUT_MS / 1000 );
+    failures += ( pulseCounterGetFrequencyMilliHz() != 0 );
+
+    // A pulse, while the compare-match-interrupt of the end of the gate-time is pending
+    advance( 100 );
+    pulse();
+    failures += ( pulseCounterGetFrequencyMilliHz() != 0 );
+    uint32_t ticks = kGateTicks - TCNT1 + 3;
+    TCNT1 = 3;
+    TIFR1 = _BV(OCF1A);
+    pulse();
+    TIFR1 = 0;
+    TIMER1_COMPA_vect();
+    uint32_t milliHz = ( kTimerTicksPerSecond * 1000ULL + ticks / 2 ) / ticks;
+    failures += ( pulseCounterGetFrequencyMilliHz() != milliHz );
+
+    // After clearing the total, the next pulse only gives the time-base: the last frequency is kept until then
+    advance( 100 );
+    pulseCounterClearTotal();
+    pulse();
+    failures += ( pulseCounterGetFrequencyMilliHz() != milliHz );
+    advance( 500 );
+    pulse();
+    failures += ( pulseCounterGetFrequencyMilliHz() != 500000UL );
+
+    return failures;
+}
+
+#endif
+
+
+
+int main()
+{
+    unsigned long failuresInit = testInitAndStop();
+    unsigned long failuresGates = testGateCounts();
+
+#if PULSE_COUNTER_RECIPROCAL
+    unsigned long failuresReciprocal = testReciprocal();
+#else
+    unsigned long failuresReciprocal = 0;
+#endif
+
+    printf( "init and stop: %lu failures\ngate counts: %lu failures\nreciprocal: %lu failures\n",
+            failuresInit, failuresGates, failuresReciprocal );
+
+    return ( failuresInit || failuresGates || failuresReciprocal ) ? 1 : 0;
+}
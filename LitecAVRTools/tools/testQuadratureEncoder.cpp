@@ -0,0 +1,278 @@
+/*
+    testQuadratureEncoder.cpp - Host-test of the QuadratureEncoder-module:
+    checks the transition-table, the recovery from missed edges and the
+    velocity.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -DQUADRATURE_ENCODER_VELOCITY_TIMER=1 -Ihoststub
+//         -o testQuadratureEncoder testQuadratureEncoder.cpp ../QuadratureEncoder.cpp ../ExternalInterrupts.cpp
+//         ../Timer16Bit.cpp hoststub/registers.cpp && ./testQuadratureEncoder
+//
+// The signals A and B are on INT0 (PD2) and INT1 (PD3). The test sets PIND and calls the interrupt-service-routine,
+// the velocity-timer is TCNT1, which the test advances between the edges. The exit-code is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "../QuadratureEncoder.h"
+
+
+
+extern "C" void INT0_vect();
+
+// The states of the signals in forward direction (A leads B): A in bit 1, B in bit 0
+static const uint8_t kForward[ 4 ] = { 0x00, 0x02, 0x03, 0x01 };
+
+static const uint32_t kTicksPerSecond = F_CPU / QUADRATURE_ENCODER_VELOCITY_PRESCALER;
+
+static uint8_t phase;
+
+static uint32_t randomState = 1;
+
+
+static uint32_t nextRandom()
+{
+    // xorshift32, so the test is the same on every host
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+
+static void setSignals( uint8_t ab )
+{
+    PIND = ( PIND & ~0x0C ) | ( ( ab & 0x02 ) ? 0x04 : 0 ) | ( ( ab & 0x01 ) ? 0x08 : 0 );
+}
+
+
+// Moves the encoder by one count, and calls the interrupt-service-routine, if edgeSeen isn't 0
+static void step( int8_t direction, uint8_t edgeSeen = 1 )
+{
+    phase = ( phase + direction ) & 0x03;
+    setSignals( kForward[ phase ] );
+    if ( edgeSeen )
+    {
+        INT0_vect();
+    }
+}
+
+
+static void start()
+{
+    phase = 0;
+    PIND = 0xF3;
+    quadratureEncoderInit();
+}
+
+
+
+// Every transition of the table, after a valid step forward and backward
+static unsigned long testTransitions()
+{
+    unsigned long failures = 0;
+
+    for ( uint8_t oldPhase = 0; oldPhase < 4; oldPhase++ )
+    {
+        for ( int8_t lastDirection = -1; lastDirection <= 1; lastDirection += 2 )
+        {
+            for ( uint8_t distance = 0; distance < 4; distance++ )
+            {
+                start();
+                failures += ( EIMSK != 0x03 || EICRA != 0x05 );
+
+                // A valid step into oldPhase sets the direction
+                phase = ( oldPhase - lastDirection ) & 0x03;
+                setSignals( kForward[ phase ] );
+                quadratureEncoderInit();
+                step( lastDirection );
+                failures += ( quadratureEncoderGetPosition() != lastDirection );
+
+                // 0: no change, 1: forward, 3: backward, 2: both signals changed
+                step( distance, 1 );
+                static const int8_t kDelta[ 4 ] = { 0, 1, 2, -1 };
+                int8_t expected = kDelta[ distance ];
+                if ( distance == 2 )
+                {
+                    expected = 2 * lastDirection;
+                }
+                failures += ( quadratureEncoderGetPosition() != lastDirection + expected );
+                failures += ( quadratureEncoderGetErrors() != ( distance == 2 ? 1 : 0 ) );
+
+                // The second external Interrupt of the same edge finds no change
+                INT0_vect();
+                failures += ( quadratureEncoderGetPosition() != lastDirection + expected );
+            }
+        }
+    }
+
+    // Both signals changed directly after quadratureEncoderInit(): no direction known, only an error
+    start();
+    step( 2 );
+    failures += ( quadratureEncoderGetPosition() != 0 || quadratureEncoderGetErrors() != 1 );
+
+    return failures;
+}
+
+
+
+// Random movements, with missed edges in the direction of the movement
+static unsigned long testRandomWalk()
+{
+    unsigned long failures = 0;
+    int32_t position = 0;
+    unsigned long errors = 0;
+    int8_t direction = 1;
+
+    start();
+    quadratureEncoderSetPosition( 0x7FFFFF00L );
+    position = 0x7FFFFF00L;
+    step( direction );
+    position += direction;
+
+    for ( long i = 0; i < 1000000L; i++ )
+    {
+        uint32_t r = nextRandom();
+        uint8_t missed = 0;
+        if ( r % 64 == 0 )
+        {
+            direction = -direction;
+        }
+        else if ( r % 97 == 1 )
+        {
+            // One edge is missed, the next one shows both signals changed
+            step( direction, 0 );
+            errors++;
+            missed = 1;
+        }
+        step( direction );
+        position += missed ? 2 * direction : direction;
+
+        failures += ( quadratureEncoderGetPosition() != position );
+        failures += ( quadratureEncoderGetErrors() != ( errors > 255 ? 255 : errors ) );
+        if ( r % 5000 == 3 )
+        {
+            quadratureEncoderClearErrors();
+            errors = 0;
+        }
+    }
+
+    // A missed edge against the last direction gives a wrong position, but it is counted as error
+    quadratureEncoderClearErrors();
+    position = quadratureEncoderGetPosition();
+    step( 1 );
+    step( -1, 0 );
+    step( -1 );
+    failures += ( quadratureEncoderGetPosition() != position + 1 + 2 || quadratureEncoderGetErrors() != 1 );
+
+    quadratureEncoderStop();
+    failures += ( EIMSK != 0 );
+
+    return failures;
+}
+
+
+
+// The velocity from the timestamps of the edges, its decrease without edges, and a restart
+static unsigned long testVelocity()
+{
+    unsigned long failures = 0;
+
+    start();
+    failures += ( ( TCCR1B & 0x07 ) != 0x03 );
+    TCNT1 = 0;
+    quadratureEncoderSetPosition( 0 );
+    failures += ( quadratureEncoderGetVelocity() != 0 );
+
+    // The first edges after quadratureEncoderSetPosition() only give the time-base
+    for ( int i = 0; i < 100; i++ )
+    {
+        TCNT1 += 25;
+        step( 1 );
+    }
+    failures += ( quadratureEncoderGetVelocity() != 0 );
+
+    // An edge every 25 ticks, and every 50 ticks backwards, the calls of the function in between
+    for ( int i = 0; i < 100; i++ )
+    {
+        TCNT1 += 25;
+        step( 1 );
+    }
+    TCNT1 += 7;
+    failures += ( quadratureEncoderGetVelocity() != static_cast<int32_t>( kTicksPerSecond / 25 ) );
+    for ( int i = 0; i < 50; i++ )
+    {
+        TCNT1 += ( i == 0 ) ? 50 - 7 : 50;
+        step( -1 );
+    }
+    failures += ( quadratureEncoderGetVelocity() != -static_cast<int32_t>( kTicksPerSecond / 50 ) );
+
+    // Without an edge the velocity decreases to at most one count in the time since the last edge
+    TCNT1 += 1000;
+    failures += ( quadratureEncoderGetVelocity() != -static_cast<int32_t>( kTicksPerSecond / 1001 ) );
+    TCNT1 += 40000;
+    failures += ( quadratureEncoderGetVelocity() != 0 );
+
+    // Longer than the range of the timer
+    for ( int i = 0; i < 4; i++ )
+    {
+        TCNT1 += 40000;
+        failures += ( quadratureEncoderGetVelocity() != 0 );
+    }
+
+    // The first edges after the stop give a low velocity, the next one is exact again
+    TCNT1 += 100;
+    step( 1 );
+    TCNT1 += 100;
+    step( 1 );
+    int32_t v = quadratureEncoderGetVelocity();
+    failures += ( v <= 0 || v > 100 );
+    TCNT1 += 100;
+    step( 1 );
+    failures += ( quadratureEncoderGetVelocity() != static_cast<int32_t>( kTicksPerSecond / 100 ) );
+
+    // The counts of a missed edge are included
+    TCNT1 += 100;
+    step( 1, 0 );
+    step( 1 );
+    failures += ( quadratureEncoderGetVelocity() != static_cast<int32_t>( 2 * kTicksPerSecond / 100 ) );
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresTransitions = testTransitions();
+    unsigned long failuresRandom = testRandomWalk();
+    unsigned long failuresVelocity = testVelocity();
+
+    printf( "transitions: %lu failures\nrandom walk: %lu failures\nvelocity: %lu failures\n",
+            failuresTransitions, failuresRandom, failuresVelocity );
+
+    return ( failuresTransitions || failuresRandom || failuresVelocity ) ? 1 : 0;
+}
@@ -0,0 +1,320 @@
+/*
+    testSoftPwm.cpp - Host-test of the SoftPwm-module: checks the pulses of
+    random schedules and the change of the schedule at the period start.
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -DHOST_TCNT1_HOOK=simulatedTcnt1 -Ihoststub
+//         -o testSoftPwm testSoftPwm.cpp ../SoftPwm.cpp ../Timer16Bit.cpp hoststub/registers.cpp && ./testSoftPwm
+//
+// Every access to TCNT1 takes one timer-tick, so the busy-waiting of the interrupt-service-routine ends. Writing
+// to PINx toggles the pins in PORTx on the AVR: the simulation does this at the next access to TCNT1, and records
+// the time of each falling edge. The exit-code is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "../GpioPinMacros.h"
+#include "../SoftPwm.h"
+
+
+
+extern "C" void TIMER1_COMPA_vect();
+
+static const uint16_t kMaxPulseTicks = SOFT_PWM_PERIOD_TICKS - 2 * ( 100 / SOFT_PWM_PRESCALER + 1 );
+
+// The latest allowed falling edge after the programmed pulse-width: the edges of all channels may be handled in
+// one call of the interrupt-service-routine, each one takes a few ticks in the simulation.
+static const uint16_t kMaxDelayTicks = 40;
+
+// Port B, C and D, the attached pins of each port and the pin of each channel
+static volatile uint8_t* const ddrs[ 3 ] = { &DDRB, &DDRC, &DDRD };
+static volatile uint8_t* const ports[ 3 ] = { &PORTB, &PORTC, &PORTD };
+static volatile uint8_t* const pins[ 3 ] = { &PINB, &PINC, &PIND };
+static const uint8_t attached[ 3 ] = { 0x3F, 0x1F, 0x7C };
+static uint8_t channelPort[ SOFT_PWM_CHANNELS ];
+static uint8_t channelBit[ SOFT_PWM_CHANNELS ];
+
+// Time of the first falling edge of each pin in the actual period, 0 if there was none
+static uint16_t fallTime[ 3 ][ 8 ];
+
+static uint32_t randomState = 1;
+
+
+static uint32_t nextRandom()
+{
+    // xorshift32, so the test is the same on every host
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+
+static void applyPinWrites()
+{
+    for ( uint8_t p = 0; p < 3; p++ )
+    {
+        uint8_t toggle = *pins[ p ];
+        for ( uint8_t b = 0; b < 8; b++ )
+        {
+            if ( ( toggle & ( *ports[ p ] ) & _BV(b) ) && fallTime[ p ][ b ] == 0 )
+            {
+                fallTime[ p ][ b ] = hostTCNT1;
+            }
+        }
+        *ports[ p ] ^= toggle;
+        *pins[ p ] = 0;
+    }
+}
+
+
+volatile uint16_t& simulatedTcnt1()
+{
+    applyPinWrites();
+    hostTCNT1++;
+    return hostTCNT1;
+}
+
+
+// Calls the interrupt-service-routine at the compare-match-times of one period. Returns the number of errors.
+static unsigned long runPeriod()
+{
+    unsigned long failures = 0;
+
+    for ( uint8_t p = 0; p < 3; p++ )
+    {
+        for ( uint8_t b = 0; b < 8; b++ )
+        {
+            fallTime[ p ][ b ] = 0;
+        }
+    }
+
+    hostTCNT1 = 0;
+    TIMER1_COMPA_vect();
+    applyPinWrites();
+
+    while ( OCR1A != 0 )
+    {
+        // The compare-match must be later than the actual time
+        if ( OCR1A <= hostTCNT1 )
+        {
+            return failures + 1;
+        }
+        hostTCNT1 = OCR1A;
+        TIMER1_COMPA_vect();
+        applyPinWrites();
+    }
+    return failures;
+}
+
+
+// Checks one period: every channel must rise at the beginning and fall after its pulse-width
+static unsigned long checkPeriod( const uint16_t* ticks )
+{
+    unsigned long failures = runPeriod();
+
+    for ( uint8_t c = 0; c < SOFT_PWM_CHANNELS; c++ )
+    {
+        uint8_t p = channelPort[ c ];
+        uint8_t b = channelBit[ c ];
+        uint16_t fall = fallTime[ p ][ b ];
+        uint16_t t = ticks[ c ];
+
+        if ( t == 0 )
+        {
+            failures += ( fall != 0 || ( *ports[ p ] & _BV(b) ) );
+        }
+        else if ( t >= kMaxPulseTicks )
+        {
+            failures += ( fall != 0 || ! ( *ports[ p ] & _BV(b) ) );
+        }
+        else
+        {
+            failures += ( fall < t || fall > t + kMaxDelayTicks || ( *ports[ p ] & _BV(b) ) );
+        }
+    }
+    return failures;
+}
+
+
+static void attachAll()
+{
+    softPwmInit();
+    PORTB = 0x80;
+    PORTC = 0x00;
+    PORTD = 0x83;
+
+    uint8_t c = 0;
+    for ( uint8_t p = 0; p < 3; p++ )
+    {
+        for ( uint8_t b = 0; b < 8; b++ )
+        {
+            if ( attached[ p ] & _BV(b) )
+            {
+                channelPort[ c ] = p;
+                channelBit[ c ] = b;
+                softPwmAttachPin( c, ddrs[ p ], ports[ p ], pins[ p ], b );
+                c++;
+            }
+        }
+    }
+}
+
+
+
+// Attaching pins and the registers of the timer
+static unsigned long testAttach()
+{
+    unsigned long failures = 0;
+
+    attachAll();
+    failures += ( ICR1 != SOFT_PWM_PERIOD_TICKS - 1 );
+    failures += ( TCCR1B != ( _BV(WGM13) | _BV(WGM12) | _BV(CS11) ) );
+    failures += ( DDRB != 0x3F || DDRC != 0x1F || DDRD != 0x7C );
+
+    // Channel already used, channel too large, and a fourth port
+    failures += ( softPwmAttach( 0, GpioPin( B, 7 ) ) != -1 );
+    failures += ( softPwmAttach( SOFT_PWM_CHANNELS, GpioPin( B, 7 ) ) != -1 );
+
+    softPwmInit();
+    failures += ( softPwmAttach( 0, GpioPin( B, 1 ) ) != 0 );
+    failures += ( softPwmAttach( 1, GpioPin( C, 1 ) ) != 0 );
+    failures += ( softPwmAttach( 2, GpioPin( D, 1 ) ) != 0 );
+    failures += ( softPwmAttach( 3, GpioPin( D, 2 ) ) != 0 );
+    failures += ( softPwmAttach( 4, GpioPin( B, 2 ) ) != 0 );
+
+    return failures;
+}
+
+
+
+// Random pulse-widths, with equal and close values, 0 and "always high"
+static unsigned long testRandomSchedules()
+{
+    unsigned long failures = 0;
+    uint16_t ticks[ SOFT_PWM_CHANNELS ];
+
+    attachAll();
+    for ( int run = 0; run < 20000; run++ )
+    {
+        for ( uint8_t c = 0; c < SOFT_PWM_CHANNELS; c++ )
+        {
+            switch ( nextRandom() % 6 )
+            {
+            case 0:     ticks[ c ] = 0;                                                     break;
+            case 1:     ticks[ c ] = kMaxPulseTicks + nextRandom() % 100;                   break;
+            case 2:     ticks[ c ] = ( c > 0 ) ? ticks[ c - 1 ] : 2000;                     break;
+            case 3:     ticks[ c ] = ( c > 0 && ticks[ c - 1 ] < 30000 ) ? ticks[ c - 1 ] + nextRandom() % 20 + 1
+                                                                         : 3000;            break;
+            default:    ticks[ c ] = 1 + nextRandom() % ( kMaxPulseTicks - 1 );             break;
+            }
+            if ( ticks[ c ] > SOFT_PWM_PERIOD_TICKS )
+            {
+                ticks[ c ] = SOFT_PWM_PERIOD_TICKS;
+            }
+            softPwmSetTicks( c, ticks[ c ] );
+        }
+        softPwmUpdate();
+
+        // The new schedule starts with the next period, and is kept
+        failures += checkPeriod( ticks );
+        failures += ( softPwmUpdatePending() != 0 );
+        failures += checkPeriod( ticks );
+
+        // The pins, that are not attached, keep their level
+        failures += ( ( PORTB & 0xC0 ) != 0x80 || ( PORTC & 0xE0 ) != 0 || ( PORTD & 0x83 ) != 0x83 );
+    }
+    return failures;
+}
+
+
+
+// A schedule built in the middle of a period is only taken over at the beginning of the next period
+static unsigned long testUpdateInPeriod()
+{
+    unsigned long failures = 0;
+    uint16_t oldTicks[ SOFT_PWM_CHANNELS ] = { 0 };
+    uint16_t newTicks[ SOFT_PWM_CHANNELS ] = { 0 };
+
+    attachAll();
+    oldTicks[ 0 ] = 2000;
+    oldTicks[ 1 ] = 3000;
+    newTicks[ 0 ] = 5000;
+    newTicks[ 2 ] = 1000;
+
+    softPwmSetTicks( 0, oldTicks[ 0 ] );
+    softPwmSetTicks( 1, oldTicks[ 1 ] );
+    softPwmUpdate();
+    failures += checkPeriod( oldTicks );
+
+    // Beginning of a period with the old schedule
+    hostTCNT1 = 0;
+    TIMER1_COMPA_vect();
+    applyPinWrites();
+
+    softPwmSetTicks( 0, newTicks[ 0 ] );
+    softPwmSetTicks( 1, newTicks[ 1 ] );
+    softPwmSetTicks( 2, newTicks[ 2 ] );
+    softPwmUpdate();
+    failures += ( softPwmUpdatePending() == 0 );
+
+    // The rest of the period still uses the old schedule
+    while ( OCR1A != 0 )
+    {
+        hostTCNT1 = OCR1A;
+        TIMER1_COMPA_vect();
+        applyPinWrites();
+    }
+    failures += ( ( PORTB & 0x07 ) != 0 );
+    failures += ( hostTCNT1 < oldTicks[ 1 ] || hostTCNT1 > oldTicks[ 1 ] + kMaxDelayTicks );
+
+    failures += checkPeriod( newTicks );
+    failures += ( softPwmUpdatePending() != 0 );
+
+    // softPwmStop() sets all attached pins low
+    softPwmSetTicks( 0, SOFT_PWM_PERIOD_TICKS );
+    softPwmUpdate();
+    runPeriod();
+    failures += ( ( PORTB & 0x01 ) == 0 );
+    softPwmStop();
+    failures += ( ( PORTB & 0x3F ) != 0 || ( PORTB & 0x80 ) == 0 );
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresAttach = testAttach();
+    unsigned long failuresRandom = testRandomSchedules();
+    unsigned long failuresUpdate = testUpdateInPeriod();
+
+    printf( "attach: %lu failures\nrandom schedules: %lu failures\nupdate in period: %lu failures\n",
+            failuresAttach, failuresRandom, failuresUpdate );
+
+    return ( failuresAttach || failuresRandom || failuresUpdate ) ? 1 : 0;
+}
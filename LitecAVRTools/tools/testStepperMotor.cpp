@@ -0,0 +1,225 @@
+/*
+    testStepperMotor.cpp - Host-test of the StepperMotor-module: checks the
+    speed-profile of moves (AVR446) and the deceleration after stepperStop().
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -Ihoststub -o testStepperMotor testStepperMotor.cpp
+//         ../StepperMotor.cpp ../Timer16Bit.cpp hoststub/registers.cpp && ./testStepperMotor
+//
+// The interrupt-service-routine is called at each compare-match, the intervals written to OCR1A are added up to
+// the time of the move. The duration and the highest speed of each move are compared with the ideal trapezoid or
+// triangle. The exit-code is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include <avr/io.h>
+
+#include "../GpioPinMacros.h"
+#include "../StepperMotor.h"
+
+
+
+extern "C" void TIMER1_COMPA_vect();
+
+static const double kTimerFrequency = STEPPER_TIMER_FREQUENCY;
+
+struct MoveResult
+{
+    uint32_t steps;         // Number of calls of the interrupt-service-routine
+    double seconds;         // Duration from the start to the last step
+    double maxSpeed;        // Highest speed in steps per second
+    unsigned long errors;   // Steps without a STEP-pulse, intervals out of range or a move that didn't end
+};
+
+
+// Runs a move to its end. If stopAfter isn't 0, stepperStop() is called after this number of steps.
+static MoveResult runMove( int32_t steps, uint16_t speed, uint16_t accel, uint16_t decel, uint32_t stopAfter = 0 )
+{
+    MoveResult result = { 0, 0.0, 0.0, 0 };
+    uint16_t minInterval = static_cast<uint16_t>( kTimerFrequency / speed ) - 1;
+
+    if ( stepperMove( steps, speed, accel, decel ) != 0 )
+    {
+        result.errors++;
+        return result;
+    }
+    uint16_t interval = OCR1A;
+    while ( stepperIsRunning() )
+    {
+        result.seconds += interval / kTimerFrequency;
+        PIND = 0;
+        TIMER1_COMPA_vect();
+        result.steps++;
+
+        // The STEP-pin is toggled twice (the stub keeps the value of the last write to PIND)
+        result.errors += ( PIND != _BV(2) );
+        if ( result.steps == stopAfter )
+        {
+            stepperStop();
+        }
+        interval = OCR1A;
+        if ( stepperIsRunning() )
+        {
+            result.errors += ( interval < minInterval );
+            double s = kTimerFrequency / interval;
+            if ( s > result.maxSpeed )
+            {
+                result.maxSpeed = s;
+            }
+        }
+        if ( result.steps > 10000000UL )
+        {
+            result.errors++;
+            break;
+        }
+    }
+    result.errors += ( ( TCCR1B & 0x07 ) != 0 || ( TIMSK1 & _BV(OCIE1A) ) != 0 );
+    return result;
+}
+
+
+static unsigned long outside( double value, double expected, double tolerance )
+{
+    return fabs( value - expected ) > tolerance;
+}
+
+
+
+// Initialization, parameters out of range and short moves
+static unsigned long testInitAndParameters()
+{
+    unsigned long failures = 0;
+
+    DDRD = 0;
+    PORTD = 0xFF;
+    stepperInit( GpioPin( D, 2 ), GpioPin( D, 3 ) );
+    failures += ( DDRD != 0x0C || PORTD != 0xF3 );
+    failures += ( ( TCCR1B & 0x07 ) != 0 );
+
+    failures += ( stepperMove( 1, STEPPER_MAX_SPEED + 1, 1, 1 ) != -1 );
+    failures += ( stepperMove( 1, 0, 1, 1 ) != -1 );
+    failures += ( stepperMove( 1, 100, 0, 1 ) != -1 );
+    failures += ( stepperMove( 1, 100, 1, 0 ) != -1 );
+    failures += ( stepperMove( 0, 100, 1, 1 ) != 0 || stepperIsRunning() );
+
+    // A second move is refused, while the motor is running
+    failures += ( stepperMove( 10, 100, 100, 100 ) != 0 );
+    failures += ( stepperMove( 10, 100, 100, 100 ) != -1 );
+    stepperHalt();
+    failures += ( stepperIsRunning() != 0 );
+
+    stepperSetPosition( 0 );
+    MoveResult r = runMove( 1, 100, 100, 100 );
+    failures += r.errors + ( r.steps != 1 || stepperGetPosition() != 1 );
+    r = runMove( -3, 40000, 65535, 65535 );
+    failures += r.errors + ( r.steps != 3 || stepperGetPosition() != -2 );
+
+    return failures;
+}
+
+
+
+// Duration and highest speed of trapezoids and triangles
+static unsigned long testProfiles()
+{
+    unsigned long failures = 0;
+
+    stepperInit( GpioPin( D, 2 ), GpioPin( D, 3 ) );
+
+    // Trapezoid: 100000 / 30000 + 30000 / 20000 = 4.833 s
+    MoveResult r = runMove( 100000, 30000, 20000, 20000 );
+    failures += r.errors + ( r.steps != 100000 || stepperGetPosition() != 100000 || ! ( PORTD & _BV(3) ) );
+    failures += outside( r.maxSpeed, 30000, 350 ) + outside( r.seconds, 4.8333, 0.05 );
+
+    // Triangle: the peak is sqrt( accel * steps ) = 14142, the duration 2 * sqrt( steps / accel ) = 1.414 s
+    r = runMove( -10000, 30000, 20000, 20000 );
+    failures += r.errors + ( r.steps != 10000 || stepperGetPosition() != 90000 || ( PORTD & _BV(3) ) );
+    failures += outside( r.maxSpeed, 14142, 300 ) + outside( r.seconds, 1.4142, 0.03 );
+
+    // Asymmetric trapezoid: 20000 / 5000 + 5000 / ( 2 * 1000 ) + 5000 / ( 2 * 4000 ) = 7.125 s
+    r = runMove( 20000, 5000, 1000, 4000 );
+    failures += r.errors + ( stepperGetPosition() != 110000 );
+    failures += outside( r.maxSpeed, 5000, 60 ) + outside( r.seconds, 7.125, 0.1 );
+
+    // Asymmetric triangle: 3/4 of the steps accelerate, peak sqrt( 2 * 1000 * 15000 ) = 5477
+    r = runMove( 20000, 10000, 1000, 3000 );
+    failures += r.errors + ( stepperGetPosition() != 130000 );
+    failures += outside( r.maxSpeed, 5477, 80 );
+
+    // Low acceleration: the first interval doesn't fit into 16 bits. Triangle with the peak 447 and 8.94 s.
+    r = runMove( 2000, 1000, 100, 100 );
+    failures += r.errors + ( stepperGetPosition() != 132000 );
+    failures += outside( r.maxSpeed, 447, 20 ) + outside( r.seconds, 8.944, 0.7 );
+
+    return failures;
+}
+
+
+
+// stepperStop() while running at full speed, during the acceleration and during the deceleration
+static unsigned long testStop()
+{
+    unsigned long failures = 0;
+
+    stepperInit( GpioPin( D, 2 ), GpioPin( D, 3 ) );
+
+    // At full speed: 20000^2 / ( 2 * 10000 ) = 20000 steps to stop
+    MoveResult r = runMove( 100000, 20000, 10000, 10000, 30000 );
+    failures += r.errors + ( r.steps != 50000 || stepperGetPosition() != 50000 );
+
+    // During the acceleration: as many steps to stop as accelerated, with equal acceleration and deceleration
+    r = runMove( -100000, 20000, 10000, 10000, 5000 );
+    failures += r.errors + ( r.steps < 9990 || r.steps > 10010 );
+
+    // With a deceleration 4 times the acceleration: a quarter of the steps
+    stepperSetPosition( 0 );
+    r = runMove( 100000, 20000, 10000, 40000, 8000 );
+    failures += r.errors + ( r.steps < 9990 || r.steps > 10010 );
+
+    // During the deceleration, nothing changes
+    r = runMove( 30000, 20000, 10000, 10000, 25000 );
+    failures += r.errors + ( r.steps != 30000 );
+
+    // After the end of a move
+    stepperStop();
+    failures += ( stepperIsRunning() != 0 );
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresInit = testInitAndParameters();
+    unsigned long failuresProfiles = testProfiles();
+    unsigned long failuresStop = testStop();
+
+    printf( "init and parameters: %lu failures\nprofiles: %lu failures\nstop: %lu failures\n",
+            failuresInit, failuresProfiles, failuresStop );
+
+    return ( failuresInit || failuresProfiles || failuresStop ) ? 1 : 0;
+}
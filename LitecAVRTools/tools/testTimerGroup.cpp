@@ -0,0 +1,130 @@
+/*
+    testTimerGroup.cpp - Host-test of the TimerGroup-module: checks adding
+    Timer/Counters and the registers after start() and stop().
+
+    This is part of the LitecAVRTools library.
+
+    Copyright (c) 2018 Wolfgang Zukrigl
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Runs on the PC, not on the microcontroller. Build and run it in this directory with (one command-line):
+//
+//     g++ -std=gnu++11 -O2 -Wall -Wextra -DF_CPU=16000000U -Ihoststub -o testTimerGroup testTimerGroup.cpp
+//         ../TimerGroup.cpp ../Timer16Bit.cpp hoststub/registers.cpp && ./testTimerGroup
+//
+// The ATmega328P has one 16-bit-Timer/Counter, so the second member of the groups is a Timer/Counter object on
+// plain variables. The exit-code is 0, if all checks passed.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#include "../TimerGroup.h"
+
+
+
+// The registers of the second Timer/Counter
+static volatile uint8_t tccr3a, tccr3b, tccr3c, timsk3, tifr3;
+static volatile uint16_t tcnt3, ocr3a, ocr3b, ocr3c, icr3;
+
+
+
+// add() and setCountValue() with valid and invalid parameters
+static unsigned long testAdd()
+{
+    unsigned long failures = 0;
+    TimerCounter16Bit timer1 = makeTimerCounter16BitObject( 1 );
+    TimerGroup group;
+
+    failures += ( group.getCount() != 0 );
+    failures += ( group.add( timer1, T16_RISING, 0 ) != -1 );
+    failures += ( group.add( timer1, T16_FALLING, 0 ) != -1 );
+    failures += ( group.add( timer1, T16_CLK_OFF, 0 ) != -1 );
+    failures += ( group.getCount() != 0 );
+    failures += ( group.setCountValue( 0, 5 ) != -1 );
+
+    for ( uint8_t i = 0; i < TIMER_GROUP_MAX_TIMERS; i++ )
+    {
+        failures += ( group.add( timer1, T16_PRESC_1024, i ) != 0 );
+    }
+    failures += ( group.getCount() != TIMER_GROUP_MAX_TIMERS );
+    failures += ( group.add( timer1, T16_PRESC_1, 0 ) != -1 );
+    failures += ( group.setCountValue( TIMER_GROUP_MAX_TIMERS - 1, 5 ) != 0 );
+    failures += ( group.setCountValue( TIMER_GROUP_MAX_TIMERS, 5 ) != -1 );
+
+    return failures;
+}
+
+
+
+// start() sets the count-values and clock-sources, stop() keeps the count-values
+static unsigned long testStartStop()
+{
+    unsigned long failures = 0;
+    TimerCounter16Bit timer1 = makeTimerCounter16BitObject( 1 );
+    TimerCounter16Bit timer3( &tccr3a, &tccr3b, &tccr3c, &tcnt3, &ocr3a, &ocr3b, &ocr3c, &icr3, &timsk3, &tifr3 );
+    TimerGroup group;
+
+    failures += ( group.add( timer1, T16_PRESC_1, 10 ) != 0 );
+    failures += ( group.add( timer3, T16_PRESC_8, 267 ) != 0 );
+
+    // The mode-bits (WGM13, WGM12) stay unchanged, the interrupts stay enabled
+    TCCR1B = _BV(WGM13) | _BV(WGM12);
+    tccr3b = _BV(WGM12);
+    GTCCR = 0;
+    SREG = 0x80;
+    group.start();
+    failures += ( TCNT1 != 10 || tcnt3 != 267 );
+    failures += ( TCCR1B != ( _BV(WGM13) | _BV(WGM12) | _BV(CS10) ) || tccr3b != ( _BV(WGM12) | _BV(CS11) ) );
+    failures += ( GTCCR != 0 || SREG != 0x80 );
+
+    // The counters have run, stop() doesn't change them
+    TCNT1 = 1000;
+    tcnt3 = 2000;
+    group.stop();
+    failures += ( TCNT1 != 1000 || tcnt3 != 2000 );
+    failures += ( TCCR1B != ( _BV(WGM13) | _BV(WGM12) ) || tccr3b != _BV(WGM12) );
+    failures += ( GTCCR != 0 || SREG != 0x80 );
+
+    // A running group restarts with the new count-values, also with interrupts disabled
+    group.start();
+    failures += ( group.setCountValue( 1, 500 ) != 0 );
+    SREG = 0;
+    group.start();
+    failures += ( TCNT1 != 10 || tcnt3 != 500 );
+    failures += ( ( TCCR1B & 0x07 ) != T16_PRESC_1 || ( tccr3b & 0x07 ) != T16_PRESC_8 );
+    failures += ( GTCCR != 0 || SREG != 0 );
+
+    group.stop();
+    failures += ( ( TCCR1B & 0x07 ) != 0 || ( tccr3b & 0x07 ) != 0 );
+
+    return failures;
+}
+
+
+
+int main()
+{
+    unsigned long failuresAdd = testAdd();
+    unsigned long failuresStartStop = testStartStop();
+
+    printf( "add: %lu failures\nstart and stop: %lu failures\n", failuresAdd, failuresStartStop );
+
+    return ( failuresAdd || failuresStartStop ) ? 1 : 0;
+}